@@ -0,0 +1,1405 @@
+/**
+ * @file Algorithms.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains reductions over (zipped) ranges. reduce and transform_reduce use multiple independent
+ * accumulators to break the loop-carried dependency of a serial accumulation. Sums and dot products over contiguous
+ * floating point columns are computed with explicit SIMD kernels, sums over run-length encoded columns are computed
+ * run by run. inclusive_scan and exclusive_scan are lazy prefix scan views. compact copies selected rows without data
+ * dependent branches and bucketize partitions rows by key.
+ */
+
+#ifndef ITERATORTOOLS_ALGORITHMS_HPP
+#define ITERATORTOOLS_ALGORITHMS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#ifdef __SSE4_1__
+#include <smmintrin.h>
+#endif
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+#include "Iterators.hpp"
+#include "BitColumn.hpp"
+#include "Indexed.hpp"
+
+namespace iterators {
+
+    namespace impl {
+        namespace traits {
+            template<typename T, typename = std::void_t<>>
+            struct is_tuple_like : std::false_type {};
+
+            template<typename T>
+            struct is_tuple_like<T, std::void_t<decltype(std::tuple_size<T>::value)>> : std::true_type {};
+
+            template<typename T>
+            constexpr inline bool is_tuple_like_v = is_tuple_like<T>::value;
+        }
+    }
+
+    /**
+     * @brief Function object that multiplies its arguments. Tuples (e.g. the elements of a zip view) are multiplied
+     * element-wise, so that transform_reduce(zip(a, b), 0.0, std::plus<>{}, product{}) computes a dot product.
+     */
+    struct product {
+        template<typename T, typename ...Ts>
+        constexpr auto operator()(const T &first, const Ts &...rest) const {
+            if constexpr (sizeof...(Ts) == 0 && impl::traits::is_tuple_like_v<T>) {
+                return std::apply([](const auto &...values) { return (values * ...); }, first);
+            } else {
+                return (first * ... * rest);
+            }
+        }
+    };
+
+    /**
+     * @brief Projection that returns the element at position Idx of a tuple, e.g. a column of a zip view row. Can
+     * be used as key function
+     * @tparam Idx element index
+     */
+    template<std::size_t Idx>
+    struct element {
+        template<typename Tuple>
+        constexpr decltype(auto) operator()(Tuple &&tuple) const {
+            return std::get<Idx>(std::forward<Tuple>(tuple));
+        }
+    };
+
+    namespace impl {
+        namespace traits {
+            template<typename T, typename = std::void_t<>>
+            struct has_get_iterators : std::false_type {};
+
+            template<typename T>
+            struct has_get_iterators<T, std::void_t<decltype(std::declval<T>().getIterators())>> : std::true_type {};
+
+            template<typename Op, typename T>
+            constexpr inline bool is_plus_v = std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::plus<T>>;
+
+            template<typename T>
+            constexpr inline bool is_simd_float_v = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+            template<typename T>
+            constexpr inline bool is_simd_integer_v = std::is_same_v<T, std::int32_t> ||
+                                                      std::is_same_v<T, std::int64_t>;
+        }
+
+        /**
+         * @brief Function object that returns its argument unchanged
+         */
+        struct Identity {
+            template<typename T>
+            constexpr T &&operator()(T &&value) const noexcept {
+                return std::forward<T>(value);
+            }
+        };
+
+#if defined(__SSE2__) || defined(_M_X64)
+        template<typename T>
+        struct SimdTraits;
+
+#ifdef __AVX__
+        template<>
+        struct SimdTraits<float> {
+            using Vector = __m256;
+            static constexpr std::size_t Width = 8;
+            static Vector zero() noexcept { return _mm256_setzero_ps(); }
+            static Vector load(const float *data) noexcept { return _mm256_loadu_ps(data); }
+            static Vector add(Vector a, Vector b) noexcept { return _mm256_add_ps(a, b); }
+            static Vector mul(Vector a, Vector b) noexcept { return _mm256_mul_ps(a, b); }
+            static float sum(Vector v) noexcept {
+                alignas(32) float values[Width];
+                _mm256_store_ps(values, v);
+                return ((values[0] + values[4]) + (values[1] + values[5])) +
+                       ((values[2] + values[6]) + (values[3] + values[7]));
+            }
+        };
+
+        template<>
+        struct SimdTraits<double> {
+            using Vector = __m256d;
+            static constexpr std::size_t Width = 4;
+            static Vector zero() noexcept { return _mm256_setzero_pd(); }
+            static Vector load(const double *data) noexcept { return _mm256_loadu_pd(data); }
+            static Vector add(Vector a, Vector b) noexcept { return _mm256_add_pd(a, b); }
+            static Vector mul(Vector a, Vector b) noexcept { return _mm256_mul_pd(a, b); }
+            static double sum(Vector v) noexcept {
+                alignas(32) double values[Width];
+                _mm256_store_pd(values, v);
+                return (values[0] + values[2]) + (values[1] + values[3]);
+            }
+        };
+#else
+        template<>
+        struct SimdTraits<float> {
+            using Vector = __m128;
+            static constexpr std::size_t Width = 4;
+            static Vector zero() noexcept { return _mm_setzero_ps(); }
+            static Vector load(const float *data) noexcept { return _mm_loadu_ps(data); }
+            static Vector add(Vector a, Vector b) noexcept { return _mm_add_ps(a, b); }
+            static Vector mul(Vector a, Vector b) noexcept { return _mm_mul_ps(a, b); }
+            static float sum(Vector v) noexcept {
+                alignas(16) float values[Width];
+                _mm_store_ps(values, v);
+                return (values[0] + values[2]) + (values[1] + values[3]);
+            }
+        };
+
+        template<>
+        struct SimdTraits<double> {
+            using Vector = __m128d;
+            static constexpr std::size_t Width = 2;
+            static Vector zero() noexcept { return _mm_setzero_pd(); }
+            static Vector load(const double *data) noexcept { return _mm_loadu_pd(data); }
+            static Vector add(Vector a, Vector b) noexcept { return _mm_add_pd(a, b); }
+            static Vector mul(Vector a, Vector b) noexcept { return _mm_mul_pd(a, b); }
+            static double sum(Vector v) noexcept {
+                alignas(16) double values[Width];
+                _mm_store_pd(values, v);
+                return values[0] + values[1];
+            }
+        };
+#endif
+
+        /**
+         * @brief Vector operations on 32 or 64 bit integers. Lanes wrap around on overflow and are combined in
+         * unsigned arithmetic, so the result equals the scalar sum whenever that does not overflow
+         * @tparam T std::int32_t or std::int64_t
+         */
+        template<typename T>
+        struct SimdIntegerTraits {
+            using Unsigned = std::make_unsigned_t<T>;
+#ifdef __AVX2__
+            using Vector = __m256i;
+            static constexpr std::size_t Width = sizeof(Vector) / sizeof(T);
+            static Vector zero() noexcept { return _mm256_setzero_si256(); }
+            static Vector load(const T *data) noexcept {
+                return _mm256_loadu_si256(reinterpret_cast<const Vector *>(data));
+            }
+
+            static Vector add(Vector a, Vector b) noexcept {
+                if constexpr (sizeof(T) == 4) {
+                    return _mm256_add_epi32(a, b);
+                } else {
+                    return _mm256_add_epi64(a, b);
+                }
+            }
+
+            static Vector mul(Vector a, Vector b) noexcept { return _mm256_mullo_epi32(a, b); }
+            static void store(T *data, Vector v) noexcept { _mm256_store_si256(reinterpret_cast<Vector *>(data), v); }
+#else
+            using Vector = __m128i;
+            static constexpr std::size_t Width = sizeof(Vector) / sizeof(T);
+            static Vector zero() noexcept { return _mm_setzero_si128(); }
+            static Vector load(const T *data) noexcept {
+                return _mm_loadu_si128(reinterpret_cast<const Vector *>(data));
+            }
+
+            static Vector add(Vector a, Vector b) noexcept {
+                if constexpr (sizeof(T) == 4) {
+                    return _mm_add_epi32(a, b);
+                } else {
+                    return _mm_add_epi64(a, b);
+                }
+            }
+
+#ifdef __SSE4_1__
+            static Vector mul(Vector a, Vector b) noexcept { return _mm_mullo_epi32(a, b); }
+#endif
+            static void store(T *data, Vector v) noexcept { _mm_store_si128(reinterpret_cast<Vector *>(data), v); }
+#endif
+            static T sum(Vector v) noexcept {
+                alignas(sizeof(Vector)) T values[Width];
+                store(values, v);
+                Unsigned result = 0;
+                for (auto value : values) {
+                    result += static_cast<Unsigned>(value);
+                }
+
+                return static_cast<T>(result);
+            }
+        };
+
+        template<>
+        struct SimdTraits<std::int32_t> : SimdIntegerTraits<std::int32_t> {};
+
+        template<>
+        struct SimdTraits<std::int64_t> : SimdIntegerTraits<std::int64_t> {};
+
+        /**
+         * true if the target architecture can multiply 32 bit integer vectors (SSE4.1)
+         */
+#if defined(__AVX2__) || defined(__SSE4_1__)
+        constexpr inline bool HasSimdIntegerMul = true;
+#else
+        constexpr inline bool HasSimdIntegerMul = false;
+#endif
+
+        /**
+         * true if SIMD kernels are available for the target architecture
+         */
+        constexpr inline bool HasSimdKernels = true;
+
+        /**
+         * Sums a contiguous array using four independent vector accumulators
+         * @tparam T float, double, std::int32_t or std::int64_t
+         * @param data first element
+         * @param count number of elements
+         * @return sum of all elements
+         */
+        template<typename T>
+        T simd_sum(const T *data, std::size_t count) noexcept {
+            using S = SimdTraits<T>;
+            constexpr auto W = S::Width;
+            auto a0 = S::zero(), a1 = S::zero(), a2 = S::zero(), a3 = S::zero();
+            std::size_t i = 0;
+            for (; i + 4 * W <= count; i += 4 * W) {
+                a0 = S::add(a0, S::load(data + i));
+                a1 = S::add(a1, S::load(data + i + W));
+                a2 = S::add(a2, S::load(data + i + 2 * W));
+                a3 = S::add(a3, S::load(data + i + 3 * W));
+            }
+
+            for (; i + W <= count; i += W) {
+                a0 = S::add(a0, S::load(data + i));
+            }
+
+            T result = S::sum(S::add(S::add(a0, a1), S::add(a2, a3)));
+            for (; i < count; ++i) {
+                result += data[i];
+            }
+
+            return result;
+        }
+
+        /**
+         * Computes the dot product of two contiguous arrays using four independent vector accumulators
+         * @tparam T float, double or std::int32_t (if HasSimdIntegerMul)
+         * @param lhs first element of the left array
+         * @param rhs first element of the right array
+         * @param count number of elements
+         * @return sum of all products lhs[i] * rhs[i]
+         */
+        template<typename T>
+        T simd_dot(const T *lhs, const T *rhs, std::size_t count) noexcept {
+            using S = SimdTraits<T>;
+            constexpr auto W = S::Width;
+            auto a0 = S::zero(), a1 = S::zero(), a2 = S::zero(), a3 = S::zero();
+            std::size_t i = 0;
+            for (; i + 4 * W <= count; i += 4 * W) {
+                a0 = S::add(a0, S::mul(S::load(lhs + i), S::load(rhs + i)));
+                a1 = S::add(a1, S::mul(S::load(lhs + i + W), S::load(rhs + i + W)));
+                a2 = S::add(a2, S::mul(S::load(lhs + i + 2 * W), S::load(rhs + i + 2 * W)));
+                a3 = S::add(a3, S::mul(S::load(lhs + i + 3 * W), S::load(rhs + i + 3 * W)));
+            }
+
+            for (; i + W <= count; i += W) {
+                a0 = S::add(a0, S::mul(S::load(lhs + i), S::load(rhs + i)));
+            }
+
+            T result = S::sum(S::add(S::add(a0, a1), S::add(a2, a3)));
+            for (; i < count; ++i) {
+                result += lhs[i] * rhs[i];
+            }
+
+            return result;
+        }
+#else
+        constexpr inline bool HasSimdKernels = false;
+        constexpr inline bool HasSimdIntegerMul = false;
+
+        template<typename T>
+        T simd_sum(const T *, std::size_t) noexcept;
+
+        template<typename T>
+        T simd_dot(const T *, const T *, std::size_t) noexcept;
+#endif
+
+        /**
+         * Reduction over an iterator range using K independent accumulators. The first K mapped elements initialize
+         * the accumulators, which are combined with init at the end
+         * @tparam K number of accumulators
+         */
+        template<std::size_t K, typename Iterator, typename Sentinel, typename T, typename ReduceOp, typename MapOp,
+                std::size_t ...Idx>
+        T unrolled_reduce(Iterator first, Sentinel last, T init, ReduceOp &reduceOp, MapOp &mapOp,
+                          std::index_sequence<Idx...>) {
+            if constexpr (traits::is_random_accessible_v<Iterator> && traits::has_difference_v<Sentinel, Iterator>) {
+                const auto count = last - first;
+                if (count < static_cast<decltype(count)>(K)) {
+                    for (; first != last; ++first) {
+                        init = reduceOp(std::move(init), mapOp(*first));
+                    }
+
+                    return init;
+                }
+
+                using Difference = decltype(last - first);
+                constexpr auto Step = static_cast<Difference>(K);
+                std::array<T, K> acc{static_cast<T>(mapOp(first[static_cast<Difference>(Idx)]))...};
+                auto i = Step;
+                for (; i + Step <= count; i += Step) {
+                    ((acc[Idx] = reduceOp(std::move(acc[Idx]), mapOp(first[i + static_cast<Difference>(Idx)]))), ...);
+                }
+
+                for (; i < count; ++i) {
+                    acc[0] = reduceOp(std::move(acc[0]), mapOp(first[i]));
+                }
+
+                ((init = reduceOp(std::move(init), std::move(acc[Idx]))), ...);
+                return init;
+            } else {
+                std::array<std::optional<T>, K> start;
+                std::size_t filled = 0;
+                for (; filled < K && first != last; ++filled, ++first) {
+                    start[filled].emplace(mapOp(*first));
+                }
+
+                if (filled < K) {
+                    for (std::size_t j = 0; j < filled; ++j) {
+                        init = reduceOp(std::move(init), std::move(*start[j]));
+                    }
+
+                    return init;
+                }
+
+                std::array<T, K> acc{std::move(*start[Idx])...};
+                bool done = false;
+                auto step = [&](T &accumulator) {
+                    if (first == last) {
+                        done = true;
+                    } else if (not done) {
+                        accumulator = reduceOp(std::move(accumulator), mapOp(*first));
+                        ++first;
+                    }
+                };
+
+                while (not done) {
+                    (step(acc[Idx]), ...);
+                }
+
+                ((init = reduceOp(std::move(init), std::move(acc[Idx]))), ...);
+                return init;
+            }
+        }
+
+        /**
+         * Checks whether a reduction can be computed by one of the SIMD kernels and computes it if so
+         * @return true if the result was computed
+         */
+        template<typename Iterator, typename Sentinel, typename T, typename ReduceOp, typename MapOp>
+        bool simd_reduce(const Iterator &first, const Sentinel &last, T &result) {
+            if constexpr (HasSimdKernels && (traits::is_simd_float_v<T> || traits::is_simd_integer_v<T>) &&
+                          traits::is_plus_v<ReduceOp, T>) {
+                if constexpr (std::is_same_v<MapOp, Identity> && traits::is_contiguous_v<Iterator> &&
+                              std::is_same_v<Iterator, Sentinel> &&
+                              std::is_same_v<typename std::iterator_traits<Iterator>::value_type, T>) {
+                    auto count = static_cast<std::size_t>(last - first);
+                    if (count != 0) {
+                        result += simd_sum(std::addressof(*first), count);
+                    }
+
+                    return true;
+                } else if constexpr (std::is_same_v<MapOp, product> && traits::has_get_iterators<Iterator>::value &&
+                                     (traits::is_simd_float_v<T> ||
+                                      (HasSimdIntegerMul && std::is_same_v<T, std::int32_t>))) {
+                    using Iterators = std::remove_cv_t<std::remove_reference_t<decltype(first.getIterators())>>;
+                    if constexpr (std::tuple_size_v<Iterators> == 2) {
+                        using Lhs = std::tuple_element_t<0, Iterators>;
+                        using Rhs = std::tuple_element_t<1, Iterators>;
+                        if constexpr (traits::is_contiguous_v<Lhs> && traits::is_contiguous_v<Rhs> &&
+                                      std::is_same_v<typename std::iterator_traits<Lhs>::value_type, T> &&
+                                      std::is_same_v<typename std::iterator_traits<Rhs>::value_type, T>) {
+                            auto count = static_cast<std::size_t>(impl::distance(first, last));
+                            if (count != 0) {
+                                result += simd_dot(std::addressof(*std::get<0>(first.getIterators())),
+                                                   std::addressof(*std::get<1>(first.getIterators())), count);
+                            }
+
+                            return true;
+                        }
+                    }
+                }
+            }
+
+            return false;
+        }
+    }
+
+    namespace impl {
+        namespace traits {
+            /**
+             * @brief Detects run iterators, i.e. iterators over run-length encoded data that know how many rows
+             * remain in the current run (e.g. impl::RleIterator)
+             */
+            template<typename T, typename = std::void_t<>>
+            struct has_runs : std::false_type {};
+
+            template<typename T>
+            struct has_runs<T, std::void_t<decltype(std::declval<const T &>().runRemaining())>> : std::true_type {};
+
+            template<typename Tuple>
+            struct run_column {
+                static constexpr bool value = false;
+            };
+
+            template<typename ...Ts>
+            struct run_column<std::tuple<Ts...>> {
+                static constexpr bool value = (has_runs<Ts>::value || ...);
+                static constexpr std::size_t index = [] {
+                    constexpr std::array<bool, sizeof...(Ts)> runs{has_runs<Ts>::value...};
+                    std::size_t i = 0;
+                    while (i < runs.size() && not runs[i]) {
+                        ++i;
+                    }
+
+                    return i;
+                }();
+            };
+
+            /**
+             * @brief Detects zip iterators with at least one run iterator column
+             */
+            template<typename T, typename = std::void_t<>>
+            struct has_run_column : std::false_type {};
+
+            template<typename T>
+            struct has_run_column<T, std::void_t<decltype(std::declval<const T &>().getIterators())>>
+                    : run_column<std::remove_cv_t<std::remove_reference_t<
+                            decltype(std::declval<const T &>().getIterators())>>> {};
+        }
+
+        /**
+         * @param it run iterator or zip iterator with a run column
+         * @return the run iterator (the first run column of a zip iterator)
+         */
+        template<typename Iterator>
+        constexpr decltype(auto) run_iterator(const Iterator &it) noexcept {
+            if constexpr (traits::has_runs<Iterator>::value) {
+                return (it);
+            } else {
+                using Iterators = std::remove_cv_t<std::remove_reference_t<decltype(it.getIterators())>>;
+                return std::get<traits::run_column<Iterators>::index>(it.getIterators());
+            }
+        }
+
+        /**
+         * @param first run iterator or zip iterator with a run column
+         * @param last end of the range
+         * @return number of rows from first to the end of its run or to last, whichever comes first
+         */
+        template<typename Iterator>
+        std::ptrdiff_t run_length(const Iterator &first, const Iterator &last) {
+            return std::min(static_cast<std::ptrdiff_t>(run_iterator(first).runRemaining()),
+                            static_cast<std::ptrdiff_t>(last - first));
+        }
+
+        template<std::size_t K, typename Iterator, typename Sentinel, typename T, typename ReduceOp, typename MapOp>
+        T transform_reduce_range(Iterator first, Sentinel last, T init, ReduceOp &reduceOp, MapOp &mapOp);
+
+        /**
+         * Checks whether a sum can be computed run by run and computes it if so. A run of n equal values adds
+         * value * n. For a zip of a run column and a random access column with mapOp product, a run adds value
+         * times the sum of the other column over the run. Only used if the column value types are T
+         * @return true if the result was computed
+         */
+        template<typename Iterator, typename Sentinel, typename T, typename ReduceOp, typename MapOp>
+        bool run_reduce(Iterator first, const Sentinel &last, T &result) {
+            if constexpr (std::is_arithmetic_v<T> && traits::is_plus_v<ReduceOp, T> &&
+                          std::is_same_v<Iterator, Sentinel> && traits::is_random_accessible_v<Iterator>) {
+                // mixed value types are left to the generic path which converts after each step like the serial sum
+                if constexpr (std::is_same_v<MapOp, Identity> && traits::has_runs<Iterator>::value &&
+                              std::is_same_v<typename std::iterator_traits<Iterator>::value_type, T>) {
+                    while (first != last) {
+                        const auto count = run_length(first, last);
+                        result += static_cast<T>(*first) * static_cast<T>(count);
+                        first += count;
+                    }
+
+                    return true;
+                } else if constexpr (std::is_same_v<MapOp, product> && traits::has_run_column<Iterator>::value) {
+                    using Iterators = std::remove_cv_t<std::remove_reference_t<decltype(first.getIterators())>>;
+                    constexpr auto RunIdx = traits::run_column<Iterators>::index;
+                    if constexpr (std::tuple_size_v<Iterators> == 2) {
+                        using RunIt = std::tuple_element_t<RunIdx, Iterators>;
+                        using OtherIt = std::tuple_element_t<1 - RunIdx, Iterators>;
+                        if constexpr (traits::is_random_accessible_v<OtherIt> &&
+                                      std::is_same_v<typename std::iterator_traits<RunIt>::value_type, T> &&
+                                      std::is_same_v<typename std::iterator_traits<OtherIt>::value_type, T>) {
+                            std::plus<T> plus;
+                            Identity identity;
+                            while (first != last) {
+                                const auto count = run_length(first, last);
+                                const auto &iterators = first.getIterators();
+                                auto other = std::get<1 - RunIdx>(iterators);
+                                auto sum = transform_reduce_range<4>(other, other + count, T{}, plus, identity);
+                                result += static_cast<T>(*std::get<RunIdx>(iterators)) * sum;
+                                first += count;
+                            }
+
+                            return true;
+                        }
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        namespace traits {
+            /**
+             * @brief Detects indexed iterators over contiguous data and indices whose elements the gather kernels can
+             * load
+             */
+            template<typename T>
+            struct is_gatherable : std::false_type {};
+
+            template<typename DataIterator, typename IndexIterator>
+            struct is_gatherable<IndexedIterator<DataIterator, IndexIterator>> {
+                static constexpr bool value = is_contiguous_v<DataIterator> && is_contiguous_v<IndexIterator> &&
+                        has_gather_kernel_v<typename std::iterator_traits<DataIterator>::value_type,
+                                            typename std::iterator_traits<IndexIterator>::value_type>;
+            };
+        }
+
+        /**
+         * Number of elements of an indexed view that are gathered into a buffer at once before they are reduced
+         */
+        constexpr inline std::size_t GatherBlockSize = 256;
+
+        /**
+         * Checks whether the range is an indexed view over contiguous data and indices and reduces it block by block
+         * if so. Each block is gathered into a buffer using the gather kernels and then reduced from the buffer
+         * @return true if the result was computed
+         */
+        template<std::size_t K, typename Iterator, typename Sentinel, typename T, typename ReduceOp, typename MapOp>
+        bool gather_reduce(const Iterator &first, const Sentinel &last, T &result, ReduceOp &reduceOp,
+                           MapOp &mapOp) {
+            if constexpr (std::is_same_v<Iterator, Sentinel> && traits::is_gatherable<Iterator>::value) {
+                std::array<typename std::iterator_traits<Iterator>::value_type, GatherBlockSize> buffer;
+                const auto *table = std::addressof(*first.dataBegin());
+                const auto *indices = std::addressof(*first.base());
+                const auto count = static_cast<std::size_t>(last.base() - first.base());
+                for (std::size_t offset = 0; offset < count; offset += GatherBlockSize) {
+                    const auto blockSize = std::min(GatherBlockSize, count - offset);
+                    // the table size is unknown, unsigned 32 bit indices are therefore gathered by the scalar loop
+                    gather_contiguous(table, std::numeric_limits<std::size_t>::max(), indices + offset, blockSize,
+                                      buffer.data());
+                    result = transform_reduce_range<K>(buffer.data(), buffer.data() + blockSize, std::move(result),
+                                                       reduceOp, mapOp);
+                }
+
+                return true;
+            }
+
+            return false;
+        }
+
+        /**
+         * Reduces the mapped elements of an iterator range. Uses a SIMD kernel, run-length encoding or batched
+         * gathers if possible and K independent accumulators otherwise
+         * @tparam K number of accumulators
+         */
+        template<std::size_t K, typename Iterator, typename Sentinel, typename T, typename ReduceOp, typename MapOp>
+        T transform_reduce_range(Iterator first, Sentinel last, T init, ReduceOp &reduceOp, MapOp &mapOp) {
+            static_assert(K > 0, "at least one accumulator is required");
+            if (simd_reduce<Iterator, Sentinel, T, ReduceOp, MapOp>(first, last, init)) {
+                return init;
+            }
+
+            if (run_reduce<Iterator, Sentinel, T, ReduceOp, MapOp>(first, last, init)) {
+                return init;
+            }
+
+            if (gather_reduce<K>(first, last, init, reduceOp, mapOp)) {
+                return init;
+            }
+
+            return unrolled_reduce<K>(std::move(first), std::move(last), std::move(init), reduceOp, mapOp,
+                                      std::make_index_sequence<K>());
+        }
+    }
+
+    /**
+     * Reduces the mapped elements of a range. Uses K independent accumulators (unrolled) to break the dependency
+     * between consecutive accumulation steps. If the range is a zip of two contiguous float, double or std::int32_t
+     * columns (std::int32_t requires SSE4.1), reduceOp is std::plus and mapOp is product, a SIMD dot product kernel is
+     * used instead. If one of two zipped columns is run-length encoded (impl::RleColumn) and both value types are T,
+     * each run contributes its value times the sum of the other column over the run. Indexed views (impl::IndexedView)
+     * over contiguous 4 or 8 byte arithmetic data are gathered block by block into a buffer using hardware gather
+     * instructions and reduced from there.
+     * @tparam K number of independent accumulators (default 4)
+     * @tparam Range range type (e.g. impl::ZipView)
+     * @tparam T accumulator type
+     * @tparam ReduceOp binary reduction operation. Must be associative and commutative
+     * @tparam MapOp unary mapping operation
+     * @param range input range
+     * @param init initial value
+     * @param reduceOp reduction operation
+     * @param mapOp mapping operation applied to each element
+     * @return init reduced with all mapped elements in unspecified order
+     * @note Like std::transform_reduce, the result may differ from a serial accumulation for non-associative
+     * operations such as floating point addition
+     */
+    template<std::size_t K = 4, typename Range, typename T, typename ReduceOp, typename MapOp>
+    T transform_reduce(Range &&range, T init, ReduceOp reduceOp, MapOp mapOp) {
+        return impl::transform_reduce_range<K>(std::begin(range), std::end(range), std::move(init), reduceOp, mapOp);
+    }
+
+    /**
+     * Reduces the elements of a range. Uses K independent accumulators (unrolled) to break the dependency between
+     * consecutive accumulation steps. Sums of contiguous float, double, std::int32_t or std::int64_t ranges use a SIMD
+     * kernel. Sums of run-length encoded columns (impl::RleColumn) with value type T add each run value multiplied by
+     * its run length. Indexed views (impl::IndexedView) over contiguous arithmetic data are gathered in blocks before
+     * they are reduced.
+     * @tparam K number of independent accumulators (default 4)
+     * @tparam Range range type
+     * @tparam T accumulator type
+     * @tparam ReduceOp binary reduction operation. Must be associative and commutative
+     * @param range input range
+     * @param init initial value
+     * @param reduceOp reduction operation (default std::plus)
+     * @return init reduced with all elements in unspecified order
+     */
+    template<std::size_t K = 4, typename Range, typename T, typename ReduceOp = std::plus<>>
+    T reduce(Range &&range, T init, ReduceOp reduceOp = {}) {
+        return transform_reduce<K>(std::forward<Range>(range), std::move(init), std::move(reduceOp),
+                                   impl::Identity{});
+    }
+
+    namespace impl {
+        /**
+         * Accumulates the next element of a prefix scan
+         * @tparam Inclusive if true, an empty accumulator is initialized with the element
+         * @param accumulator accumulation of the preceding elements
+         * @param element next element
+         * @param op binary operation
+         * @return accumulation including element
+         */
+        template<bool Inclusive, typename T, typename Element, typename Op>
+        T next_accumulation(const std::optional<T> &accumulator, Element &&element, const Op &op) {
+            if constexpr (Inclusive) {
+                if (not accumulator.has_value()) {
+                    return T(std::forward<Element>(element));
+                }
+            }
+
+            return op(*accumulator, std::forward<Element>(element));
+        }
+
+        /**
+         * @brief Iterator of a lazy prefix scan. Holds the accumulation of all preceding elements and combines it
+         * with the current element on dereference (inclusive scan).
+         * @tparam Iterator underlying iterator type
+         * @tparam T accumulator type
+         * @tparam Op binary operation type
+         * @tparam Inclusive whether the current element is part of the produced value
+         */
+        template<typename Iterator, typename T, typename Op, bool Inclusive>
+        class ScanIterator : public SynthesizedOperators<ScanIterator<Iterator, T, Op, Inclusive>> {
+        public:
+            using value_type = T;
+            using reference = T;
+            using pointer = void;
+            using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+            using iterator_category = std::conditional_t<std::is_base_of_v<std::forward_iterator_tag,
+                    typename std::iterator_traits<Iterator>::iterator_category>, std::forward_iterator_tag,
+                    std::input_iterator_tag>;
+
+            using SynthesizedOperators<ScanIterator>::operator++;
+
+            constexpr ScanIterator() = default;
+
+            /**
+             * CTor
+             * @param it underlying iterator
+             * @param accumulator accumulation of all elements before it (empty for an inclusive scan without
+             * initial value)
+             * @param op binary operation. Must outlive the iterator
+             */
+            constexpr ScanIterator(Iterator it, std::optional<T> accumulator, const Op &op) :
+                    it(std::move(it)), accumulator(std::move(accumulator)), op(std::addressof(op)) {}
+
+            /**
+             * @return accumulation of all preceding elements (exclusive) or of all elements up to and including the
+             * current element (inclusive)
+             */
+            constexpr T operator*() const {
+                if constexpr (Inclusive) {
+                    // cached, so that the element is read and op is applied only once per position
+                    if (not current.has_value()) {
+                        current = next_accumulation<true>(accumulator, *it, *op);
+                    }
+
+                    return *current;
+                } else {
+                    return *accumulator;
+                }
+            }
+
+            /**
+             * Adds the current element to the accumulation and increments the underlying iterator
+             * @return reference to this
+             */
+            constexpr ScanIterator &operator++() {
+                if constexpr (Inclusive) {
+                    if (current.has_value()) {
+                        accumulator = std::move(current);
+                        current.reset();
+                    } else {
+                        accumulator = next_accumulation<true>(accumulator, *it, *op);
+                    }
+                } else {
+                    accumulator = next_accumulation<false>(accumulator, *it, *op);
+                }
+
+                ++it;
+                return *this;
+            }
+
+            /**
+             * Equality comparison
+             * @param other right hand side
+             * @return true if the underlying iterators are equal
+             */
+            constexpr bool operator==(const ScanIterator &other) const {
+                return it == other.it;
+            }
+
+            /**
+             * @return underlying iterator
+             */
+            constexpr const Iterator &base() const noexcept {
+                return it;
+            }
+
+        private:
+            Iterator it{};
+            std::optional<T> accumulator;
+            mutable std::optional<T> current;
+            const Op *op = nullptr;
+        };
+
+        /**
+         * @brief Lazy prefix scan over a range. Each element of the view is computed when the iterator is
+         * dereferenced.
+         * @tparam Range underlying range type. Begin and end must have the same type
+         * @tparam T accumulator type
+         * @tparam Op binary operation type
+         * @tparam Inclusive inclusive or exclusive scan
+         */
+        template<typename Range, typename T, typename Op, bool Inclusive>
+        struct ScanView DERIVE_VIEW_INTERFACE(ScanView<Range, T, Op, Inclusive>) {
+        private:
+            template<bool Const>
+            using Iterator = decltype(std::begin(std::declval<std::add_lvalue_reference_t<
+                    traits::const_if_t<Const, std::remove_reference_t<Range>>>>()));
+        public:
+            /**
+             * CTor.
+             * @tparam R range type
+             * @param range underlying range
+             * @param op binary operation
+             * @param init initial value (optional for inclusive scans)
+             */
+            template<typename R>
+            constexpr ScanView(R &&range, Op op, std::optional<T> init) :
+                    range(std::forward<R>(range), std::move(op), std::move(init)) {}
+
+            ScanView() = default;
+
+            /**
+             * @return ScanIterator to the first element
+             */
+            auto begin() {
+                auto &[r, op, init] = range;
+                return ScanIterator<Iterator<false>, T, Op, Inclusive>(std::begin(r), init, op);
+            }
+
+            /**
+             * @return ScanIterator to the element following the last element
+             */
+            auto end() {
+                auto &[r, op, init] = range;
+                return ScanIterator<Iterator<false>, T, Op, Inclusive>(std::end(r), std::nullopt, op);
+            }
+
+            /**
+             * @copydoc ScanView::begin()
+             */
+            template<bool C = true>
+            auto begin() const -> ScanIterator<Iterator<C>, T, Op, Inclusive> {
+                auto &[r, op, init] = range;
+                return ScanIterator<Iterator<true>, T, Op, Inclusive>(std::begin(r), init, op);
+            }
+
+            /**
+             * @copydoc ScanView::end()
+             */
+            template<bool C = true>
+            auto end() const -> ScanIterator<Iterator<C>, T, Op, Inclusive> {
+                auto &[r, op, init] = range;
+                return ScanIterator<Iterator<true>, T, Op, Inclusive>(std::end(r), std::nullopt, op);
+            }
+
+            /**
+             * Returns the size of the underlying range. Only available if the range knows its size
+             * @tparam HasSize SFINAE guard, do not specify explicitly
+             * @return size of the underlying range
+             */
+            template<bool HasSize = traits::has_size_v<Range>>
+            constexpr auto size() const -> std::enable_if_t<HasSize, std::size_t> {
+                return std::size(std::get<0>(range));
+            }
+
+        private:
+            std::tuple<Range, Op, std::optional<T>> range;
+        };
+
+        template<typename Range, typename Op>
+        using inclusive_scan_t = std::decay_t<std::invoke_result_t<Op &, decltype(*std::begin(std::declval<Range &>())),
+                decltype(*std::begin(std::declval<Range &>()))>>;
+    }
+
+    /**
+     * Lazy inclusive prefix scan. The i-th element of the resulting view is the accumulation of the elements 0 to i
+     * of the range. Can be used as zip column, e.g. to produce offsets next to counts.
+     * @tparam Range range type (e.g. impl::ZipView)
+     * @tparam Op binary operation type
+     * @param range input range. Temporaries are moved into the view
+     * @param op associative binary operation (default std::plus)
+     * @return impl::ScanView over range
+     * @note Elements are computed on the fly, so the view can only be traversed in forward direction
+     * @relatesalso impl::ScanView
+     */
+    template<typename Range, typename Op = std::plus<>>
+    constexpr auto inclusive_scan(Range &&range, Op op = {}) {
+        using T = impl::inclusive_scan_t<Range, Op>;
+        return impl::ScanView<Range, T, Op, true>(std::forward<Range>(range), std::move(op), std::nullopt);
+    }
+
+    /**
+     * Lazy inclusive prefix scan with initial value. The i-th element of the resulting view is init accumulated with
+     * the elements 0 to i of the range.
+     * @tparam Range range type (e.g. impl::ZipView)
+     * @tparam Op binary operation type
+     * @tparam T accumulator type
+     * @param range input range. Temporaries are moved into the view
+     * @param op associative binary operation
+     * @param init initial value
+     * @return impl::ScanView over range
+     * @relatesalso impl::ScanView
+     */
+    template<typename Range, typename Op, typename T>
+    constexpr auto inclusive_scan(Range &&range, Op op, T init) {
+        return impl::ScanView<Range, T, Op, true>(std::forward<Range>(range), std::move(op), std::move(init));
+    }
+
+    /**
+     * Lazy exclusive prefix scan. The i-th element of the resulting view is init accumulated with the elements 0 to
+     * i - 1 of the range.
+     * @tparam Range range type (e.g. impl::ZipView)
+     * @tparam T accumulator type
+     * @tparam Op binary operation type
+     * @param range input range. Temporaries are moved into the view
+     * @param init initial value
+     * @param op associative binary operation (default std::plus)
+     * @return impl::ScanView over range
+     * @relatesalso impl::ScanView
+     */
+    template<typename Range, typename T, typename Op = std::plus<>>
+    constexpr auto exclusive_scan(Range &&range, T init, Op op = {}) {
+        return impl::ScanView<Range, T, Op, false>(std::forward<Range>(range), std::move(op), std::move(init));
+    }
+
+    namespace impl {
+        /**
+         * Number of rows whose predicate results are packed into one mask word during compaction
+         */
+        constexpr inline std::size_t CompactBlockSize = 64;
+
+        /**
+         * @param it zip iterator or plain iterator
+         * @return tuple of the column iterators of a zip iterator or a tuple containing it for other iterators
+         */
+        template<typename Iterator>
+        constexpr auto column_iterators(const Iterator &it) {
+            if constexpr (traits::has_get_iterators<Iterator>::value) {
+                return it.getIterators();
+            } else {
+                return std::make_tuple(it);
+            }
+        }
+
+        template<typename Function, typename Src, typename Dst, std::size_t ...Idx>
+        void for_each_column_pair(Function &&function, const Src &src, const Dst &dst, std::index_sequence<Idx...>) {
+            (function(std::get<Idx>(src), std::get<Idx>(dst)), ...);
+        }
+
+        /**
+         * Invokes function(srcColumn, dstColumn) for each pair of corresponding column iterators
+         * @param function binary function
+         * @param src tuple of input column iterators
+         * @param dst tuple of output column iterators
+         */
+        template<typename Function, typename Src, typename Dst>
+        void for_each_column_pair(Function &&function, const Src &src, const Dst &dst) {
+            static_assert(std::tuple_size_v<Src> == std::tuple_size_v<Dst>,
+                          "input and output must have the same number of columns");
+            for_each_column_pair(function, src, dst, std::make_index_sequence<std::tuple_size_v<Src>>());
+        }
+
+        namespace traits {
+            template<typename Src, typename Dst, typename = std::void_t<>>
+            struct has_compress_kernel : std::false_type {};
+
+            template<typename Src, typename Dst>
+            struct has_compress_kernel<Src, Dst, std::void_t<typename std::iterator_traits<Src>::value_type,
+                    typename std::iterator_traits<Dst>::value_type>> {
+                using T = typename std::iterator_traits<Src>::value_type;
+                static constexpr bool value = is_contiguous_v<Src> && is_contiguous_v<Dst> &&
+                                              std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8) &&
+                                              std::is_same_v<T, typename std::iterator_traits<Dst>::value_type>;
+            };
+
+            template<typename Src, typename Dst>
+            constexpr inline bool has_compress_kernel_v = has_compress_kernel<Src, Dst>::value;
+        }
+
+        /**
+         * Evaluates the predicate for up to 64 rows without branching
+         * @return word where bit j is set if pred(first[j]) is true
+         */
+        template<typename Iterator, typename Predicate>
+        std::uint64_t predicate_mask(Iterator first, std::size_t count, Predicate &pred) {
+            std::uint64_t mask = 0;
+            for (std::size_t j = 0; j < count; ++j, ++first) {
+                mask |= std::uint64_t(static_cast<bool>(pred(*first))) << j;
+            }
+
+            return mask;
+        }
+
+        /**
+         * Writes the elements of a column block whose mask bit is set consecutively to dst. Every element is
+         * written and the destination only advances if the bit is set, so there is no data dependent branch. With
+         * AVX-512, contiguous 4 and 8 byte columns use compress stores.
+         * @param src first element of the block
+         * @param count number of elements in the block (at most 64)
+         * @param mask selection mask
+         * @param dst destination. Must have room for all selected elements. The bit of the last element must be set
+         */
+        template<typename Src, typename Dst>
+        void compact_column(Src src, std::size_t count, std::uint64_t mask, Dst dst) {
+            std::size_t j = 0;
+#ifdef __AVX512F__
+            if constexpr (traits::has_compress_kernel_v<Src, Dst>) {
+                using T = typename std::iterator_traits<Src>::value_type;
+                auto in = std::addressof(*src);
+                auto out = std::addressof(*dst);
+                if constexpr (sizeof(T) == 4) {
+                    for (; j + 16 <= count; j += 16) {
+                        auto bits = static_cast<__mmask16>(mask >> j);
+                        _mm512_mask_compressstoreu_epi32(out, bits, _mm512_loadu_si512(in + j));
+                        out += popcount(bits);
+                    }
+                } else {
+                    for (; j + 8 <= count; j += 8) {
+                        auto bits = static_cast<__mmask8>(mask >> j);
+                        _mm512_mask_compressstoreu_epi64(out, bits, _mm512_loadu_si512(in + j));
+                        out += popcount(bits);
+                    }
+                }
+
+                dst += out - std::addressof(*dst);
+            }
+#endif
+            using Difference = typename std::iterator_traits<Src>::difference_type;
+            for (; j < count; ++j) {
+                *dst = src[static_cast<Difference>(j)];
+                dst += static_cast<typename std::iterator_traits<Dst>::difference_type>((mask >> j) & 1);
+            }
+        }
+
+        /**
+         * Writes the selected rows of a block to out. The block is cut after its last selected row so that no
+         * element after the last selected row is written
+         * @param first first row of the block
+         * @param mask selection mask
+         * @param out destination of the first selected row
+         * @return number of rows written
+         */
+        template<typename Iterator, typename OutputIterator>
+        std::size_t compact_block(const Iterator &first, std::uint64_t mask, const OutputIterator &out) {
+            if (mask == 0) {
+                return 0;
+            }
+
+            std::size_t used = CompactBlockSize - count_leading_zeros(mask);
+            for_each_column_pair([used, mask](const auto &src, const auto &dst) {
+                compact_column(src, used, mask, dst);
+            }, column_iterators(first), column_iterators(out));
+            return popcount(mask);
+        }
+
+        /**
+         * Branch-free compaction of count rows. Rows are processed in blocks of 64: first the predicate is evaluated
+         * into a mask word, then every column is compacted separately.
+         * @param first first input row (random access)
+         * @param count number of input rows
+         * @param pred predicate
+         * @param out first output row (random access). May be equal to first
+         * @return number of rows written
+         */
+        template<typename Iterator, typename Predicate, typename OutputIterator>
+        std::size_t compact_rows(const Iterator &first, std::size_t count, Predicate &pred,
+                                 const OutputIterator &out) {
+            using Difference = typename std::iterator_traits<Iterator>::difference_type;
+            using OutDifference = typename std::iterator_traits<OutputIterator>::difference_type;
+            std::size_t written = 0;
+            for (std::size_t block = 0; block < count; block += CompactBlockSize) {
+                auto it = first + static_cast<Difference>(block);
+                auto mask = predicate_mask(it, std::min(CompactBlockSize, count - block), pred);
+                written += compact_block(it, mask, out + static_cast<OutDifference>(written));
+            }
+
+            return written;
+        }
+    }
+
+    /**
+     * Copies the rows of a (zipped) range that satisfy a predicate to an output range (stream compaction).
+     * If both ranges are random access, predicate results are packed into mask words and every column is compacted
+     * without data dependent branches: each element is written and the destination only advances for selected rows.
+     * With AVX-512, contiguous 4 and 8 byte columns use compress stores. Otherwise, the rows are copied one by one
+     * like std::copy_if.
+     * @tparam Range input range type (e.g. impl::ZipView)
+     * @tparam Predicate unary predicate type
+     * @tparam OutRange output range type with the same number of columns as the input
+     * @param range input range
+     * @param pred predicate that is invoked with the rows of range
+     * @param out output range. Must have room for all selected rows. May be the input range itself
+     * @return iterator to the output row following the last written row
+     */
+    template<typename Range, typename Predicate, typename OutRange>
+    auto compact(Range &&range, Predicate pred, OutRange &&out) {
+        auto first = std::begin(range);
+        auto outFirst = std::begin(out);
+        if constexpr (impl::traits::is_random_accessible_v<decltype(first)> &&
+                      impl::traits::is_random_accessible_v<decltype(outFirst)>) {
+            using OutDifference = typename std::iterator_traits<decltype(outFirst)>::difference_type;
+            auto count = static_cast<std::size_t>(impl::distance(first, std::end(range)));
+            return outFirst + static_cast<OutDifference>(impl::compact_rows(first, count, pred, outFirst));
+        } else {
+            auto last = std::end(range);
+            for (; first != last; ++first) {
+                if (pred(*first)) {
+                    impl::for_each_column_pair([](const auto &src, const auto &dst) { *dst = *src; },
+                                               impl::column_iterators(first), impl::column_iterators(outFirst));
+                    ++outFirst;
+                }
+            }
+
+            return outFirst;
+        }
+    }
+
+    namespace impl {
+        /**
+         * Number of row indices buffered per bucket during software write-combining (one cache line)
+         */
+        constexpr inline std::size_t WriteCombiningRows = 64 / sizeof(std::size_t);
+
+        /**
+         * Minimum number of buckets for which software write-combining is used. With fewer buckets, the output
+         * positions stay in cache and rows are scattered directly
+         */
+        constexpr inline std::size_t WriteCombiningMinBuckets = 64;
+
+        /**
+         * Copies rows to consecutive output positions column by column
+         * @param src tuple of input column iterators
+         * @param rows indices of the rows to copy
+         * @param count number of rows
+         * @param dst tuple of output column iterators
+         * @param position output position of the first row
+         */
+        template<typename Src, typename Dst>
+        void copy_rows(const Src &src, const std::size_t *rows, std::size_t count, const Dst &dst,
+                       std::size_t position) {
+            for_each_column_pair([rows, count, position](const auto &in, const auto &out) {
+                using InDifference = typename std::iterator_traits<std::decay_t<decltype(in)>>::difference_type;
+                using OutDifference = typename std::iterator_traits<std::decay_t<decltype(out)>>::difference_type;
+                for (std::size_t r = 0; r < count; ++r) {
+                    out[static_cast<OutDifference>(position + r)] = in[static_cast<InDifference>(rows[r])];
+                }
+            }, src, dst);
+        }
+
+        /**
+         * Computes the bucket of a row
+         * @param keys key column iterator
+         * @param row row index
+         * @param bucketFn function that maps a key to a bucket index
+         * @return bucket index
+         */
+        template<typename KeyIterator, typename BucketFn>
+        std::size_t bucket_of(const KeyIterator &keys, std::size_t row, BucketFn &bucketFn) {
+            using Difference = typename std::iterator_traits<KeyIterator>::difference_type;
+            return static_cast<std::size_t>(bucketFn(keys[static_cast<Difference>(row)]));
+        }
+
+        /**
+         * Counts the rows per bucket
+         * @param histogram per bucket counts that are incremented
+         */
+        template<std::size_t KeyIdx, typename Iterator, typename BucketFn>
+        void bucket_histogram(const Iterator &first, std::size_t begin, std::size_t end, std::size_t *histogram,
+                              BucketFn &bucketFn) {
+            auto keys = std::get<KeyIdx>(column_iterators(first));
+            for (auto row = begin; row < end; ++row) {
+                ++histogram[bucket_of(keys, row, bucketFn)];
+            }
+        }
+
+        /**
+         * Moves the rows [begin, end) to the next free positions of their buckets. With many buckets, row indices
+         * are first collected in small per-bucket buffers that are flushed one cache line at a time, so that the
+         * output is written in short contiguous runs instead of fully random accesses.
+         * @param positions next free output position of each bucket. Is advanced
+         */
+        template<std::size_t KeyIdx, typename Iterator, typename OutputIterator, typename BucketFn>
+        void scatter_rows(const Iterator &first, std::size_t begin, std::size_t end, const OutputIterator &out,
+                          std::size_t *positions, std::size_t numBuckets, BucketFn &bucketFn) {
+            const auto src = column_iterators(first);
+            const auto dst = column_iterators(out);
+            auto keys = std::get<KeyIdx>(src);
+            if (numBuckets < WriteCombiningMinBuckets) {
+                for (auto row = begin; row < end; ++row) {
+                    copy_rows(src, &row, 1, dst, positions[bucket_of(keys, row, bucketFn)]++);
+                }
+
+                return;
+            }
+
+            std::vector<std::size_t> buffers(numBuckets * WriteCombiningRows);
+            std::vector<std::size_t> fill(numBuckets);
+            for (auto row = begin; row < end; ++row) {
+                auto bucket = bucket_of(keys, row, bucketFn);
+                auto *buffer = buffers.data() + bucket * WriteCombiningRows;
+                buffer[fill[bucket]++] = row;
+                if (fill[bucket] == WriteCombiningRows) {
+                    copy_rows(src, buffer, WriteCombiningRows, dst, positions[bucket]);
+                    positions[bucket] += WriteCombiningRows;
+                    fill[bucket] = 0;
+                }
+            }
+
+            for (std::size_t bucket = 0; bucket < numBuckets; ++bucket) {
+                copy_rows(src, buffers.data() + bucket * WriteCombiningRows, fill[bucket], dst, positions[bucket]);
+                positions[bucket] += fill[bucket];
+            }
+        }
+    }
+
+    /**
+     * Partitions the rows of a (zipped) range by key (counting sort). A histogram pass counts the rows per bucket,
+     * then a scatter pass copies whole rows into contiguous per-bucket regions of the output. The relative order of
+     * rows within a bucket is preserved.
+     * @tparam KeyIdx index of the key column (default 0)
+     * @tparam Range random access range type (e.g. impl::ZipView)
+     * @tparam OutRange random access output range type with the same number of columns as the input
+     * @tparam BucketFn function type that maps keys to bucket indices
+     * @param range input range
+     * @param numBuckets number of buckets
+     * @param out output range. Must have room for all rows and must not overlap the input
+     * @param bucketFn function that maps a key to a bucket index in [0, numBuckets) (default: the key itself)
+     * @return bucket offsets (numBuckets + 1 values). Bucket i occupies the output rows [offsets[i], offsets[i + 1])
+     */
+    template<std::size_t KeyIdx = 0, typename Range, typename OutRange, typename BucketFn = impl::Identity>
+    std::vector<std::size_t> bucketize(Range &&range, std::size_t numBuckets, OutRange &&out,
+                                       BucketFn bucketFn = {}) {
+        auto first = std::begin(range);
+        static_assert(impl::traits::is_random_accessible_v<decltype(first)> &&
+                      impl::traits::is_random_accessible_v<decltype(std::begin(out))>,
+                      "bucketize requires random access ranges");
+        auto count = static_cast<std::size_t>(impl::distance(first, std::end(range)));
+        std::vector<std::size_t> offsets(numBuckets + 1);
+        impl::bucket_histogram<KeyIdx>(first, 0, count, offsets.data() + 1, bucketFn);
+        for (std::size_t bucket = 0; bucket < numBuckets; ++bucket) {
+            offsets[bucket + 1] += offsets[bucket];
+        }
+
+        std::vector<std::size_t> positions(offsets.begin(), offsets.end() - 1);
+        impl::scatter_rows<KeyIdx>(first, 0, count, std::begin(out), positions.data(), numBuckets, bucketFn);
+        return offsets;
+    }
+
+    namespace impl {
+        /**
+         * Number of elements that are skipped one by one before switching to exponential search
+         */
+        constexpr inline std::size_t GallopThreshold = 8;
+
+        /**
+         * Advances an iterator while a predicate holds. The predicate must be true for a prefix of the range and
+         * false for the rest. Random access iterators first probe a few elements linearly and then gallop
+         * (exponential search followed by binary search), so that long runs are skipped in logarithmic time.
+         * @param it start of the range
+         * @param last end of the range
+         * @param pred monotone predicate
+         * @return first iterator in [it, last) for which pred is false or last
+         */
+        template<typename Iterator, typename Predicate>
+        Iterator advance_while(Iterator it, const Iterator &last, Predicate &&pred) {
+            for (std::size_t i = 0; i < GallopThreshold; ++i, ++it) {
+                if (it == last || not pred(*it)) {
+                    return it;
+                }
+            }
+
+            if constexpr (traits::is_random_accessible_v<Iterator>) {
+                using Difference = typename std::iterator_traits<Iterator>::difference_type;
+                const Difference remaining = last - it;
+                Difference bound = 1;
+                while (bound < remaining && pred(it[bound])) {
+                    bound *= 2;
+                }
+
+                return std::partition_point(it + bound / 2, it + std::min(bound, remaining), pred);
+            } else {
+                while (it != last && pred(*it)) {
+                    ++it;
+                }
+
+                return it;
+            }
+        }
+
+        /**
+         * @param range range
+         * @return iterator to the end of range that has the same type as the begin iterator. Random access ranges
+         * with a different sentinel type (e.g. enumerate) are converted using impl::distance
+         */
+        template<typename Range>
+        auto common_end(Range &range) {
+            using Iterator = decltype(std::begin(range));
+            if constexpr (std::is_same_v<Iterator, decltype(std::end(range))>) {
+                return std::end(range);
+            } else {
+                static_assert(traits::is_random_accessible_v<Iterator>,
+                              "ranges with sentinels must be random access");
+                auto first = std::begin(range);
+                return first + static_cast<typename std::iterator_traits<Iterator>::difference_type>(
+                        distance(first, std::end(range)));
+            }
+        }
+
+        /**
+         * @brief Orders row indices by the rows they refer to. Equivalent rows are ordered by their index
+         * @tparam Iterator random access iterator to the first row
+         * @tparam Compare row comparison type
+         */
+        template<typename Iterator, typename Compare>
+        struct RowOrder {
+            Iterator first;
+            const Compare *comp;
+
+            bool operator()(std::size_t lhs, std::size_t rhs) const {
+                using Difference = typename std::iterator_traits<Iterator>::difference_type;
+                auto &&lhsRow = first[static_cast<Difference>(lhs)];
+                auto &&rhsRow = first[static_cast<Difference>(rhs)];
+                if ((*comp)(lhsRow, rhsRow)) {
+                    return true;
+                }
+
+                return not (*comp)(rhsRow, lhsRow) && lhs < rhs;
+            }
+        };
+
+        /**
+         * Selects the k first rows of [begin, end) with respect to comp. Only row indices are moved.
+         * @param first iterator to the first row
+         * @param begin index of the first row to consider
+         * @param end index after the last row to consider
+         * @param k number of rows to select
+         * @param comp row comparison
+         * @param heap empty output vector. Contains the selected row indices as a max heap with respect to RowOrder,
+         * i.e. the worst selected row is at the front
+         */
+        template<typename Iterator, typename Compare>
+        void top_k_heap(const Iterator &first, std::size_t begin, std::size_t end, std::size_t k,
+                        const Compare &comp, std::vector<std::size_t> &heap) {
+            using Difference = typename std::iterator_traits<Iterator>::difference_type;
+            if (k == 0) {
+                return;
+            }
+
+            const RowOrder<Iterator, Compare> order{first, &comp};
+            auto i = begin;
+            for (; i < end && heap.size() < k; ++i) {
+                heap.emplace_back(i);
+                std::push_heap(heap.begin(), heap.end(), order);
+            }
+
+            for (; i < end; ++i) {
+                // rows are visited by increasing index, so a row equivalent to the worst selected one never wins
+                if (comp(first[static_cast<Difference>(i)], first[static_cast<Difference>(heap.front())])) {
+                    std::pop_heap(heap.begin(), heap.end(), order);
+                    heap.back() = i;
+                    std::push_heap(heap.begin(), heap.end(), order);
+                }
+            }
+        }
+    }
+
+    /**
+     * Selects the k first rows of a random access range with respect to comp without sorting the range. A heap of k
+     * row indices is maintained, so the columns of a zipped range are never swapped and only k indices are moved.
+     * Equivalent rows are ordered by their position, i.e. the result equals the first k rows of a stable sort.
+     * @code
+     * // ten rows with the highest score
+     * auto best = top_k(zip(score, name), 10, [](const auto &a, const auto &b) {
+     *     return std::get<0>(a) > std::get<0>(b);
+     * });
+     * for (auto [s, n] : best) { ... }
+     * @endcode
+     * @tparam Range random access range type (e.g. impl::ZipView)
+     * @tparam Compare row comparison type
+     * @param range input range. Temporaries are moved into the result
+     * @param k number of rows to select
+     * @param comp strict weak ordering of the rows (default std::less, which selects the k smallest rows)
+     * @return impl::IndexedView over range that contains the min(k, size) first rows in sorted order
+     */
+    template<typename Range, typename Compare = std::less<>>
+    auto top_k(Range &&range, std::size_t k, Compare comp = {}) {
+        auto first = std::begin(range);
+        static_assert(impl::traits::is_random_accessible_v<decltype(first)>, "top_k requires random access ranges");
+        const auto count = static_cast<std::size_t>(impl::distance(first, std::end(range)));
+        std::vector<std::size_t> rows;
+        rows.reserve(std::min(k, count));
+        impl::top_k_heap(first, 0, count, k, comp, rows);
+        std::sort_heap(rows.begin(), rows.end(), impl::RowOrder<decltype(first), Compare>{first, &comp});
+        return indexed(std::forward<Range>(range), std::move(rows));
+    }
+}
+
+#endif //ITERATORTOOLS_ALGORITHMS_HPP
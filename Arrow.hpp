@@ -0,0 +1,382 @@
+/**
+ * @file Arrow.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains zero-copy adapters for the Apache Arrow C Data Interface. Primitive arrays and struct
+ * arrays of primitive children are imported as contiguous column ranges that can be used with zip and enumerate.
+ * Zipped contiguous columns are exported as struct array without copying the column data. The interface structs are
+ * defined here, libarrow is not required.
+ */
+
+#ifndef ITERATORTOOLS_ARROW_HPP
+#define ITERATORTOOLS_ARROW_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Iterators.hpp"
+#include "BitColumn.hpp"
+
+// definitions from the Arrow C Data Interface specification. The guard allows coexistence with arrow/c/abi.h
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+    void (*release)(struct ArrowSchema *);
+    void *private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+    void (*release)(struct ArrowArray *);
+    void *private_data;
+};
+
+#endif //ARROW_C_DATA_INTERFACE
+
+namespace iterators {
+    namespace impl {
+        /**
+         * @tparam T element type
+         * @return Arrow format string of T or nullptr if T has no fixed-width primitive Arrow type
+         */
+        template<typename T>
+        constexpr const char *arrow_format() noexcept {
+            if constexpr (std::is_same_v<T, bool>) {
+                return "b";
+            } else if constexpr (std::is_integral_v<T>) {
+                constexpr bool Signed = std::is_signed_v<T>;
+                switch (sizeof(T)) {
+                    case 1:
+                        return Signed ? "c" : "C";
+                    case 2:
+                        return Signed ? "s" : "S";
+                    case 4:
+                        return Signed ? "i" : "I";
+                    case 8:
+                        return Signed ? "l" : "L";
+                    default:
+                        return nullptr;
+                }
+            } else if constexpr (std::is_same_v<T, float>) {
+                return "f";
+            } else if constexpr (std::is_same_v<T, double>) {
+                return "g";
+            } else {
+                return nullptr;
+            }
+        }
+
+        /**
+         * @brief Non-owning contiguous read-only range over the values of an Arrow array. Can be used as zip column.
+         * @tparam T element type
+         */
+        template<typename T>
+        struct ArrowColumn DERIVE_VIEW_INTERFACE(ArrowColumn<T>) {
+            using value_type = T;
+            using iterator = const T *;
+            using const_iterator = const T *;
+
+            constexpr ArrowColumn() noexcept = default;
+
+            /**
+             * CTor.
+             * @param data first value
+             * @param length number of values
+             */
+            constexpr ArrowColumn(const T *data, std::size_t length) noexcept : first(data), length(length) {}
+
+            constexpr const T *begin() const noexcept {
+                return first;
+            }
+
+            constexpr const T *end() const noexcept {
+                return first + length;
+            }
+
+            /**
+             * @return pointer to the first value
+             */
+            constexpr const T *data() const noexcept {
+                return first;
+            }
+
+            /**
+             * @return number of values
+             */
+            [[nodiscard]] constexpr std::size_t size() const noexcept {
+                return length;
+            }
+
+            /**
+             * Array subscript operator (no bounds are checked)
+             * @param index value index
+             * @return reference to the value
+             */
+            constexpr const T &operator[](std::size_t index) const noexcept {
+                return first[index];
+            }
+
+        private:
+            const T *first = nullptr;
+            std::size_t length = 0;
+        };
+
+        /**
+         * Checks the format of an Arrow array
+         * @param schema schema of the array
+         * @param format expected format string
+         * @throws std::invalid_argument if the formats differ
+         */
+        inline void check_arrow_format(const ArrowSchema &schema, const char *format) {
+            if (schema.format == nullptr || std::strcmp(schema.format, format) != 0) {
+                throw std::invalid_argument(std::string("arrow format '") +
+                                            (schema.format == nullptr ? "" : schema.format) +
+                                            "' does not match the requested type '" + format + "'");
+            }
+        }
+
+        template<typename T>
+        auto arrow_column(const ArrowArray &array, const ArrowSchema &schema, std::int64_t offset,
+                          std::int64_t length) {
+            constexpr auto Format = arrow_format<T>();
+            static_assert(Format != nullptr, "type has no primitive arrow representation");
+            check_arrow_format(schema, Format);
+            if (array.n_buffers != 2) {
+                throw std::invalid_argument("primitive arrow arrays must have 2 buffers");
+            }
+
+            const auto start = static_cast<std::size_t>(array.offset + offset);
+            const auto count = static_cast<std::size_t>(length);
+            if constexpr (std::is_same_v<T, bool>) {
+                return BitSpan<const std::uint8_t>(static_cast<const std::uint8_t *>(array.buffers[1]), count, start);
+            } else {
+                return ArrowColumn<T>(static_cast<const T *>(array.buffers[1]) + start, count);
+            }
+        }
+
+        template<typename ...Ts, std::size_t ...Is>
+        auto arrow_struct_columns(const ArrowArray &array, const ArrowSchema &schema, std::index_sequence<Is...>) {
+            // the offset of the struct array applies to all children
+            return zip(arrow_column<Ts>(*array.children[Is], *schema.children[Is], array.offset, array.length)...);
+        }
+
+        /**
+         * @param it iterator to the first element of an exported column
+         * @param length number of rows
+         * @return Arrow format and data buffer of the column
+         */
+        template<typename Iterator>
+        std::pair<const char *, const void *> arrow_export_column(const Iterator &it, std::int64_t length) {
+            using T = typename std::iterator_traits<Iterator>::value_type;
+            static_assert(traits::is_contiguous_v<Iterator>, "exported columns must be contiguous");
+            static_assert(arrow_format<T>() != nullptr && not std::is_same_v<T, bool>,
+                          "exported columns must have arithmetic value types");
+            return {arrow_format<T>(), length == 0 ? nullptr : static_cast<const void *>(std::addressof(*it))};
+        }
+
+        /**
+         * @brief Memory owned by an exported schema and its children
+         */
+        struct ArrowSchemaHolder {
+            std::vector<std::string> names;
+            std::vector<ArrowSchema> children;
+            std::vector<ArrowSchema *> childPointers;
+        };
+
+        /**
+         * @brief Memory owned by an exported array and its children. owner keeps the exported columns alive
+         */
+        struct ArrowArrayHolder {
+            std::shared_ptr<void> owner;
+            std::array<const void *, 1> buffers{};
+            std::vector<std::array<const void *, 2>> childBuffers;
+            std::vector<ArrowArray> children;
+            std::vector<ArrowArray *> childPointers;
+        };
+
+        // every struct (parent and children) holds its own reference, so that children can be moved out and
+        // released independently of their parent as permitted by the specification
+        inline void release_arrow_schema(ArrowSchema *schema) {
+            for (std::int64_t i = 0; i < schema->n_children; ++i) {
+                if (auto child = schema->children[i]; child->release != nullptr) {
+                    child->release(child);
+                }
+            }
+
+            delete static_cast<std::shared_ptr<ArrowSchemaHolder> *>(schema->private_data);
+            schema->release = nullptr;
+        }
+
+        inline void release_arrow_array(ArrowArray *array) {
+            for (std::int64_t i = 0; i < array->n_children; ++i) {
+                if (auto child = array->children[i]; child->release != nullptr) {
+                    child->release(child);
+                }
+            }
+
+            delete static_cast<std::shared_ptr<ArrowArrayHolder> *>(array->private_data);
+            array->release = nullptr;
+        }
+    }
+
+    /**
+     * Imports a primitive Arrow array as contiguous column without copying. Boolean arrays are imported as
+     * impl::BitSpan. The validity bitmap is not applied, see arrow_validity.
+     * @code
+     * ArrowArray array; ArrowSchema schema; // filled by the producer
+     * auto ids = arrow_column<std::int64_t>(array, schema);
+     * for (auto [i, id] : enumerate(ids)) { ... }
+     * array.release(&array);
+     * @endcode
+     * @tparam T element type (arithmetic type or bool)
+     * @param array array. Must outlive the column and must not be released before the column is no longer used
+     * @param schema schema of the array
+     * @return impl::ArrowColumn<T> over the values or impl::BitSpan<const std::uint8_t> if T is bool
+     * @throws std::invalid_argument if the format of the array does not match T
+     */
+    template<typename T>
+    auto arrow_column(const ArrowArray &array, const ArrowSchema &schema) {
+        return impl::arrow_column<T>(array, schema, 0, array.length);
+    }
+
+    /**
+     * Imports a struct array of primitive children as zipped columns without copying.
+     * @code
+     * for (auto [id, price] : arrow_struct<std::int64_t, double>(array, schema)) { ... }
+     * @endcode
+     * @tparam Ts element types of the children
+     * @param array struct array. Must outlive the result
+     * @param schema schema of the struct array
+     * @return impl::ZipView over the children (see arrow_column)
+     * @throws std::invalid_argument if the array is not a struct array with children of the types Ts
+     */
+    template<typename ...Ts>
+    auto arrow_struct(const ArrowArray &array, const ArrowSchema &schema) {
+        impl::check_arrow_format(schema, "+s");
+        if (array.n_children != static_cast<std::int64_t>(sizeof...(Ts)) || schema.n_children != array.n_children) {
+            throw std::invalid_argument("number of arrow struct children does not match the requested types");
+        }
+
+        return impl::arrow_struct_columns<Ts...>(array, schema, std::index_sequence_for<Ts...>{});
+    }
+
+    /**
+     * @param array Arrow array
+     * @return validity bitmap of the array (1 = valid) or std::nullopt if the array has no nulls
+     */
+    inline auto arrow_validity(const ArrowArray &array) -> std::optional<impl::BitSpan<const std::uint8_t>> {
+        if (array.null_count == 0 || array.n_buffers == 0 || array.buffers[0] == nullptr) {
+            return std::nullopt;
+        }
+
+        return impl::BitSpan<const std::uint8_t>(static_cast<const std::uint8_t *>(array.buffers[0]),
+                                                 static_cast<std::size_t>(array.length),
+                                                 static_cast<std::size_t>(array.offset));
+    }
+
+    /**
+     * Exports zipped contiguous columns as Arrow struct array without copying the column data. The zip view is moved
+     * into the exported array, so columns that were moved into the zip (zip(std::move(a), ...)) are owned by the
+     * export and freed by its release callback. Columns that are referenced by the zip must outlive the exported
+     * array.
+     * @code
+     * ArrowArray array;
+     * ArrowSchema schema;
+     * arrow_export(zip(std::move(ids), std::move(prices)), {"id", "price"}, &array, &schema);
+     * // hand array and schema to the consumer, which calls their release callbacks
+     * @endcode
+     * @tparam ZipRange zip view type whose columns are contiguous with arithmetic value types
+     * @param columns zipped columns
+     * @param names names of the columns
+     * @param array output array
+     * @param schema output schema
+     * @throws std::invalid_argument if the number of names does not match the number of columns
+     * @note No validity bitmaps are exported, all rows are valid
+     */
+    template<typename ZipRange>
+    void arrow_export(ZipRange &&columns, const std::vector<std::string> &names, ArrowArray *array,
+                      ArrowSchema *schema) {
+        using Zip = std::remove_cv_t<std::remove_reference_t<ZipRange>>;
+        auto owner = std::make_shared<Zip>(std::forward<ZipRange>(columns));
+        auto first = std::begin(*owner);
+        const auto length = static_cast<std::int64_t>(impl::distance(first, std::end(*owner)));
+        const auto &iterators = first.getIterators();
+        constexpr auto NumColumns = std::tuple_size_v<std::remove_reference_t<decltype(iterators)>>;
+        if (names.size() != NumColumns) {
+            throw std::invalid_argument("number of names does not match the number of columns");
+        }
+
+        const auto children = std::apply([length](const auto &...it) {
+            return std::array{impl::arrow_export_column(it, length)...};
+        }, iterators);
+
+        auto schemaHolder = std::make_shared<impl::ArrowSchemaHolder>();
+        schemaHolder->names = names;
+        schemaHolder->children.resize(NumColumns);
+        auto arrayHolder = std::make_shared<impl::ArrowArrayHolder>();
+        arrayHolder->owner = std::move(owner);
+        arrayHolder->childBuffers.resize(NumColumns);
+        arrayHolder->children.resize(NumColumns);
+        for (std::size_t c = 0; c < NumColumns; ++c) {
+            arrayHolder->childBuffers[c] = {nullptr, children[c].second};
+            schemaHolder->children[c] = ArrowSchema{children[c].first, schemaHolder->names[c].c_str(), nullptr, 0, 0,
+                                                    nullptr, nullptr, &impl::release_arrow_schema, nullptr};
+            arrayHolder->children[c] = ArrowArray{length, 0, 0, 2, 0, arrayHolder->childBuffers[c].data(), nullptr,
+                                                  nullptr, &impl::release_arrow_array, nullptr};
+            schemaHolder->childPointers.emplace_back(&schemaHolder->children[c]);
+            arrayHolder->childPointers.emplace_back(&arrayHolder->children[c]);
+        }
+
+        // allocate all references before anything is published so that no exception can leak memory afterwards
+        std::vector<std::unique_ptr<std::shared_ptr<impl::ArrowSchemaHolder>>> schemaRefs;
+        std::vector<std::unique_ptr<std::shared_ptr<impl::ArrowArrayHolder>>> arrayRefs;
+        for (std::size_t c = 0; c <= NumColumns; ++c) {
+            schemaRefs.emplace_back(std::make_unique<std::shared_ptr<impl::ArrowSchemaHolder>>(schemaHolder));
+            arrayRefs.emplace_back(std::make_unique<std::shared_ptr<impl::ArrowArrayHolder>>(arrayHolder));
+        }
+
+        for (std::size_t c = 0; c < NumColumns; ++c) {
+            schemaHolder->children[c].private_data = schemaRefs[c].release();
+            arrayHolder->children[c].private_data = arrayRefs[c].release();
+        }
+
+        *schema = ArrowSchema{"+s", nullptr, nullptr, 0, static_cast<std::int64_t>(NumColumns),
+                              schemaHolder->childPointers.data(), nullptr, &impl::release_arrow_schema,
+                              schemaRefs.back().release()};
+        *array = ArrowArray{length, 0, 0, 1, static_cast<std::int64_t>(NumColumns), arrayHolder->buffers.data(),
+                            arrayHolder->childPointers.data(), nullptr, &impl::release_arrow_array,
+                            arrayRefs.back().release()};
+    }
+}
+
+#endif //ITERATORTOOLS_ARROW_HPP
@@ -0,0 +1,640 @@
+/**
+ * @file BitColumn.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains word-level access to bit columns (std::vector<bool> and external bitmaps). bit_span
+ * exposes packed bits as random access range that can be used as zip column. count_set, find_set, apply_mask and
+ * for_each_set process 64 bits at a time using popcount and count-trailing-zeros and skip zero words entirely.
+ * @note Word access to std::vector<bool> requires libstdc++. With other standard libraries, the algorithms fall back
+ * to per-bit iteration for std::vector<bool>.
+ */
+
+#ifndef ITERATORTOOLS_BITCOLUMN_HPP
+#define ITERATORTOOLS_BITCOLUMN_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "Iterators.hpp"
+
+namespace iterators {
+    namespace impl {
+
+        /**
+         * @param word 64 bit word
+         * @return number of set bits in word
+         */
+        constexpr unsigned popcount(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_popcountll(word));
+#else
+            unsigned count = 0;
+            for (; word != 0; word &= word - 1) {
+                ++count;
+            }
+
+            return count;
+#endif
+        }
+
+        /**
+         * @param word 64 bit word. Must not be 0
+         * @return index of the lowest set bit
+         */
+        constexpr unsigned count_trailing_zeros(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+            unsigned count = 0;
+            for (; (word & 1) == 0; word >>= 1) {
+                ++count;
+            }
+
+            return count;
+#endif
+        }
+
+        /**
+         * @param word 64 bit word. Must not be 0
+         * @return number of zero bits above the highest set bit
+         */
+        constexpr unsigned count_leading_zeros(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_clzll(word));
+#else
+            unsigned count = 0;
+            for (; (word >> 63) == 0; word <<= 1) {
+                ++count;
+            }
+
+            return count;
+#endif
+        }
+
+        /**
+         * @brief Word-wise access to a sequence of packed bits. Logical words are shifted such that bit 0 of logical
+         * word k is bit k * WordBits of the sequence. Bits beyond the end of the sequence are never read or written.
+         * @tparam Word unsigned storage word type, possibly const qualified
+         */
+        template<typename Word>
+        struct BitWords {
+            using WordType = std::remove_const_t<Word>;
+            static_assert(std::is_unsigned_v<WordType> && sizeof(WordType) <= sizeof(std::uint64_t),
+                          "bit storage words must be unsigned and at most 64 bits wide");
+            static constexpr std::size_t WordBits = std::numeric_limits<WordType>::digits;
+
+            /**
+             * @return number of logical words
+             */
+            [[nodiscard]] constexpr std::size_t numWords() const noexcept {
+                return (count + WordBits - 1) / WordBits;
+            }
+
+            /**
+             * @param k logical word index
+             * @return mask of the bits of logical word k that belong to the sequence
+             */
+            [[nodiscard]] constexpr WordType validMask(std::size_t k) const noexcept {
+                auto remaining = count - k * WordBits;
+                return remaining >= WordBits ? ~WordType(0) : static_cast<WordType>((WordType(1) << remaining) - 1);
+            }
+
+            /**
+             * @param k logical word index
+             * @return logical word k. Bits beyond the end of the sequence are 0
+             */
+            [[nodiscard]] constexpr WordType load(std::size_t k) const noexcept {
+                auto mask = validMask(k);
+                auto bit = offset + k * WordBits;
+                auto index = bit / WordBits;
+                auto shift = bit % WordBits;
+                WordType word = words[index] >> shift;
+                if (shift != 0 && (mask >> (WordBits - shift)) != 0) {
+                    word |= static_cast<WordType>(words[index + 1] << (WordBits - shift));
+                }
+
+                return word & mask;
+            }
+
+            /**
+             * Overwrites logical word k. Only bits that belong to the sequence are changed
+             * @param k logical word index
+             * @param value new value
+             */
+            template<typename W = Word, typename = std::enable_if_t<not std::is_const_v<W>>>
+            constexpr void store(std::size_t k, WordType value) const noexcept {
+                auto mask = validMask(k);
+                value &= mask;
+                auto bit = offset + k * WordBits;
+                auto index = bit / WordBits;
+                auto shift = bit % WordBits;
+                words[index] = static_cast<WordType>((words[index] & ~static_cast<WordType>(mask << shift)) |
+                                                     static_cast<WordType>(value << shift));
+                if (shift != 0 && (mask >> (WordBits - shift)) != 0) {
+                    auto high = WordBits - shift;
+                    words[index + 1] = static_cast<WordType>((words[index + 1] & ~(mask >> high)) | (value >> high));
+                }
+            }
+
+            Word *words;
+            std::size_t offset;
+            std::size_t count;
+        };
+
+        /**
+         * Searches the next set bit
+         * @tparam Word storage word type
+         * @param bits bit sequence
+         * @param from first bit position to consider
+         * @return position of the first set bit at or after from, bits.count if there is none
+         */
+        template<typename Word>
+        constexpr std::size_t find_next_set(const BitWords<Word> &bits, std::size_t from) noexcept {
+            constexpr auto WordBits = BitWords<Word>::WordBits;
+            if (from >= bits.count) {
+                return bits.count;
+            }
+
+            auto k = from / WordBits;
+            using WordType = typename BitWords<Word>::WordType;
+            // cast before shifting, narrow words are promoted to int and shifting the negative ~0 is undefined
+            auto word = bits.load(k) & static_cast<WordType>(static_cast<WordType>(~WordType(0)) << (from % WordBits));
+            const auto numWords = bits.numWords();
+            while (word == 0) {
+                if (++k == numWords) {
+                    return bits.count;
+                }
+
+                word = bits.load(k);
+            }
+
+            return k * WordBits + count_trailing_zeros(word);
+        }
+
+        /**
+         * @brief Proxy reference to a single bit
+         * @tparam Word unsigned storage word type
+         */
+        template<typename Word>
+        class BitReference {
+        public:
+            constexpr BitReference(Word *word, Word mask) noexcept : word(word), mask(mask) {}
+
+            /**
+             * @return value of the bit
+             */
+            constexpr operator bool() const noexcept {
+                return (*word & mask) != 0;
+            }
+
+            /**
+             * Sets or clears the bit
+             * @param value new value
+             * @return reference to this
+             */
+            constexpr const BitReference &operator=(bool value) const noexcept {
+                if (value) {
+                    *word |= mask;
+                } else {
+                    *word &= static_cast<Word>(~mask);
+                }
+
+                return *this;
+            }
+
+            /**
+             * Assigns the value of another bit
+             * @param other bit reference
+             * @return reference to this
+             */
+            constexpr const BitReference &operator=(const BitReference &other) const noexcept {
+                return *this = static_cast<bool>(other);
+            }
+
+            constexpr BitReference(const BitReference &) noexcept = default;
+
+        private:
+            Word *word;
+            Word mask;
+        };
+
+        namespace traits {
+            template<typename Word>
+            struct element_value<BitReference<Word>> {
+                using type = bool;
+            };
+        }
+
+        /**
+         * @brief Random access iterator over packed bits. Dereferencing yields a BitReference, or bool if Word is const
+         * @tparam Word unsigned storage word type, possibly const qualified
+         */
+        template<typename Word>
+        class BitIterator : public SynthesizedOperators<BitIterator<Word>> {
+            using WordType = std::remove_const_t<Word>;
+            static constexpr std::ptrdiff_t WordBits = std::numeric_limits<WordType>::digits;
+        public:
+            using value_type = bool;
+            using reference = std::conditional_t<std::is_const_v<Word>, bool, BitReference<WordType>>;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::random_access_iterator_tag;
+
+            using SynthesizedOperators<BitIterator>::operator++;
+            using SynthesizedOperators<BitIterator>::operator--;
+
+            constexpr BitIterator() noexcept = default;
+
+            /**
+             * CTor.
+             * @param words storage words
+             * @param bit bit position relative to the first storage word
+             */
+            constexpr BitIterator(Word *words, std::ptrdiff_t bit) noexcept : words(words), bit(bit) {}
+
+            /**
+             * Conversion to an iterator over const words
+             */
+            template<typename W = Word, typename = std::enable_if_t<not std::is_const_v<W>>>
+            constexpr operator BitIterator<const W>() const noexcept {
+                return BitIterator<const W>(words, bit);
+            }
+
+            constexpr reference operator*() const noexcept {
+                auto word = words + bit / WordBits;
+                auto mask = static_cast<WordType>(WordType(1) << (bit % WordBits));
+                if constexpr (std::is_const_v<Word>) {
+                    return (*word & mask) != 0;
+                } else {
+                    return BitReference<WordType>(word, mask);
+                }
+            }
+
+            constexpr BitIterator &operator++() noexcept {
+                ++bit;
+                return *this;
+            }
+
+            constexpr BitIterator &operator--() noexcept {
+                --bit;
+                return *this;
+            }
+
+            constexpr BitIterator &operator+=(difference_type n) noexcept {
+                bit += n;
+                return *this;
+            }
+
+            constexpr BitIterator &operator-=(difference_type n) noexcept {
+                bit -= n;
+                return *this;
+            }
+
+            constexpr difference_type operator-(const BitIterator &other) const noexcept {
+                return bit - other.bit;
+            }
+
+            constexpr bool operator==(const BitIterator &other) const noexcept {
+                return bit == other.bit;
+            }
+
+            constexpr bool operator<(const BitIterator &other) const noexcept {
+                return bit < other.bit;
+            }
+
+            constexpr bool operator>(const BitIterator &other) const noexcept {
+                return bit > other.bit;
+            }
+
+        private:
+            Word *words = nullptr;
+            std::ptrdiff_t bit = 0;
+        };
+
+        /**
+         * @brief Non-owning random access range over packed bits. Can be used as zip column. Bits are stored LSB
+         * first in the storage words.
+         * @tparam Word unsigned storage word type. Use a const type for read-only access
+         */
+        template<typename Word>
+        struct BitSpan DERIVE_VIEW_INTERFACE(BitSpan<Word>) {
+            using value_type = bool;
+            using iterator = BitIterator<Word>;
+            using const_iterator = BitIterator<const std::remove_const_t<Word>>;
+
+            constexpr BitSpan() noexcept = default;
+
+            /**
+             * CTor.
+             * @param words storage words
+             * @param count number of bits
+             * @param offset position of the first bit in the first storage word
+             */
+            constexpr BitSpan(Word *words, std::size_t count, std::size_t offset = 0) noexcept :
+                    words(words), offset(offset), count(count) {}
+
+            constexpr iterator begin() const noexcept {
+                return iterator(words, static_cast<std::ptrdiff_t>(offset));
+            }
+
+            constexpr iterator end() const noexcept {
+                return iterator(words, static_cast<std::ptrdiff_t>(offset + count));
+            }
+
+            /**
+             * @return number of bits
+             */
+            [[nodiscard]] constexpr std::size_t size() const noexcept {
+                return count;
+            }
+
+            /**
+             * Array subscript operator (no bounds are checked)
+             * @param index bit index
+             * @return reference to the bit
+             */
+            constexpr auto operator[](std::size_t index) const noexcept {
+                return begin()[static_cast<std::ptrdiff_t>(index)];
+            }
+
+            /**
+             * @return word-wise access to the bits
+             */
+            constexpr BitWords<Word> bitWords() const noexcept {
+                return {words, offset, count};
+            }
+
+        private:
+            Word *words = nullptr;
+            std::size_t offset = 0;
+            std::size_t count = 0;
+        };
+
+        template<typename Word>
+        constexpr BitWords<Word> bit_words(const BitSpan<Word> &span) noexcept {
+            return span.bitWords();
+        }
+
+#ifdef __GLIBCXX__
+        inline BitWords<std::_Bit_type> bit_words(std::vector<bool> &bits) noexcept {
+            auto first = bits.begin();
+            return {first._M_p, first._M_offset, bits.size()};
+        }
+
+        inline BitWords<const std::_Bit_type> bit_words(const std::vector<bool> &bits) noexcept {
+            auto first = bits.begin();
+            return {first._M_p, first._M_offset, bits.size()};
+        }
+#endif
+
+        namespace traits {
+            template<typename T, typename = std::void_t<>>
+            struct has_bit_words : std::false_type {};
+
+            template<typename T>
+            struct has_bit_words<T, std::void_t<decltype(bit_words(std::declval<T &>()))>> : std::true_type {};
+
+            /**
+             * true if T provides word-wise access to its bits
+             */
+            template<typename T>
+            constexpr inline bool has_bit_words_v = has_bit_words<std::remove_reference_t<T>>::value;
+
+            template<typename T, typename = std::void_t<>>
+            struct has_mutable_bit_words : std::false_type {};
+
+            template<typename T>
+            struct has_mutable_bit_words<T, std::void_t<decltype(bit_words(std::declval<T &>()).store(0, 0))>>
+                    : std::true_type {};
+
+            /**
+             * true if the bits of T can be overwritten word-wise
+             */
+            template<typename T>
+            constexpr inline bool has_mutable_bit_words_v = has_mutable_bit_words<std::remove_reference_t<T>>::value;
+
+            template<typename T>
+            using bit_word_t = typename decltype(bit_words(std::declval<T &>()))::WordType;
+
+            template<typename A, typename B, typename = std::void_t<>>
+            struct has_same_bit_words : std::false_type {};
+
+            template<typename A, typename B>
+            struct has_same_bit_words<A, B, std::void_t<bit_word_t<A>, bit_word_t<B>>>
+                    : std::is_same<bit_word_t<A>, bit_word_t<B>> {};
+
+            /**
+             * true if A and B provide word-wise access to their bits with the same word type, i.e. word k of A and
+             * word k of B cover the same bit positions
+             */
+            template<typename A, typename B>
+            constexpr inline bool has_same_bit_words_v =
+                    has_same_bit_words<std::remove_reference_t<A>, std::remove_reference_t<B>>::value;
+        }
+    }
+
+    /**
+     * Creates a random access range over packed bits in external storage (e.g. a validity bitmap). Bits are
+     * expected LSB first.
+     * @tparam Word unsigned storage word type. Use a const type for read-only access
+     * @param words storage words
+     * @param count number of bits
+     * @param offset position of the first bit in the first storage word
+     * @return impl::BitSpan over the bits
+     * @relatesalso impl::BitSpan
+     */
+    template<typename Word>
+    constexpr auto bit_span(Word *words, std::size_t count, std::size_t offset = 0) noexcept -> impl::BitSpan<Word> {
+        return impl::BitSpan<Word>(words, count, offset);
+    }
+
+#ifdef __GLIBCXX__
+    /**
+     * Creates a random access range over the bits of a std::vector<bool> with word-wise access
+     * @param bits bit vector
+     * @return impl::BitSpan over the bits
+     * @relatesalso impl::BitSpan
+     */
+    inline auto bit_span(std::vector<bool> &bits) noexcept -> impl::BitSpan<std::_Bit_type> {
+        auto words = impl::bit_words(bits);
+        return impl::BitSpan<std::_Bit_type>(words.words, words.count, words.offset);
+    }
+
+    /**
+     * @copydoc bit_span(std::vector<bool> &)
+     */
+    inline auto bit_span(const std::vector<bool> &bits) noexcept -> impl::BitSpan<const std::_Bit_type> {
+        auto words = impl::bit_words(bits);
+        return impl::BitSpan<const std::_Bit_type>(words.words, words.count, words.offset);
+    }
+#endif
+
+    /**
+     * Counts the set bits in a bit column
+     * @tparam Bits bit column type (impl::BitSpan, std::vector<bool> or any range of bool)
+     * @param bits bit column
+     * @return number of set bits
+     */
+    template<typename Bits>
+    std::size_t count_set(const Bits &bits) {
+        if constexpr (impl::traits::has_bit_words_v<const Bits>) {
+            auto words = impl::bit_words(bits);
+            std::size_t count = 0;
+            for (std::size_t k = 0; k < words.numWords(); ++k) {
+                count += impl::popcount(words.load(k));
+            }
+
+            return count;
+        } else {
+            return static_cast<std::size_t>(std::count(std::begin(bits), std::end(bits), true));
+        }
+    }
+
+    /**
+     * Searches the next set bit in a bit column. Zero words are skipped entirely
+     * @tparam Bits bit column type (impl::BitSpan, std::vector<bool> or any range of bool)
+     * @param bits bit column
+     * @param from first position to consider
+     * @return position of the first set bit at or after from, the number of bits if there is none
+     */
+    template<typename Bits>
+    std::size_t find_set(const Bits &bits, std::size_t from = 0) {
+        if constexpr (impl::traits::has_bit_words_v<const Bits>) {
+            return impl::find_next_set(impl::bit_words(bits), from);
+        } else {
+            std::size_t position = 0;
+            for (auto it = std::begin(bits); it != std::end(bits); ++it, ++position) {
+                if (position >= from && static_cast<bool>(*it)) {
+                    return position;
+                }
+            }
+
+            return position;
+        }
+    }
+
+    /**
+     * Overwrites all rows of a column whose mask bit is not set with the given fill value. If the column is a bit
+     * column with the same word type as the mask, a whole word of rows is processed at once. Otherwise, if the column
+     * is random access, only rows with cleared mask bits are visited.
+     * @tparam Mask bit column type (impl::BitSpan, std::vector<bool> or any range of bool)
+     * @tparam Range random access range type
+     * @tparam T fill value type
+     * @param mask row mask
+     * @param range column to mask. Only the first min(size(mask), size(range)) rows are processed
+     * @param fill value assigned to masked out rows
+     */
+    template<typename Mask, typename Range, typename T>
+    void apply_mask(const Mask &mask, Range &&range, const T &fill) {
+        auto rows = std::min<std::size_t>(std::size(mask), std::size(range));
+        if constexpr (impl::traits::has_same_bit_words_v<const Mask, Range> &&
+                      impl::traits::has_mutable_bit_words_v<Range> && std::is_convertible_v<T, bool>) {
+            auto maskWords = impl::bit_words(mask);
+            auto targetWords = impl::bit_words(range);
+            maskWords.count = targetWords.count = rows;
+            using Word = typename decltype(targetWords)::WordType;
+            const Word fillWord = static_cast<bool>(fill) ? ~Word(0) : Word(0);
+            for (std::size_t k = 0; k < targetWords.numWords(); ++k) {
+                auto keep = static_cast<Word>(maskWords.load(k));
+                if (keep != targetWords.validMask(k)) {
+                    targetWords.store(k, static_cast<Word>((targetWords.load(k) & keep) | (fillWord & ~keep)));
+                }
+            }
+        } else if constexpr (impl::traits::has_bit_words_v<const Mask> &&
+                             impl::traits::is_random_accessible_v<decltype(std::begin(range))>) {
+            auto maskWords = impl::bit_words(mask);
+            maskWords.count = rows;
+            constexpr auto WordBits = decltype(maskWords)::WordBits;
+            auto first = std::begin(range);
+            for (std::size_t k = 0; k < maskWords.numWords(); ++k) {
+                auto cleared = static_cast<std::uint64_t>(~maskWords.load(k) & maskWords.validMask(k));
+                for (; cleared != 0; cleared &= cleared - 1) {
+                    first[static_cast<std::ptrdiff_t>(k * WordBits + impl::count_trailing_zeros(cleared))] = fill;
+                }
+            }
+        } else {
+            auto first = std::begin(range);
+            auto bit = std::begin(mask);
+            for (std::size_t i = 0; i < rows; ++i, ++bit, ++first) {
+                if (not static_cast<bool>(*bit)) {
+                    *first = fill;
+                }
+            }
+        }
+    }
+
+    /**
+     * Invokes a function for every row of a range whose mask bit is set. Zero mask words are skipped entirely. Can
+     * be used with zipped ranges in which case the function receives the tuple of references for each selected row.
+     * @tparam Mask bit column type (impl::BitSpan, std::vector<bool> or any range of bool)
+     * @tparam Range range type (e.g. impl::ZipView). Should be random access for best performance
+     * @tparam Function function type
+     * @param mask row mask
+     * @param range rows
+     * @param function function that is called with the row element
+     * @return the function
+     */
+    template<typename Mask, typename Range, typename Function>
+    Function for_each_set(const Mask &mask, Range &&range, Function function) {
+        auto current = std::begin(range);
+        auto last = std::end(range);
+        constexpr bool RandomAccess = impl::traits::is_random_accessible_v<decltype(current)>;
+        std::size_t rows = std::size(mask);
+        if constexpr (RandomAccess) {
+            rows = std::min(rows, static_cast<std::size_t>(impl::distance(current, last)));
+        }
+
+        std::size_t position = 0;
+        // moves current to the given row, returns false if the range ends before
+        auto seek = [&](std::size_t row) {
+            if constexpr (RandomAccess) {
+                current += static_cast<std::ptrdiff_t>(row - position);
+            } else {
+                for (; position < row && current != last; ++position) {
+                    ++current;
+                }
+
+                if (current == last) {
+                    return false;
+                }
+            }
+
+            position = row;
+            return true;
+        };
+
+        if constexpr (impl::traits::has_bit_words_v<const Mask>) {
+            auto words = impl::bit_words(mask);
+            words.count = rows;
+            constexpr auto WordBits = decltype(words)::WordBits;
+            for (std::size_t k = 0; k < words.numWords(); ++k) {
+                for (auto word = static_cast<std::uint64_t>(words.load(k)); word != 0; word &= word - 1) {
+                    if (not seek(k * WordBits + impl::count_trailing_zeros(word))) {
+                        return function;
+                    }
+
+                    function(*current);
+                }
+            }
+        } else {
+            auto bit = std::begin(mask);
+            for (std::size_t row = 0; row < rows; ++row, ++bit) {
+                if (static_cast<bool>(*bit)) {
+                    if (not seek(row)) {
+                        return function;
+                    }
+
+                    function(*current);
+                }
+            }
+        }
+
+        return function;
+    }
+}
+
+#endif //ITERATORTOOLS_BITCOLUMN_HPP
@@ -0,0 +1,292 @@
+/**
+ * @file Columnar.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains a simple columnar binary file format for zipped ranges. write_columns serializes all
+ * columns of a zipped range in one pass, read_columns maps the file and returns a zip of memory mapped columns.
+ * Requires a POSIX system.
+ * @details File layout (native byte order):
+ * - file header: magic "ITCOLS\0\0", format version (uint32), number of columns (uint32), number of rows (uint64)
+ * - one column header per column: element size (uint64), offset of the column block (uint64)
+ * - column blocks, each one aligned to impl::ColumnAlignment bytes
+ */
+
+#ifndef ITERATORTOOLS_COLUMNAR_HPP
+#define ITERATORTOOLS_COLUMNAR_HPP
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Iterators.hpp"
+#include "MappedColumn.hpp"
+
+namespace iterators {
+    namespace impl {
+        /**
+         * Alignment of column blocks in bytes
+         */
+        constexpr inline std::size_t ColumnAlignment = 64;
+        constexpr inline std::uint32_t ColumnarVersion = 1;
+        constexpr inline std::array<char, 8> ColumnarMagic{'I', 'T', 'C', 'O', 'L', 'S', '\0', '\0'};
+
+        struct ColumnarFileHeader {
+            std::array<char, 8> magic;
+            std::uint32_t version;
+            std::uint32_t columns;
+            std::uint64_t rows;
+        };
+
+        struct ColumnHeader {
+            std::uint64_t elementSize;
+            std::uint64_t offset;
+        };
+
+        constexpr std::size_t align_up(std::size_t value, std::size_t alignment) noexcept {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        /**
+         * @brief Minimal buffered file writer. Small writes are collected in a large buffer, large writes bypass the
+         * buffer and are handed to the kernel directly without any additional copy.
+         */
+        class FileWriter {
+        public:
+            static constexpr std::size_t BufferSize = std::size_t(1) << 20;
+
+            /**
+             * CTor. Creates or truncates the file
+             * @param path path to the file
+             * @throws std::system_error if the file cannot be opened
+             */
+            explicit FileWriter(const std::string &path) :
+                    fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)) {
+                if (fd < 0) {
+                    throw std::system_error(errno, std::generic_category(), "cannot open '" + path + "'");
+                }
+
+                buffer.reserve(BufferSize);
+            }
+
+            FileWriter(const FileWriter &) = delete;
+            FileWriter &operator=(const FileWriter &) = delete;
+
+            ~FileWriter() {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+
+            /**
+             * Appends bytes to the file
+             * @param data source
+             * @param count number of bytes
+             * @throws std::system_error on write errors
+             */
+            void write(const void *data, std::size_t count) {
+                if (count >= BufferSize) {
+                    flush();
+                    writeAll(static_cast<const char *>(data), count);
+                } else {
+                    if (buffer.size() + count > BufferSize) {
+                        flush();
+                    }
+
+                    auto bytes = static_cast<const char *>(data);
+                    buffer.insert(buffer.end(), bytes, bytes + count);
+                }
+
+                written += count;
+            }
+
+            /**
+             * Appends zero bytes until the file position is a multiple of alignment
+             * @param alignment requested alignment
+             */
+            void pad(std::size_t alignment) {
+                static constexpr std::array<char, ColumnAlignment> zeros{};
+                while (written % alignment != 0) {
+                    write(zeros.data(), std::min(alignment - written % alignment, zeros.size()));
+                }
+            }
+
+            /**
+             * @return number of bytes written so far
+             */
+            [[nodiscard]] std::size_t position() const noexcept {
+                return written;
+            }
+
+            /**
+             * Writes all buffered bytes and closes the file
+             * @throws std::system_error on write errors
+             */
+            void close() {
+                flush();
+                auto result = ::close(fd);
+                fd = -1;
+                if (result != 0) {
+                    throw std::system_error(errno, std::generic_category(), "cannot close columnar file");
+                }
+            }
+
+        private:
+            void flush() {
+                writeAll(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+
+            void writeAll(const char *data, std::size_t count) {
+                while (count > 0) {
+                    auto result = ::write(fd, data, count);
+                    if (result < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+
+                        throw std::system_error(errno, std::generic_category(), "cannot write columnar file");
+                    }
+
+                    data += result;
+                    count -= static_cast<std::size_t>(result);
+                }
+            }
+
+            int fd;
+            std::size_t written = 0;
+            std::vector<char> buffer;
+        };
+
+        template<typename Iterator>
+        using column_value_t = typename std::iterator_traits<Iterator>::value_type;
+
+        template<typename Iterator>
+        void write_column(FileWriter &writer, Iterator it, std::size_t rows) {
+            using Value = column_value_t<Iterator>;
+            if constexpr (traits::is_contiguous_v<Iterator>) {
+                if (rows != 0) {
+                    writer.write(std::addressof(*it), rows * sizeof(Value));
+                }
+            } else {
+                for (std::size_t i = 0; i < rows; ++i, ++it) {
+                    Value value = *it;
+                    writer.write(std::addressof(value), sizeof(Value));
+                }
+            }
+        }
+
+        template<typename Iterators, std::size_t ...Idx>
+        void write_columns_impl(const std::string &path, const Iterators &begin, std::size_t rows,
+                                std::index_sequence<Idx...>) {
+            static_assert((std::is_trivially_copyable_v<column_value_t<std::tuple_element_t<Idx, Iterators>>> && ...),
+                          "columnar files can only contain trivially copyable types");
+            constexpr std::size_t NumColumns = sizeof...(Idx);
+            constexpr std::array<std::size_t, NumColumns> ElementSizes{
+                    sizeof(column_value_t<std::tuple_element_t<Idx, Iterators>>)...};
+            ColumnarFileHeader header{ColumnarMagic, ColumnarVersion, static_cast<std::uint32_t>(NumColumns),
+                                      static_cast<std::uint64_t>(rows)};
+            std::array<ColumnHeader, NumColumns> columnHeaders{};
+            auto offset = align_up(sizeof(ColumnarFileHeader) + sizeof(ColumnHeader) * NumColumns, ColumnAlignment);
+            for (std::size_t i = 0; i < NumColumns; ++i) {
+                columnHeaders[i] = ColumnHeader{ElementSizes[i], offset};
+                offset = align_up(offset + ElementSizes[i] * rows, ColumnAlignment);
+            }
+
+            FileWriter writer(path);
+            writer.write(&header, sizeof(header));
+            writer.write(columnHeaders.data(), sizeof(ColumnHeader) * NumColumns);
+            ((writer.pad(ColumnAlignment), write_column(writer, std::get<Idx>(begin), rows)), ...);
+            writer.close();
+        }
+
+        template<typename T>
+        auto read_column(const std::shared_ptr<const FileMapping> &mapping, const ColumnHeader &header,
+                         std::size_t rows, std::size_t index) -> MappedColumn<T> {
+            if (header.elementSize != sizeof(T) || header.offset % alignof(T) != 0) {
+                throw std::runtime_error("column " + std::to_string(index) + " does not match the requested type");
+            }
+
+            if (header.offset > mapping->size() || rows > (mapping->size() - header.offset) / sizeof(T)) {
+                throw std::runtime_error("column " + std::to_string(index) + " exceeds the file, file is truncated");
+            }
+
+            return MappedColumn<T>(mapping, static_cast<std::size_t>(header.offset), rows);
+        }
+
+        template<typename ...Ts, std::size_t ...Idx>
+        auto read_columns_impl(const std::string &path, Advice advice, std::index_sequence<Idx...>) {
+            auto mapping = std::make_shared<const FileMapping>(path, (not std::is_const_v<Ts> || ...));
+            ColumnarFileHeader header{};
+            if (mapping->size() < sizeof(header)) {
+                throw std::runtime_error("'" + path + "' is not a columnar file");
+            }
+
+            std::memcpy(&header, mapping->data(), sizeof(header));
+            if (header.magic != ColumnarMagic || header.version != ColumnarVersion) {
+                throw std::runtime_error("'" + path + "' is not a columnar file");
+            }
+
+            if (header.columns != sizeof...(Ts) ||
+                mapping->size() < sizeof(header) + sizeof(ColumnHeader) * sizeof...(Ts)) {
+                throw std::runtime_error("number of columns in '" + path + "' does not match the requested types");
+            }
+
+            std::array<ColumnHeader, sizeof...(Ts)> columnHeaders{};
+            std::memcpy(columnHeaders.data(), static_cast<const char *>(mapping->data()) + sizeof(header),
+                        sizeof(ColumnHeader) * sizeof...(Ts));
+            auto rows = static_cast<std::size_t>(header.rows);
+            auto view = zip(read_column<Ts>(mapping, columnHeaders[Idx], rows, Idx)...);
+            mapping->advise(advice, 0, mapping->size());
+            return view;
+        }
+    }
+
+    /**
+     * Writes all columns of a zipped range into a columnar file in one pass. Contiguous columns (e.g. std::vector)
+     * are written directly from their storage without intermediate copies. Other columns are copied element-wise
+     * into a write buffer.
+     * @tparam ZipRange type of zipped range (e.g. impl::ZipView)
+     * @param path path to the file, existing files are overwritten
+     * @param zipRange zipped range whose columns contain trivially copyable types. The number of rows is determined
+     * by the shortest column
+     * @throws std::system_error on I/O errors
+     * @note Columns are stored in native byte order
+     */
+    template<typename ZipRange>
+    void write_columns(const std::string &path, ZipRange &&zipRange) {
+        auto begin = std::begin(zipRange);
+        using Iterators = std::remove_const_t<std::remove_reference_t<decltype(begin.getIterators())>>;
+        auto rows = static_cast<std::size_t>(impl::distance(begin, std::end(zipRange)));
+        impl::write_columns_impl(path, begin.getIterators(), rows,
+                                 std::make_index_sequence<std::tuple_size_v<Iterators>>());
+    }
+
+    /**
+     * Maps a columnar file written by write_columns. The columns are not copied, elements are accessed directly in
+     * the mapped file.
+     * @tparam Ts column types. Must match the element sizes of the columns in the file. If all types are const, the
+     * file is mapped read-only. Otherwise, changes are written back to the file
+     * @param path path to the columnar file
+     * @param advice optional access pattern hints for the entire file
+     * @return impl::ZipView of impl::MappedColumn
+     * @throws std::system_error if the file cannot be mapped
+     * @throws std::runtime_error if the file is not a columnar file, is truncated or the columns do not match the
+     * requested types
+     */
+    template<typename ...Ts>
+    auto read_columns(const std::string &path, Advice advice = Advice::Normal) {
+        static_assert(sizeof...(Ts) > 0, "at least one column type is required");
+        return impl::read_columns_impl<Ts...>(path, advice, std::index_sequence_for<Ts...>());
+    }
+}
+
+#endif //ITERATORTOOLS_COLUMNAR_HPP
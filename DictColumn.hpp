@@ -0,0 +1,562 @@
+/**
+ * @file DictColumn.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains dictionary encoded string columns. Every distinct string is stored once in a contiguous
+ * character buffer, rows only store integer codes. As zip column, a dictionary column yields proxies that convert
+ * to std::string_view. Sorting and permuting rows moves codes instead of heap allocated strings, equality filters
+ * and grouping can run directly on the codes.
+ */
+
+#ifndef ITERATORTOOLS_DICTCOLUMN_HPP
+#define ITERATORTOOLS_DICTCOLUMN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Iterators.hpp"
+
+namespace iterators {
+    namespace impl {
+        /**
+         * @brief Set of distinct strings stored back to back in one contiguous character buffer. Each string is
+         * identified by its code, the position at which it was inserted.
+         */
+        class StringDictionary {
+        public:
+            StringDictionary() = default;
+
+            StringDictionary(const StringDictionary &other) : chars(other.chars), offsets(other.offsets) {
+                reindex();
+            }
+
+            StringDictionary &operator=(const StringDictionary &other) {
+                if (this != &other) {
+                    chars = other.chars;
+                    offsets = other.offsets;
+                    reindex();
+                }
+
+                return *this;
+            }
+
+            StringDictionary(StringDictionary &&) noexcept = default;
+            StringDictionary &operator=(StringDictionary &&) noexcept = default;
+
+            /**
+             * @return number of distinct strings
+             */
+            [[nodiscard]] std::size_t size() const noexcept {
+                return offsets.size() - 1;
+            }
+
+            /**
+             * @param code string code (no bounds are checked)
+             * @return string with the given code
+             */
+            [[nodiscard]] std::string_view operator[](std::size_t code) const noexcept {
+                return {chars.data() + offsets[code], offsets[code + 1] - offsets[code]};
+            }
+
+            /**
+             * Searches a string
+             * @param value string
+             * @return code of the string or std::nullopt if it is not in the dictionary
+             */
+            [[nodiscard]] std::optional<std::size_t> find(std::string_view value) const {
+                if (auto pos = index.find(value); pos != index.end()) {
+                    return pos->second;
+                }
+
+                return std::nullopt;
+            }
+
+            /**
+             * Inserts a string if it is not yet in the dictionary
+             * @param value string
+             * @return code of the string
+             */
+            std::size_t insert(std::string_view value) {
+                if (auto pos = index.find(value); pos != index.end()) {
+                    return pos->second;
+                }
+
+                // the index refers to the character buffer, so it has to be rebuilt when the buffer moves
+                const auto required = chars.size() + value.size();
+                const bool relocate = required > chars.capacity();
+                if (relocate) {
+                    chars.reserve(std::max(required, 2 * chars.capacity()));
+                }
+
+                chars.insert(chars.end(), value.begin(), value.end());
+                offsets.emplace_back(chars.size());
+                const auto code = size() - 1;
+                if (relocate) {
+                    reindex();
+                } else {
+                    index.emplace((*this)[code], code);
+                }
+
+                return code;
+            }
+
+        private:
+            void reindex() {
+                index.clear();
+                index.reserve(size());
+                for (std::size_t code = 0; code < size(); ++code) {
+                    index.emplace((*this)[code], code);
+                }
+            }
+
+            std::vector<char> chars;
+            std::vector<std::size_t> offsets{0};
+            std::unordered_map<std::string_view, std::size_t> index;
+        };
+
+        /**
+         * @brief Value of a dictionary column row: a code together with its dictionary
+         * @tparam Code integral code type
+         */
+        template<typename Code>
+        struct DictValue {
+            Code code;
+            const StringDictionary *dictionary;
+
+            /**
+             * @return the string
+             */
+            [[nodiscard]] std::string_view view() const noexcept {
+                return (*dictionary)[static_cast<std::size_t>(code)];
+            }
+
+            operator std::string_view() const noexcept {
+                return view();
+            }
+        };
+
+        /**
+         * @brief Proxy reference to a row of a dictionary column. Converts to std::string_view. Assignment copies
+         * codes, so both sides must use the same dictionary.
+         * @tparam Code integral code type. Use a const type for read-only access
+         */
+        template<typename Code>
+        class DictReference {
+            using CodeType = std::remove_const_t<Code>;
+        public:
+            /**
+             * CTor.
+             * @param code pointer to the code of the row
+             * @param dictionary dictionary of the column
+             */
+            constexpr DictReference(Code *code, const StringDictionary *dictionary) noexcept :
+                    element(code), dictionary(dictionary) {}
+
+            constexpr DictReference(const DictReference &) noexcept = default;
+
+            /**
+             * @return code of the row
+             */
+            [[nodiscard]] constexpr CodeType code() const noexcept {
+                return *element;
+            }
+
+            /**
+             * @return the string
+             */
+            [[nodiscard]] std::string_view view() const noexcept {
+                return (*dictionary)[static_cast<std::size_t>(*element)];
+            }
+
+            operator std::string_view() const noexcept {
+                return view();
+            }
+
+            operator DictValue<CodeType>() const noexcept {
+                return {*element, dictionary};
+            }
+
+            /**
+             * Assigns the code of a value
+             * @param value value that uses the same dictionary
+             * @return reference to this
+             */
+            template<typename C = Code, typename = std::enable_if_t<not std::is_const_v<C>>>
+            constexpr const DictReference &operator=(const DictValue<CodeType> &value) const noexcept {
+                *element = value.code;
+                return *this;
+            }
+
+            /**
+             * Assigns the code of another row
+             * @param other reference to a row that uses the same dictionary
+             * @return reference to this
+             */
+            constexpr const DictReference &operator=(const DictReference &other) const noexcept {
+                static_assert(not std::is_const_v<Code>, "cannot assign to a read-only dictionary reference");
+                *element = *other.element;
+                return *this;
+            }
+
+        private:
+            Code *element;
+            const StringDictionary *dictionary;
+        };
+
+        namespace traits {
+            template<typename T>
+            struct is_dict_entry : std::false_type {};
+
+            template<typename Code>
+            struct is_dict_entry<DictValue<Code>> : std::true_type {};
+
+            template<typename Code>
+            struct is_dict_entry<DictReference<Code>> : std::true_type {};
+
+            template<typename Code>
+            struct element_value<DictReference<Code>> {
+                using type = DictValue<std::remove_const_t<Code>>;
+            };
+
+            template<typename L, typename R>
+            constexpr inline bool has_dict_entry_v = is_dict_entry<L>::value || is_dict_entry<R>::value;
+        }
+
+        template<typename T>
+        std::string_view dict_view(const T &value) noexcept {
+            if constexpr (traits::is_dict_entry<T>::value) {
+                return value.view();
+            } else {
+                return std::string_view(value);
+            }
+        }
+
+        template<typename Code>
+        constexpr auto dict_value(const DictValue<Code> &value) noexcept -> DictValue<Code> {
+            return value;
+        }
+
+        template<typename Code>
+        constexpr auto dict_value(const DictReference<Code> &ref) noexcept -> DictValue<std::remove_const_t<Code>> {
+            return ref;
+        }
+
+        template<typename L, typename R>
+        bool dict_equal(const L &lhs, const R &rhs) noexcept {
+            if constexpr (traits::is_dict_entry<L>::value && traits::is_dict_entry<R>::value) {
+                const auto lhsValue = dict_value(lhs);
+                const auto rhsValue = dict_value(rhs);
+                if (lhsValue.dictionary == rhsValue.dictionary) {
+                    return lhsValue.code == rhsValue.code;
+                }
+            }
+
+            return dict_view(lhs) == dict_view(rhs);
+        }
+
+        /**
+         * Equality comparison of dictionary entries with each other and with strings. Entries of the same dictionary
+         * are compared by code
+         */
+        template<typename L, typename R, typename = std::enable_if_t<traits::has_dict_entry_v<L, R>>>
+        bool operator==(const L &lhs, const R &rhs) noexcept {
+            return dict_equal(lhs, rhs);
+        }
+
+        template<typename L, typename R, typename = std::enable_if_t<traits::has_dict_entry_v<L, R>>>
+        bool operator!=(const L &lhs, const R &rhs) noexcept {
+            return not dict_equal(lhs, rhs);
+        }
+
+        /**
+         * Lexicographical comparison of dictionary entries with each other and with strings
+         */
+        template<typename L, typename R, typename = std::enable_if_t<traits::has_dict_entry_v<L, R>>>
+        bool operator<(const L &lhs, const R &rhs) noexcept {
+            return dict_view(lhs) < dict_view(rhs);
+        }
+
+        template<typename L, typename R, typename = std::enable_if_t<traits::has_dict_entry_v<L, R>>>
+        bool operator>(const L &lhs, const R &rhs) noexcept {
+            return dict_view(lhs) > dict_view(rhs);
+        }
+
+        template<typename L, typename R, typename = std::enable_if_t<traits::has_dict_entry_v<L, R>>>
+        bool operator<=(const L &lhs, const R &rhs) noexcept {
+            return dict_view(lhs) <= dict_view(rhs);
+        }
+
+        template<typename L, typename R, typename = std::enable_if_t<traits::has_dict_entry_v<L, R>>>
+        bool operator>=(const L &lhs, const R &rhs) noexcept {
+            return dict_view(lhs) >= dict_view(rhs);
+        }
+
+        /**
+         * @brief Random access iterator over the rows of a dictionary column. Dereferencing yields a DictReference
+         * @tparam Code integral code type. Use a const type for read-only access
+         */
+        template<typename Code>
+        class DictIterator : public SynthesizedOperators<DictIterator<Code>> {
+        public:
+            using value_type = DictValue<std::remove_const_t<Code>>;
+            using reference = DictReference<Code>;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::random_access_iterator_tag;
+
+            using SynthesizedOperators<DictIterator>::operator++;
+            using SynthesizedOperators<DictIterator>::operator--;
+
+            constexpr DictIterator() noexcept = default;
+
+            /**
+             * CTor.
+             * @param code pointer to the code of the current row
+             * @param dictionary dictionary of the column
+             */
+            constexpr DictIterator(Code *code, const StringDictionary *dictionary) noexcept :
+                    code(code), dictionary(dictionary) {}
+
+            /**
+             * Conversion to a read-only iterator
+             */
+            template<typename C = Code, typename = std::enable_if_t<not std::is_const_v<C>>>
+            constexpr operator DictIterator<const C>() const noexcept {
+                return DictIterator<const C>(code, dictionary);
+            }
+
+            constexpr reference operator*() const noexcept {
+                return reference(code, dictionary);
+            }
+
+            constexpr DictIterator &operator++() noexcept {
+                ++code;
+                return *this;
+            }
+
+            constexpr DictIterator &operator--() noexcept {
+                --code;
+                return *this;
+            }
+
+            constexpr DictIterator &operator+=(difference_type n) noexcept {
+                code += n;
+                return *this;
+            }
+
+            constexpr DictIterator &operator-=(difference_type n) noexcept {
+                code -= n;
+                return *this;
+            }
+
+            constexpr difference_type operator-(const DictIterator &other) const noexcept {
+                return code - other.code;
+            }
+
+            constexpr bool operator==(const DictIterator &other) const noexcept {
+                return code == other.code;
+            }
+
+            constexpr bool operator<(const DictIterator &other) const noexcept {
+                return code < other.code;
+            }
+
+            constexpr bool operator>(const DictIterator &other) const noexcept {
+                return code > other.code;
+            }
+
+        private:
+            Code *code = nullptr;
+            const StringDictionary *dictionary = nullptr;
+        };
+
+        /**
+         * @brief Dictionary encoded string column. Stores one integer code per row and the distinct strings in a
+         * shared StringDictionary. Can be used as zip column, in which case it yields DictReference proxies.
+         * @tparam Code unsigned integral code type
+         */
+        template<typename Code>
+        class DictColumn {
+            static_assert(std::is_unsigned_v<Code>, "dictionary codes must be unsigned integers");
+        public:
+            using value_type = DictValue<Code>;
+            using iterator = DictIterator<Code>;
+            using const_iterator = DictIterator<const Code>;
+
+            /**
+             * CTor. Creates an empty column with its own dictionary
+             */
+            DictColumn() : dict(std::make_shared<StringDictionary>()) {}
+
+            /**
+             * CTor. Creates an empty column that shares a dictionary with other columns. Codes of columns with the same
+             * dictionary are directly comparable, e.g. for joins
+             * @param dictionary shared dictionary
+             */
+            explicit DictColumn(std::shared_ptr<StringDictionary> dictionary) : dict(std::move(dictionary)) {}
+
+            iterator begin() noexcept {
+                return iterator(rowCodes.data(), dict.get());
+            }
+
+            iterator end() noexcept {
+                return iterator(rowCodes.data() + rowCodes.size(), dict.get());
+            }
+
+            const_iterator begin() const noexcept {
+                return const_iterator(rowCodes.data(), dict.get());
+            }
+
+            const_iterator end() const noexcept {
+                return const_iterator(rowCodes.data() + rowCodes.size(), dict.get());
+            }
+
+            /**
+             * @return number of rows
+             */
+            [[nodiscard]] std::size_t size() const noexcept {
+                return rowCodes.size();
+            }
+
+            /**
+             * @return true if the column has no rows
+             */
+            [[nodiscard]] bool empty() const noexcept {
+                return rowCodes.empty();
+            }
+
+            /**
+             * Array subscript operator (no bounds are checked)
+             * @param row row index
+             * @return reference to the row
+             */
+            DictReference<Code> operator[](std::size_t row) noexcept {
+                return {rowCodes.data() + row, dict.get()};
+            }
+
+            /**
+             * @copydoc DictColumn::operator[]
+             */
+            DictReference<const Code> operator[](std::size_t row) const noexcept {
+                return {rowCodes.data() + row, dict.get()};
+            }
+
+            /**
+             * Appends a row. The string is added to the dictionary if necessary
+             * @param value string
+             * @throws std::length_error if the number of distinct strings exceeds the range of Code
+             */
+            void push_back(std::string_view value) {
+                rowCodes.push_back(encode(value));
+            }
+
+            /**
+             * Reserves memory for a number of rows
+             * @param capacity number of rows
+             */
+            void reserve(std::size_t capacity) {
+                rowCodes.reserve(capacity);
+            }
+
+            /**
+             * Searches the code of a string, e.g. to filter rows by comparing codes
+             * @param value string
+             * @return code of the string or std::nullopt if no row can contain the string
+             */
+            [[nodiscard]] std::optional<Code> codeOf(std::string_view value) const {
+                if (auto code = dict->find(value); code.has_value()) {
+                    return static_cast<Code>(*code);
+                }
+
+                return std::nullopt;
+            }
+
+            /**
+             * @return codes of all rows. Can be zipped, filtered or bucketized like any integer column
+             */
+            [[nodiscard]] std::vector<Code> &codes() noexcept {
+                return rowCodes;
+            }
+
+            /**
+             * @copydoc DictColumn::codes()
+             */
+            [[nodiscard]] const std::vector<Code> &codes() const noexcept {
+                return rowCodes;
+            }
+
+            /**
+             * @return dictionary of the column. Code c stands for dictionary()[c]
+             */
+            [[nodiscard]] const StringDictionary &dictionary() const noexcept {
+                return *dict;
+            }
+
+            /**
+             * @return shared pointer to the dictionary, e.g. to create another column with the same dictionary
+             */
+            [[nodiscard]] const std::shared_ptr<StringDictionary> &sharedDictionary() const noexcept {
+                return dict;
+            }
+
+        private:
+            Code encode(std::string_view value) {
+                if (auto code = dict->find(value); code.has_value()) {
+                    return static_cast<Code>(*code);
+                }
+
+                // check before inserting, the dictionary may be shared with columns that still have room
+                if (dict->size() > std::numeric_limits<Code>::max()) {
+                    throw std::length_error("dictionary exceeds the range of the code type");
+                }
+
+                return static_cast<Code>(dict->insert(value));
+            }
+
+            std::shared_ptr<StringDictionary> dict;
+            std::vector<Code> rowCodes;
+        };
+    }
+
+    /**
+     * Creates a dictionary encoded column from a range of strings.
+     * @code
+     * auto city = dict_column(cityStrings);
+     * for (auto [id, c] : zip(ids, city)) {
+     *     if (c == "Berlin") { ... }
+     * }
+     * auto berlin = city.codeOf("Berlin"); // compare codes instead of strings
+     * @endcode
+     * @tparam Code unsigned integral code type (default std::uint32_t)
+     * @tparam Range range of elements convertible to std::string_view
+     * @param strings row values
+     * @return impl::DictColumn
+     * @throws std::length_error if the number of distinct strings exceeds the range of Code
+     * @relatesalso impl::DictColumn
+     */
+    template<typename Code = std::uint32_t, typename Range>
+    auto dict_column(const Range &strings) -> impl::DictColumn<Code> {
+        impl::DictColumn<Code> column;
+        if constexpr (impl::traits::has_size_v<Range>) {
+            column.reserve(std::size(strings));
+        }
+
+        for (const auto &value : strings) {
+            column.push_back(std::string_view(value));
+        }
+
+        return column;
+    }
+}
+
+#endif //ITERATORTOOLS_DICTCOLUMN_HPP
@@ -0,0 +1,428 @@
+/**
+ * @file Indexed.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains the indexed view, a zero-copy permuted view of a random access range. The element at
+ * position i is data[indices[i]]. The view can be used as zip column, for example to apply a permutation or the
+ * result of a filter to payload columns. gather materializes an indexed view using hardware gather instructions
+ * where available.
+ */
+
+#ifndef ITERATORTOOLS_INDEXED_HPP
+#define ITERATORTOOLS_INDEXED_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "Iterators.hpp"
+
+namespace iterators {
+    namespace impl {
+
+        /**
+         * @brief Iterator of an indexed view. Dereferencing yields data[*index].
+         * @details @copybrief
+         * The iterator category is the one of the index iterator (at most random access).
+         * @tparam DataIterator random access iterator to the first element of the data range
+         * @tparam IndexIterator iterator over the indices
+         */
+        template<typename DataIterator, typename IndexIterator>
+        class IndexedIterator : public SynthesizedOperators<IndexedIterator<DataIterator, IndexIterator>> {
+            static_assert(traits::is_random_accessible_v<DataIterator>, "indexed data must be random accessible");
+            static constexpr bool RandomAccess = traits::is_random_accessible_v<IndexIterator>;
+        public:
+            using value_type = typename std::iterator_traits<DataIterator>::value_type;
+            using reference = typename std::iterator_traits<DataIterator>::reference;
+            using pointer = typename std::iterator_traits<DataIterator>::pointer;
+            using difference_type = typename std::iterator_traits<IndexIterator>::difference_type;
+            using iterator_category = std::conditional_t<RandomAccess, std::random_access_iterator_tag,
+                    typename std::iterator_traits<IndexIterator>::iterator_category>;
+
+            using SynthesizedOperators<IndexedIterator>::operator++;
+            using SynthesizedOperators<IndexedIterator>::operator--;
+
+            constexpr IndexedIterator() = default;
+
+            /**
+             * CTor.
+             * @param data iterator to the first element of the data range
+             * @param index index iterator
+             */
+            constexpr IndexedIterator(DataIterator data, IndexIterator index) :
+                    data(std::move(data)), index(std::move(index)) {}
+
+            /**
+             * @return reference to the data element referred to by the current index
+             */
+            constexpr reference operator*() const {
+                return data[static_cast<typename std::iterator_traits<DataIterator>::difference_type>(*index)];
+            }
+
+            /**
+             * Advances to the next index
+             * @return reference to this
+             */
+            constexpr IndexedIterator &operator++() {
+                ++index;
+                return *this;
+            }
+
+            /**
+             * Goes back to the previous index. Only available for bidirectional index iterators
+             * @return reference to this
+             */
+            template<bool IsBidirectional = traits::is_bidirectional_v<IndexIterator>>
+            constexpr auto operator--() -> std::enable_if_t<IsBidirectional, IndexedIterator &> {
+                --index;
+                return *this;
+            }
+
+            /**
+             * Compound assignment increment. Only available for random access index iterators
+             * @param n increment
+             * @return reference to this
+             */
+            template<bool IsRandomAccessible = RandomAccess>
+            constexpr auto operator+=(difference_type n) -> std::enable_if_t<IsRandomAccessible, IndexedIterator &> {
+                index += n;
+                return *this;
+            }
+
+            /**
+             * Compound assignment decrement. Only available for random access index iterators
+             * @param n decrement
+             * @return reference to this
+             */
+            template<bool IsRandomAccessible = RandomAccess>
+            constexpr auto operator-=(difference_type n) -> std::enable_if_t<IsRandomAccessible, IndexedIterator &> {
+                index -= n;
+                return *this;
+            }
+
+            /**
+             * Difference of index iterators. Only available for random access index iterators
+             * @param other right hand side
+             * @return number of steps between other and *this
+             */
+            template<bool IsRandomAccessible = RandomAccess>
+            constexpr auto operator-(const IndexedIterator &other) const
+            -> std::enable_if_t<IsRandomAccessible, difference_type> {
+                return index - other.index;
+            }
+
+            /**
+             * Less comparison of index iterators. Only available for random access index iterators
+             * @param other right hand side
+             * @return true if the index iterator compares less than the one from other
+             */
+            template<bool IsRandomAccessible = RandomAccess>
+            constexpr auto operator<(const IndexedIterator &other) const -> std::enable_if_t<IsRandomAccessible, bool> {
+                return index < other.index;
+            }
+
+            /**
+             * Greater comparison of index iterators. Only available for random access index iterators
+             * @param other right hand side
+             * @return true if the index iterator compares greater than the one from other
+             */
+            template<bool IsRandomAccessible = RandomAccess>
+            constexpr auto operator>(const IndexedIterator &other) const -> std::enable_if_t<IsRandomAccessible, bool> {
+                return index > other.index;
+            }
+
+            /**
+             * Equality comparison of index iterators
+             * @param other right hand side
+             * @return true if the index iterators are equal
+             */
+            constexpr bool operator==(const IndexedIterator &other) const {
+                return index == other.index;
+            }
+
+            /**
+             * @return iterator to the first element of the data range
+             */
+            constexpr const DataIterator &dataBegin() const noexcept {
+                return data;
+            }
+
+            /**
+             * @return underlying index iterator
+             */
+            constexpr const IndexIterator &base() const noexcept {
+                return index;
+            }
+
+        private:
+            DataIterator data{};
+            IndexIterator index{};
+        };
+
+        /**
+         * @brief Zero-copy permuted view of a random access range. Ranges are captured by reference, temporaries are
+         * moved into the view.
+         * @tparam Data random access range type
+         * @tparam Indices index range type. Begin and end must have the same type
+         */
+        template<typename Data, typename Indices>
+        struct IndexedView DERIVE_VIEW_INTERFACE(IndexedView<Data, Indices>) {
+        private:
+            template<bool Const, typename Range>
+            using Iterator = decltype(std::begin(std::declval<std::add_lvalue_reference_t<
+                    traits::const_if_t<Const, std::remove_reference_t<Range>>>>()));
+            template<bool Const>
+            using IteratorType = IndexedIterator<Iterator<Const, Data>, Iterator<Const, Indices>>;
+        public:
+            /**
+             * CTor.
+             * @tparam D data range type
+             * @tparam I index range type
+             * @param data data range
+             * @param indices index range
+             */
+            template<typename D, typename I>
+            constexpr IndexedView(D &&data, I &&indices) :
+                    ranges(std::forward<D>(data), std::forward<I>(indices)) {}
+
+            IndexedView() = default;
+
+            /**
+             * @return IndexedIterator to the element referred to by the first index
+             */
+            constexpr auto begin() {
+                return IteratorType<false>(std::begin(std::get<0>(ranges)), std::begin(std::get<1>(ranges)));
+            }
+
+            /**
+             * @return IndexedIterator to the position following the last index
+             */
+            constexpr auto end() {
+                return IteratorType<false>(std::begin(std::get<0>(ranges)), std::end(std::get<1>(ranges)));
+            }
+
+            /**
+             * @copydoc IndexedView::begin()
+             * @note returns an IndexedIterator that does not allow changing the data elements
+             */
+            template<bool C = true>
+            constexpr auto begin() const -> IteratorType<C> {
+                return IteratorType<true>(std::begin(std::get<0>(ranges)), std::begin(std::get<1>(ranges)));
+            }
+
+            /**
+             * @copydoc IndexedView::end()
+             */
+            template<bool C = true>
+            constexpr auto end() const -> IteratorType<C> {
+                return IteratorType<true>(std::begin(std::get<0>(ranges)), std::end(std::get<1>(ranges)));
+            }
+
+            /**
+             * @return the data range
+             */
+            constexpr const std::remove_reference_t<Data> &source() const noexcept {
+                return std::get<0>(ranges);
+            }
+
+            /**
+             * @return the index range
+             */
+            constexpr const std::remove_reference_t<Indices> &positions() const noexcept {
+                return std::get<1>(ranges);
+            }
+
+#ifndef __USE_VIEW_INTERFACE__
+            /**
+             * Returns the number of indices. Only available if the index range knows its size
+             * @tparam HasSize SFINAE guard, do not specify explicitly
+             * @return number of indices
+             */
+            template<bool HasSize = traits::has_size_v<Indices>>
+            constexpr auto size() const -> std::enable_if_t<HasSize, std::size_t> {
+                return std::size(std::get<1>(ranges));
+            }
+#endif
+
+        private:
+            // stored in a tuple (like ZipView) so that views over lvalue references remain assignable
+            std::tuple<Data, Indices> ranges;
+        };
+
+        namespace traits {
+            template<typename T, typename Index>
+            constexpr inline bool has_gather_kernel_v = std::is_arithmetic_v<T> && not std::is_same_v<T, bool> &&
+                                                        (sizeof(T) == 4 || sizeof(T) == 8) &&
+                                                        std::is_integral_v<Index> &&
+                                                        (sizeof(Index) == 4 || sizeof(Index) == 8);
+        }
+
+        /**
+         * Gathers as many elements as possible using hardware gather instructions (AVX2 or AVX-512). Only full
+         * vector blocks are processed
+         * @tparam T element type (4 or 8 bytes)
+         * @tparam Index index type (4 or 8 bytes)
+         * @param table first element of the table
+         * @param indices first index
+         * @param count number of indices
+         * @param out destination
+         * @return number of elements gathered. 0 if no gather instructions are available
+         */
+        template<typename T, typename Index>
+        std::size_t gather_simd(const T *table, const Index *indices, std::size_t count, T *out) noexcept {
+            std::size_t i = 0;
+#if defined(__AVX512F__)
+            // masked gathers with an explicit source, the unmasked intrinsics trigger false uninitialized warnings
+            if constexpr (sizeof(T) == 4 && sizeof(Index) == 4) {
+                const auto zero = _mm512_setzero_si512();
+                for (; i + 16 <= count; i += 16) {
+                    auto idx = _mm512_loadu_si512(indices + i);
+                    _mm512_storeu_si512(out + i, _mm512_mask_i32gather_epi32(zero, 0xFFFF, idx, table, 4));
+                }
+            } else if constexpr (sizeof(T) == 8 && sizeof(Index) == 8) {
+                const auto zero = _mm512_setzero_si512();
+                for (; i + 8 <= count; i += 8) {
+                    auto idx = _mm512_loadu_si512(indices + i);
+                    _mm512_storeu_si512(out + i, _mm512_mask_i64gather_epi64(zero, 0xFF, idx, table, 8));
+                }
+            } else if constexpr (sizeof(T) == 8) {
+                const auto zero = _mm512_setzero_si512();
+                for (; i + 8 <= count; i += 8) {
+                    auto idx = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i));
+                    _mm512_storeu_si512(out + i, _mm512_mask_i32gather_epi64(zero, 0xFF, idx, table, 8));
+                }
+            } else {
+                const auto zero = _mm256_setzero_si256();
+                for (; i + 8 <= count; i += 8) {
+                    auto idx = _mm512_loadu_si512(indices + i);
+                    auto values = _mm512_mask_i64gather_epi32(zero, 0xFF, idx, table, 4);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), values);
+                }
+            }
+#elif defined(__AVX2__)
+            auto table32 = reinterpret_cast<const int *>(table);
+            auto table64 = reinterpret_cast<const long long *>(table);
+            if constexpr (sizeof(T) == 4 && sizeof(Index) == 4) {
+                for (; i + 8 <= count; i += 8) {
+                    auto idx = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_i32gather_epi32(table32, idx, 4));
+                }
+            } else if constexpr (sizeof(T) == 8 && sizeof(Index) == 8) {
+                for (; i + 4 <= count; i += 4) {
+                    auto idx = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_i64gather_epi64(table64, idx, 8));
+                }
+            } else if constexpr (sizeof(T) == 8) {
+                for (; i + 4 <= count; i += 4) {
+                    auto idx = _mm_loadu_si128(reinterpret_cast<const __m128i *>(indices + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_i32gather_epi64(table64, idx, 8));
+                }
+            } else {
+                for (; i + 4 <= count; i += 4) {
+                    auto idx = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm256_i64gather_epi32(table32, idx, 4));
+                }
+            }
+#else
+            (void) table;
+            (void) indices;
+            (void) count;
+            (void) out;
+#endif
+            return i;
+        }
+
+        /**
+         * Gathers table[indices[i]] into out for contiguous inputs. Uses hardware gather instructions for 4 and 8
+         * byte arithmetic types if available and a scalar loop otherwise
+         * @tparam T element type
+         * @tparam Index index type
+         * @param table first element of the table
+         * @param tableSize number of table elements
+         * @param indices first index
+         * @param count number of indices
+         * @param out destination
+         */
+        template<typename T, typename Index>
+        void gather_contiguous(const T *table, std::size_t tableSize, const Index *indices, std::size_t count,
+                               T *out) {
+            std::size_t i = 0;
+            if constexpr (traits::has_gather_kernel_v<T, Index>) {
+                // gather instructions interpret 32 bit indices as signed
+                if (sizeof(Index) == 8 || std::is_signed_v<Index> ||
+                    tableSize <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+                    i = gather_simd(table, indices, count, out);
+                }
+            } else {
+                (void) tableSize;
+            }
+
+            for (; i < count; ++i) {
+                out[i] = table[indices[i]];
+            }
+        }
+    }
+
+    /**
+     * Creates a zero-copy permuted view of a random access range. The element at position i is data[indices[i]].
+     * The view can be used as zip column. No bounds are checked.
+     * @tparam Data random access range type
+     * @tparam Indices range of integral indices
+     * @param data data range. Temporaries are moved into the view
+     * @param indices index range. Temporaries are moved into the view
+     * @return impl::IndexedView over data and indices
+     * @relatesalso impl::IndexedView
+     */
+    template<typename Data, typename Indices>
+    constexpr auto indexed(Data &&data, Indices &&indices) {
+        return impl::IndexedView<Data, Indices>(std::forward<Data>(data), std::forward<Indices>(indices));
+    }
+
+    /**
+     * Copies the elements of an indexed view into an output range. If data, indices and destination are contiguous,
+     * 4 and 8 byte arithmetic elements are gathered in blocks using hardware gather instructions (AVX2 or AVX-512,
+     * depending on the target architecture). Otherwise, the elements are copied one by one.
+     * @tparam Data data range type
+     * @tparam Indices index range type
+     * @tparam OutputIterator output iterator type
+     * @param view indexed view
+     * @param out beginning of the destination range
+     * @return output iterator to the element following the last written element
+     * @relatesalso impl::IndexedView
+     */
+    template<typename Data, typename Indices, typename OutputIterator>
+    OutputIterator gather(const impl::IndexedView<Data, Indices> &view, OutputIterator out) {
+        auto first = view.begin();
+        auto last = view.end();
+        using DataIt = std::remove_cv_t<std::remove_reference_t<decltype(first.dataBegin())>>;
+        using IndexIt = std::remove_cv_t<std::remove_reference_t<decltype(first.base())>>;
+        using T = typename std::iterator_traits<DataIt>::value_type;
+        if constexpr (impl::traits::is_contiguous_v<DataIt> && impl::traits::is_contiguous_v<IndexIt> &&
+                      impl::traits::is_contiguous_v<OutputIterator> &&
+                      std::is_same_v<typename std::iterator_traits<OutputIterator>::value_type, T> &&
+                      std::is_trivially_copyable_v<T>) {
+            auto count = static_cast<std::size_t>(last.base() - first.base());
+            if (count != 0) {
+                impl::gather_contiguous(std::addressof(*first.dataBegin()), std::size(view.source()),
+                                        std::addressof(*first.base()), count, std::addressof(*out));
+            }
+
+            return out + static_cast<typename std::iterator_traits<OutputIterator>::difference_type>(count);
+        } else {
+            for (; first != last; ++first, ++out) {
+                *out = *first;
+            }
+
+            return out;
+        }
+    }
+}
+
+#endif //ITERATORTOOLS_INDEXED_HPP
@@ -10,8 +10,11 @@
 #define ITERATORTOOLS_ITERATORS_HPP
 
 #include <algorithm>
+#include <array>
 #include <iterator>
+#include <limits>
 #include <tuple>
+#include <vector>
 
 #define REFERENCE(TYPE) std::declval<std::add_lvalue_reference_t<TYPE>>()
 
@@ -83,13 +86,13 @@
 #ifndef __STD_RANGES_DISABLED__
 #ifdef __cpp_lib_ranges
 #include <ranges>
-#define DERIVE_VIEW_INTERFACE(CLASS) : std::ranges::view_interface<CLASS>
+#define DERIVE_VIEW_INTERFACE(...) : std::ranges::view_interface<__VA_ARGS__>
 #define __USE_VIEW_INTERFACE__
 #else
-#define DERIVE_VIEW_INTERFACE(CLASS)
+#define DERIVE_VIEW_INTERFACE(...)
 #endif
 #else
-#define DERIVE_VIEW_INTERFACE(CLASS)
+#define DERIVE_VIEW_INTERFACE(...)
 #endif
 
 /**
@@ -102,6 +105,21 @@ namespace iterators {
      * Normally there is no need to use any of its members directly
      */
     namespace impl {
+        namespace traits {
+            /**
+             * @brief Type that holds a copy of an element referred to by T, e.g. the value_type of a zip iterator or
+             * the temporary of a swap. Proxy reference types specialize this trait with the value type they convert to
+             * @tparam T reference type
+             */
+            template<typename T>
+            struct element_value {
+                using type = std::remove_cv_t<std::remove_reference_t<T>>;
+            };
+
+            template<typename T>
+            using element_value_t = typename element_value<T>::type;
+        }
+
         /**
          * @brief Proxy reference type that supports assignment and swap even on const instances.
          * @details @copybrief
@@ -167,7 +185,10 @@ namespace iterators {
 
             template<typename Tuple>
             constexpr auto swap(Tuple &&other) const -> std::enable_if_t<std::is_same_v<Tuple, RefTuple> and Assignable> {
-                auto tmp = std::move(*this);
+                // the temporary has to hold values, a copy of the references would see the first assignment
+                auto tmp = std::apply([](auto &&...elements) {
+                    return std::tuple<traits::element_value_t<Ts>...>(std::move(elements)...);
+                }, static_cast<const std::tuple<Ts...> &>(*this));
                 // move of forwarding reference because we always move, even const ref.
                 moveAssign(*this, std::move(other));
                 moveAssign(other, std::move(tmp));
@@ -254,7 +275,7 @@ namespace iterators {
 
             template<typename ...Ts>
             struct values<std::tuple<Ts...>> {
-                using type = std::tuple<std::remove_const_t<std::remove_reference_t<dereference_t<Ts>>>...>;
+                using type = std::tuple<element_value_t<dereference_t<Ts>>...>;
             };
 
             template<typename T>
@@ -382,6 +403,48 @@ namespace iterators {
             template<template<typename ...> typename Template, typename T>
             constexpr inline bool is_same_template_v = is_same_template<Template,
                     std::remove_const_t<std::remove_reference_t<T>>>::value;
+
+            template<typename T, typename U, typename = std::void_t<>>
+            struct has_difference : std::false_type {};
+
+            template<typename T, typename U>
+            struct has_difference<T, U, std::void_t<decltype(std::declval<T>() - std::declval<U>())>>
+                    : std::true_type {};
+
+            template<typename T, typename U>
+            constexpr inline bool has_difference_v = has_difference<T, U>::value;
+
+            template<typename It, typename Value, bool = std::is_object_v<Value> && !std::is_same_v<Value, bool>>
+            struct is_std_contiguous_iterator : std::false_type {};
+
+            template<typename It, typename Value>
+            struct is_std_contiguous_iterator<It, Value, true> {
+                static constexpr bool value = std::is_same_v<It, typename std::vector<Value>::iterator> ||
+                                              std::is_same_v<It, typename std::vector<Value>::const_iterator> ||
+                                              std::is_same_v<It, typename std::array<Value, 1>::iterator> ||
+                                              std::is_same_v<It, typename std::array<Value, 1>::const_iterator>;
+            };
+
+            /**
+             * @brief Detects iterators whose elements are stored contiguously in memory (pointers and iterators of
+             * std::vector and std::array, in C++20 all std::contiguous_iterators)
+             * @tparam T iterator type
+             */
+            template<typename T, typename = std::void_t<>>
+            struct is_contiguous : std::false_type {};
+
+            template<typename T>
+            struct is_contiguous<T, std::void_t<typename std::iterator_traits<T>::value_type>> {
+                static constexpr bool value = std::is_pointer_v<T> ||
+                        is_std_contiguous_iterator<T, typename std::iterator_traits<T>::value_type>::value
+#ifdef __USE_VIEW_INTERFACE__
+                        || std::contiguous_iterator<T>
+#endif
+                        ;
+            };
+
+            template<typename T>
+            constexpr inline bool is_contiguous_v = is_contiguous<T>::value;
         }
 
 
@@ -1089,6 +1152,121 @@ namespace iterators {
             T start;
             T increment;
         };
+
+        /**
+         * @brief Represents a finite range of integers
+         * @tparam T integral type of number range
+         */
+        template<typename T = std::size_t>
+        struct BoundedCounterRange {
+            static_assert(std::is_integral_v<T>, "bounded counter ranges require an integral type");
+
+            /**
+             * CTor
+             * @param start start of the range
+             * @param stop end of the range (exclusive)
+             * @param increment step size. Must not be 0
+             * @note Depending on the template type T, increment can also be negative. In that case, the range is
+             * empty if stop >= start.
+             */
+            constexpr BoundedCounterRange(T start, T stop, T increment = T(1)) noexcept:
+                start(start), increment(increment), steps(numSteps(start, stop, increment)) {}
+
+            /**
+             * @return CounterIterator representing the beginning of the sequence
+             */
+            [[nodiscard]] constexpr CounterIterator<T> begin() const noexcept {
+                return CounterIterator<T>(start, increment);
+            }
+
+            /**
+             * @return CounterIterator representing the end of the sequence
+             */
+            [[nodiscard]] constexpr CounterIterator<T> end() const noexcept {
+                return CounterIterator<T>(static_cast<T>(start + static_cast<T>(steps) * increment), increment);
+            }
+
+            /**
+             * @return number of elements in the range
+             */
+            [[nodiscard]] constexpr std::size_t size() const noexcept {
+                return steps;
+            }
+
+        private:
+            static constexpr std::size_t numSteps(T start, T stop, T increment) noexcept {
+                if (increment > T(0)) {
+                    return stop > start ? static_cast<std::size_t>((stop - start - 1) / increment) + 1 : 0;
+                }
+
+                return start > stop ? static_cast<std::size_t>((start - stop - 1) / -increment) + 1 : 0;
+            }
+
+            T start;
+            T increment;
+            std::size_t steps;
+        };
+    }
+
+    namespace impl {
+        template<typename Sentinels, typename Iterators, std::size_t ...Idx>
+        constexpr bool columns_measurable(std::index_sequence<Idx...>) noexcept {
+            constexpr bool allMeasurable = ((traits::has_difference_v<std::tuple_element_t<Idx, Sentinels>,
+                    std::tuple_element_t<Idx, Iterators>> ||
+                    std::is_same_v<std::tuple_element_t<Idx, Sentinels>, Unreachable>) && ...);
+            constexpr bool oneBounded = (traits::has_difference_v<std::tuple_element_t<Idx, Sentinels>,
+                    std::tuple_element_t<Idx, Iterators>> || ...);
+            return allMeasurable && oneBounded;
+        }
+
+        template<typename Sentinel, typename Iterator>
+        constexpr std::ptrdiff_t column_distance(const Iterator &first, const Sentinel &last) {
+            if constexpr (std::is_same_v<Sentinel, Unreachable>) {
+                return std::numeric_limits<std::ptrdiff_t>::max();
+            } else {
+                return static_cast<std::ptrdiff_t>(last - first);
+            }
+        }
+
+        template<typename Iterators, typename Sentinels, std::size_t ...Idx>
+        constexpr std::ptrdiff_t zip_distance(const Iterators &first, const Sentinels &last,
+                                              std::index_sequence<Idx...>) {
+            return std::min({column_distance(std::get<Idx>(first), std::get<Idx>(last))...});
+        }
+
+        /**
+         * Number of increments needed to get from first to last. Unlike std::distance, this also works in constant
+         * time for ZipIterators that contain infinite sequences (e.g. from enumerate), as long as all remaining
+         * underlying iterators support random access.
+         * @tparam Iterator iterator type
+         * @tparam Sentinel sentinel type
+         * @param first start of the range
+         * @param last end of the range
+         * @return number of elements in [first, last)
+         */
+        template<typename Iterator, typename Sentinel>
+        constexpr std::ptrdiff_t distance(const Iterator &first, const Sentinel &last) {
+            if constexpr (traits::has_difference_v<Sentinel, Iterator>) {
+                return static_cast<std::ptrdiff_t>(last - first);
+            } else {
+                if constexpr (traits::is_same_template_v<ZipIterator, Iterator> &&
+                              traits::is_same_template_v<ZipIterator, Sentinel>) {
+                    using Its = std::remove_reference_t<decltype(first.getIterators())>;
+                    using Sents = std::remove_reference_t<decltype(last.getIterators())>;
+                    constexpr auto Indices = std::make_index_sequence<std::tuple_size_v<Its>>();
+                    if constexpr (columns_measurable<Sents, Its>(Indices)) {
+                        return zip_distance(first.getIterators(), last.getIterators(), Indices);
+                    }
+                }
+
+                std::ptrdiff_t count = 0;
+                for (auto it = first; it != last; ++it) {
+                    ++count;
+                }
+
+                return count;
+            }
+        }
     }
 
     /**
@@ -1199,6 +1377,21 @@ namespace iterators {
                                         std::forward<Iterable>(iterable)...);
     }
 
+    /**
+     * Creates a finite range of integers [start, stop) with given step size. In contrast to the infinite sequences
+     * used by enumerate, the range has a size and can be split into chunks, e.g. for parallel algorithms.
+     * @tparam T integral type
+     * @param start first value
+     * @param stop end of the range (exclusive)
+     * @param increment step size (default 1). Can be negative for signed types
+     * @return impl::BoundedCounterRange
+     * @relatesalso impl::BoundedCounterRange
+     */
+    template<typename T>
+    constexpr auto counter_range(T start, T stop, T increment = T(1)) noexcept {
+        return impl::BoundedCounterRange<T>(start, stop, increment);
+    }
+
 }
 
 namespace std {
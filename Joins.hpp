@@ -0,0 +1,493 @@
+/**
+ * @file Joins.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains join algorithms for (zipped) ranges. merge_join is a lazy view over the matching row
+ * pairs of two ranges that are sorted by their join keys. hash_join joins unsorted ranges using an open addressing
+ * hash table with cache line sized buckets.
+ */
+
+#ifndef ITERATORTOOLS_JOINS_HPP
+#define ITERATORTOOLS_JOINS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "Iterators.hpp"
+#include "Algorithms.hpp"
+#include "BitColumn.hpp"
+#include "Prefetch.hpp"
+
+namespace iterators {
+    namespace impl {
+        /**
+         * @brief Key functions and comparison of a merge join
+         */
+        template<typename LeftKey, typename RightKey, typename Compare>
+        struct JoinKeys {
+            LeftKey left;
+            RightKey right;
+            Compare comp;
+        };
+
+        /**
+         * @brief Iterator over the matching row pairs of two sorted ranges. For every pair of groups with equal
+         * keys, the cross product of the groups is produced.
+         * @tparam LeftIt iterator type of the left range
+         * @tparam RightIt iterator type of the right range
+         * @tparam Keys JoinKeys type
+         */
+        template<typename LeftIt, typename RightIt, typename Keys>
+        class MergeJoinIterator : public SynthesizedOperators<MergeJoinIterator<LeftIt, RightIt, Keys>> {
+        public:
+            using reference = RefTuple<typename std::iterator_traits<LeftIt>::reference,
+                    typename std::iterator_traits<RightIt>::reference>;
+            using value_type = reference;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            using SynthesizedOperators<MergeJoinIterator>::operator++;
+
+            constexpr MergeJoinIterator() = default;
+
+            /**
+             * CTor. Searches the first match
+             * @param left beginning of the left range
+             * @param leftEnd end of the left range
+             * @param right beginning of the right range
+             * @param rightEnd end of the right range
+             * @param keys key functions and comparison. Must outlive the iterator
+             */
+            MergeJoinIterator(LeftIt left, LeftIt leftEnd, RightIt right, RightIt rightEnd, const Keys &keys) :
+                    leftGroupEnd(std::move(left)), leftEnd(std::move(leftEnd)), rightGroupEnd(std::move(right)),
+                    rightEnd(std::move(rightEnd)), keys(std::addressof(keys)) {
+                nextGroup();
+            }
+
+            /**
+             * @return pair of references to the current left and right row
+             */
+            constexpr reference operator*() const {
+                return reference(*leftCurrent, *rightCurrent);
+            }
+
+            /**
+             * Advances to the next matching pair
+             * @return reference to this
+             */
+            MergeJoinIterator &operator++() {
+                if (++rightCurrent == rightGroupEnd) {
+                    rightCurrent = rightGroupBegin;
+                    if (++leftCurrent == leftGroupEnd) {
+                        nextGroup();
+                    }
+                }
+
+                return *this;
+            }
+
+            /**
+             * Equality comparison
+             * @param other right hand side
+             * @return true if both iterators point to the same pair of rows
+             */
+            constexpr bool operator==(const MergeJoinIterator &other) const {
+                return leftCurrent == other.leftCurrent && rightCurrent == other.rightCurrent;
+            }
+
+        private:
+            void nextGroup() {
+                auto left = leftGroupEnd;
+                auto right = rightGroupEnd;
+                const auto &leftKey = keys->left;
+                const auto &rightKey = keys->right;
+                const auto &comp = keys->comp;
+                while (left != leftEnd && right != rightEnd) {
+                    auto target = rightKey(*right);
+                    left = advance_while(std::move(left), leftEnd,
+                                         [&](auto &&row) { return comp(leftKey(row), target); });
+                    if (left == leftEnd) {
+                        break;
+                    }
+
+                    auto key = leftKey(*left);
+                    if (comp(target, key)) {
+                        right = advance_while(std::move(right), rightEnd,
+                                              [&](auto &&row) { return comp(rightKey(row), key); });
+                        continue;
+                    }
+
+                    leftCurrent = left;
+                    leftGroupEnd = advance_while(std::move(left), leftEnd,
+                                                 [&](auto &&row) { return not comp(key, leftKey(row)); });
+                    rightGroupBegin = right;
+                    rightCurrent = right;
+                    rightGroupEnd = advance_while(std::move(right), rightEnd,
+                                                  [&](auto &&row) { return not comp(target, rightKey(row)); });
+                    return;
+                }
+
+                leftCurrent = leftEnd;
+                leftGroupEnd = leftEnd;
+                rightCurrent = rightEnd;
+                rightGroupEnd = rightEnd;
+            }
+
+            LeftIt leftCurrent{};
+            LeftIt leftGroupEnd{};
+            LeftIt leftEnd{};
+            RightIt rightGroupBegin{};
+            RightIt rightCurrent{};
+            RightIt rightGroupEnd{};
+            RightIt rightEnd{};
+            const Keys *keys = nullptr;
+        };
+
+        /**
+         * @brief Lazy view over the matching row pairs of two ranges that are sorted by their join keys
+         * @tparam Left left range type. Begin and end must have the same type unless the range is random access
+         * @tparam Right right range type. Begin and end must have the same type unless the range is random access
+         * @tparam LeftKey key function type of the left range
+         * @tparam RightKey key function type of the right range
+         * @tparam Compare comparison type
+         */
+        template<typename Left, typename Right, typename LeftKey, typename RightKey, typename Compare>
+        struct MergeJoinView DERIVE_VIEW_INTERFACE(MergeJoinView<Left, Right, LeftKey, RightKey, Compare>) {
+        private:
+            using Keys = JoinKeys<LeftKey, RightKey, Compare>;
+            template<bool Const, typename Range>
+            using Iterator = decltype(std::begin(std::declval<std::add_lvalue_reference_t<
+                    traits::const_if_t<Const, std::remove_reference_t<Range>>>>()));
+            template<bool Const>
+            using JoinIterator = MergeJoinIterator<Iterator<Const, Left>, Iterator<Const, Right>, Keys>;
+        public:
+            /**
+             * CTor.
+             * @tparam L left range type
+             * @tparam R right range type
+             * @param left left range
+             * @param right right range
+             * @param keys key functions and comparison
+             */
+            template<typename L, typename R>
+            constexpr MergeJoinView(L &&left, R &&right, Keys keys) :
+                    ranges(std::forward<L>(left), std::forward<R>(right), std::move(keys)) {}
+
+            MergeJoinView() = default;
+
+            /**
+             * @return MergeJoinIterator to the first matching pair
+             */
+            auto begin() {
+                auto &[left, right, keys] = ranges;
+                return JoinIterator<false>(std::begin(left), common_end(left), std::begin(right), common_end(right),
+                                           keys);
+            }
+
+            /**
+             * @return MergeJoinIterator representing the end of the join
+             */
+            auto end() {
+                auto &[left, right, keys] = ranges;
+                return JoinIterator<false>(common_end(left), common_end(left), common_end(right), common_end(right),
+                                           keys);
+            }
+
+            /**
+             * @copydoc MergeJoinView::begin()
+             */
+            template<bool C = true>
+            auto begin() const -> JoinIterator<C> {
+                auto &[left, right, keys] = ranges;
+                return JoinIterator<true>(std::begin(left), common_end(left), std::begin(right), common_end(right),
+                                          keys);
+            }
+
+            /**
+             * @copydoc MergeJoinView::end()
+             */
+            template<bool C = true>
+            auto end() const -> JoinIterator<C> {
+                auto &[left, right, keys] = ranges;
+                return JoinIterator<true>(common_end(left), common_end(left), common_end(right), common_end(right),
+                                          keys);
+            }
+
+        private:
+            std::tuple<Left, Right, Keys> ranges;
+        };
+    }
+
+    /**
+     * Inner join of two ranges that are sorted by their join keys (e.g. with parallel_zip_sort). Produces the
+     * matching row pairs in one streaming pass. Duplicate keys on both sides yield the cross product of the
+     * corresponding groups. On random access ranges, non-matching runs are skipped by galloping, which makes joins of
+     * very differently sized ranges fast.
+     * @code
+     * for (auto [order, customer] : merge_join(zip(orderCustomerIds, amounts), zip(customerIds, names),
+     *                                          element<0>{}, element<0>{})) {
+     *     auto [id, amount] = order;
+     *     auto [customerId, name] = customer;
+     * }
+     * @endcode
+     * @tparam Left left range type (e.g. impl::ZipView)
+     * @tparam Right right range type (e.g. impl::ZipView)
+     * @tparam LeftKey key function type of the left range
+     * @tparam RightKey key function type of the right range
+     * @tparam Compare comparison type
+     * @param left left range sorted by leftKey. Temporaries are moved into the view
+     * @param right right range sorted by rightKey. Temporaries are moved into the view
+     * @param leftKey function that returns the join key of a left row, e.g. element<0>{} (default: the row itself)
+     * @param rightKey function that returns the join key of a right row (default: the row itself)
+     * @param comp strict weak ordering of the keys that both ranges are sorted by (default std::less)
+     * @return impl::MergeJoinView whose elements are pairs (leftRow, rightRow)
+     * @relatesalso impl::MergeJoinView
+     */
+    template<typename Left, typename Right, typename LeftKey = impl::Identity, typename RightKey = impl::Identity,
+             typename Compare = std::less<>>
+    constexpr auto merge_join(Left &&left, Right &&right, LeftKey leftKey = {}, RightKey rightKey = {},
+                              Compare comp = {}) {
+        using Keys = impl::JoinKeys<LeftKey, RightKey, Compare>;
+        return impl::MergeJoinView<Left, Right, LeftKey, RightKey, Compare>(
+                std::forward<Left>(left), std::forward<Right>(right),
+                Keys{std::move(leftKey), std::move(rightKey), std::move(comp)});
+    }
+
+    namespace impl {
+        /**
+         * Number of rows that are hashed and prefetched together before the hash table is accessed
+         */
+        constexpr inline std::size_t HashJoinBatchSize = 16;
+
+        /**
+         * Finalizer of MurmurHash3. Spreads the bits of weak hashes (e.g. std::hash of integers) over the full word
+         * @param hash hash value
+         * @return mixed hash value
+         */
+        constexpr std::uint64_t mix_hash(std::uint64_t hash) noexcept {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53ull;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+        /**
+         * @brief Default hash function of hash_join. Mixes the result of std::hash
+         */
+        struct JoinHash {
+            template<typename T>
+            std::uint64_t operator()(const T &key) const {
+                return mix_hash(static_cast<std::uint64_t>(std::hash<T>{}(key)));
+            }
+        };
+
+        /**
+         * @brief Bucket of the join hash table. Occupies exactly one cache line and holds up to 8 rows. Each slot
+         * stores a 32 bit tag of the hash (0 marks empty slots) and the row index.
+         */
+        struct alignas(64) JoinBucket {
+            static constexpr std::size_t Slots = 8;
+            std::uint32_t tags[Slots] = {};
+            std::uint32_t rows[Slots] = {};
+
+            /**
+             * @param tag tag to search for
+             * @return mask where bit i is set if slot i has the given tag
+             */
+            unsigned match(std::uint32_t tag) const noexcept {
+#if defined(__SSE2__) || defined(_M_X64)
+                auto needle = _mm_set1_epi32(static_cast<int>(tag));
+                auto low = _mm_cmpeq_epi32(_mm_load_si128(reinterpret_cast<const __m128i *>(tags)), needle);
+                auto high = _mm_cmpeq_epi32(_mm_load_si128(reinterpret_cast<const __m128i *>(tags + 4)), needle);
+                return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(low))) |
+                       static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(high))) << 4;
+#else
+                unsigned mask = 0;
+                for (std::size_t i = 0; i < Slots; ++i) {
+                    mask |= unsigned(tags[i] == tag) << i;
+                }
+
+                return mask;
+#endif
+            }
+        };
+
+        /**
+         * @brief Open addressing hash table of row indices. Collisions are resolved by linear probing over whole
+         * buckets. The table is sized for a load factor of at most 50%.
+         */
+        class JoinHashTable {
+        public:
+            /**
+             * CTor
+             * @param numRows number of rows that will be inserted
+             */
+            explicit JoinHashTable(std::size_t numRows) {
+                std::size_t numBuckets = 1;
+                while (numBuckets * JoinBucket::Slots < 2 * numRows) {
+                    numBuckets *= 2;
+                }
+
+                buckets.resize(numBuckets);
+                mask = numBuckets - 1;
+            }
+
+            /**
+             * Prefetches the first bucket of a hash
+             * @param hash hash value
+             */
+            void prefetch(std::uint64_t hash) const noexcept {
+                prefetch_address(buckets.data() + (hash & mask));
+            }
+
+            /**
+             * Inserts a row
+             * @param hash hash of the row key
+             * @param row row index
+             */
+            void insert(std::uint64_t hash, std::uint32_t row) noexcept {
+                auto tag = tagOf(hash);
+                for (auto index = hash & mask;; index = (index + 1) & mask) {
+                    auto &bucket = buckets[index];
+                    if (auto free = bucket.match(0); free != 0) {
+                        auto slot = count_trailing_zeros(free);
+                        bucket.tags[slot] = tag;
+                        bucket.rows[slot] = row;
+                        return;
+                    }
+                }
+            }
+
+            /**
+             * Invokes onCandidate(row) for every row whose hash tag matches. The caller has to compare the keys
+             * @param hash hash of the searched key
+             * @param onCandidate function that is invoked with candidate row indices
+             */
+            template<typename Function>
+            void find(std::uint64_t hash, Function &&onCandidate) const {
+                auto tag = tagOf(hash);
+                for (auto index = hash & mask;; index = (index + 1) & mask) {
+                    const auto &bucket = buckets[index];
+                    for (auto matches = bucket.match(tag); matches != 0; matches &= matches - 1) {
+                        onCandidate(bucket.rows[count_trailing_zeros(matches)]);
+                    }
+
+                    if (bucket.match(0) != 0) {
+                        return;
+                    }
+                }
+            }
+
+        private:
+            static constexpr std::uint32_t tagOf(std::uint64_t hash) noexcept {
+                return static_cast<std::uint32_t>(hash >> 32) | 1u;
+            }
+
+            std::vector<JoinBucket> buckets;
+            std::size_t mask = 0;
+        };
+    }
+
+    /**
+     * Inner equi-join of two random access ranges. The build side is inserted into an open addressing hash table
+     * with cache line sized buckets. The probe side is processed in batches: the keys of a batch are hashed and
+     * their buckets prefetched before the table is accessed, so that the cache misses of a batch overlap.
+     * @code
+     * auto matches = hash_join(zip(customerIds, names), zip(orderCustomer, amounts), element<0>{}, element<0>{});
+     * for (auto [buildRow, probeRow] : matches) {
+     *     std::cout << names[buildRow] << ": " << amounts[probeRow] << std::endl;
+     * }
+     * @endcode
+     * @tparam Build build range type (e.g. impl::ZipView)
+     * @tparam Probe probe range type (e.g. impl::ZipView)
+     * @tparam BuildKey key function type of the build side
+     * @tparam ProbeKey key function type of the probe side
+     * @tparam Hash hash function type. Must produce equal hashes for equal build and probe keys
+     * @tparam KeyEqual key comparison type
+     * @param build build range. Usually the smaller side. Must have less than 2^32 - 1 rows
+     * @param probe probe range
+     * @param buildKey function that returns the join key of a build row, e.g. element<0>{} (default: the row itself)
+     * @param probeKey function that returns the join key of a probe row (default: the row itself)
+     * @param hash hash function (default: mixed std::hash)
+     * @param equal key comparison (default: std::equal_to)
+     * @return impl::ZipView over two vectors that contain the build and probe row indices of the matching pairs.
+     * Pairs are ordered by probe row
+     * @throws std::length_error if the build side is too large
+     */
+    template<typename Build, typename Probe, typename BuildKey = impl::Identity, typename ProbeKey = impl::Identity,
+             typename Hash = impl::JoinHash, typename KeyEqual = std::equal_to<>>
+    auto hash_join(Build &&build, Probe &&probe, BuildKey buildKey = {}, ProbeKey probeKey = {}, Hash hash = {},
+                   KeyEqual equal = {}) {
+        using BuildIt = decltype(std::begin(build));
+        using ProbeIt = decltype(std::begin(probe));
+        static_assert(impl::traits::is_random_accessible_v<BuildIt> && impl::traits::is_random_accessible_v<ProbeIt>,
+                      "hash_join requires random access ranges");
+        using BuildDifference = typename std::iterator_traits<BuildIt>::difference_type;
+        using ProbeDifference = typename std::iterator_traits<ProbeIt>::difference_type;
+        constexpr auto Batch = impl::HashJoinBatchSize;
+        auto buildFirst = std::begin(build);
+        auto buildCount = static_cast<std::size_t>(impl::distance(buildFirst, std::end(build)));
+        if (buildCount >= std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("hash_join: build side too large");
+        }
+
+        impl::JoinHashTable table(buildCount);
+        std::uint64_t hashes[Batch];
+        for (std::size_t block = 0; block < buildCount; block += Batch) {
+            auto size = std::min(Batch, buildCount - block);
+            for (std::size_t i = 0; i < size; ++i) {
+                hashes[i] = hash(buildKey(buildFirst[static_cast<BuildDifference>(block + i)]));
+                table.prefetch(hashes[i]);
+            }
+
+            for (std::size_t i = 0; i < size; ++i) {
+                table.insert(hashes[i], static_cast<std::uint32_t>(block + i));
+            }
+        }
+
+        auto probeFirst = std::begin(probe);
+        auto probeCount = static_cast<std::size_t>(impl::distance(probeFirst, std::end(probe)));
+        std::vector<std::size_t> buildRows;
+        std::vector<std::size_t> probeRows;
+        for (std::size_t block = 0; block < probeCount; block += Batch) {
+            auto size = std::min(Batch, probeCount - block);
+            for (std::size_t i = 0; i < size; ++i) {
+                hashes[i] = hash(probeKey(probeFirst[static_cast<ProbeDifference>(block + i)]));
+                table.prefetch(hashes[i]);
+            }
+
+            for (std::size_t i = 0; i < size; ++i) {
+                auto probeRow = block + i;
+                auto &&row = probeFirst[static_cast<ProbeDifference>(probeRow)];
+                const auto &key = probeKey(row);
+                table.find(hashes[i], [&](std::uint32_t buildRow) {
+                    if (equal(buildKey(buildFirst[static_cast<BuildDifference>(buildRow)]), key)) {
+                        buildRows.emplace_back(buildRow);
+                        probeRows.emplace_back(probeRow);
+                    }
+                });
+            }
+        }
+
+        return zip(std::move(buildRows), std::move(probeRows));
+    }
+}
+
+#endif //ITERATORTOOLS_JOINS_HPP
@@ -0,0 +1,293 @@
+/**
+ * @file KWayMerge.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains a lazy k-way merge of sorted ranges. The current elements of the sources are organized
+ * in a loser tree (tournament tree), so every produced element costs about log2(k) comparisons. Unlike a binary
+ * heap, the loser tree replays a single path from a leaf to the root and compares each node only once.
+ */
+
+#ifndef ITERATORTOOLS_KWAYMERGE_HPP
+#define ITERATORTOOLS_KWAYMERGE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Iterators.hpp"
+#include "Algorithms.hpp"
+
+namespace iterators {
+    namespace impl {
+        /**
+         * @brief Iterator of a k-way merge. Yields pairs (sourceId, element) in sorted order. Equivalent elements
+         * are produced in the order of their sources, i.e. the merge is stable.
+         * @details @copybrief
+         * The iterator owns the positions of all sources and a loser tree over them. Internal node n (1 <= n < k)
+         * stores the source that lost the match at n, leaf n (k <= n < 2k) corresponds to source n - k. After the
+         * winner is advanced, only the path from its leaf to the root is replayed. Small trivially copyable elements
+         * are cached next to the exhaustion flags so that replaying a path does not touch the sources.
+         * @tparam Iterator iterator type of the sources
+         * @tparam Compare comparison type
+         * @note Copying the iterator copies the positions of all sources (O(k))
+         */
+        template<typename Iterator, typename Compare>
+        class KWayMergeIterator : public SynthesizedOperators<KWayMergeIterator<Iterator, Compare>> {
+            using Value = typename std::iterator_traits<Iterator>::value_type;
+            static constexpr bool CacheHeads = std::is_reference_v<typename std::iterator_traits<Iterator>::reference>
+                                               && std::is_trivially_copyable_v<Value>
+                                               && sizeof(Value) <= 2 * sizeof(void *);
+
+            struct CachedHead {
+                Value value{};
+                bool done = false;
+            };
+
+            struct PlainHead {
+                bool done = false;
+            };
+
+            using Head = std::conditional_t<CacheHeads, CachedHead, PlainHead>;
+        public:
+            /**
+             * @brief Current position and end of a source
+             */
+            struct Cursor {
+                Iterator current;
+                Iterator end;
+            };
+
+            using reference = RefTuple<std::size_t, typename std::iterator_traits<Iterator>::reference>;
+            using value_type = reference;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            using SynthesizedOperators<KWayMergeIterator>::operator++;
+
+            /**
+             * Creates an end iterator
+             */
+            constexpr KWayMergeIterator() = default;
+
+            /**
+             * CTor. Builds the loser tree
+             * @param cursors current positions and ends of the sources
+             * @param comp comparison. Must outlive the iterator
+             */
+            KWayMergeIterator(std::vector<Cursor> cursors, const Compare &comp) :
+                    cursors(std::move(cursors)), heads(this->cursors.size()), losers(this->cursors.size()),
+                    comp(std::addressof(comp)) {
+                const auto k = this->cursors.size();
+                if (k == 0) {
+                    return;
+                }
+
+                std::vector<std::size_t> winners(2 * k);
+                for (std::size_t source = 0; source < k; ++source) {
+                    winners[k + source] = source;
+                    load(source);
+                }
+
+                for (std::size_t node = k - 1; node > 0; --node) {
+                    auto lhs = winners[2 * node];
+                    auto rhs = winners[2 * node + 1];
+                    if (beats(lhs, rhs)) {
+                        winners[node] = lhs;
+                        losers[node] = rhs;
+                    } else {
+                        winners[node] = rhs;
+                        losers[node] = lhs;
+                    }
+                }
+
+                winner = k == 1 ? 0 : winners[1];
+            }
+
+            /**
+             * @return pair (sourceId, element) of the smallest remaining element
+             */
+            constexpr reference operator*() const {
+                return reference(winner, *cursors[winner].current);
+            }
+
+            /**
+             * Advances to the next element
+             * @return reference to this
+             */
+            KWayMergeIterator &operator++() {
+                ++cursors[winner].current;
+                ++position;
+                load(winner);
+                auto candidate = winner;
+                for (auto node = (candidate + cursors.size()) / 2; node > 0; node /= 2) {
+                    // outcomes are unpredictable, so select instead of branching
+                    const auto loser = losers[node];
+                    const bool swap = beats(loser, candidate);
+                    losers[node] = swap ? candidate : loser;
+                    candidate = swap ? loser : candidate;
+                }
+
+                winner = candidate;
+                return *this;
+            }
+
+            /**
+             * Equality comparison
+             * @param other right hand side
+             * @return true if both iterators are exhausted or if both have produced the same number of elements
+             */
+            bool operator==(const KWayMergeIterator &other) const {
+                auto done = exhausted();
+                return done == other.exhausted() && (done || position == other.position);
+            }
+
+        private:
+            bool exhausted() const {
+                return heads.empty() || heads[winner].done;
+            }
+
+            void load(std::size_t source) {
+                auto &cursor = cursors[source];
+                heads[source].done = cursor.current == cursor.end;
+                if constexpr (CacheHeads) {
+                    if (not heads[source].done) {
+                        heads[source].value = *cursor.current;
+                    }
+                }
+            }
+
+            decltype(auto) head(std::size_t source) const {
+                if constexpr (CacheHeads) {
+                    return (heads[source].value);
+                } else {
+                    return *cursors[source].current;
+                }
+            }
+
+            bool beats(std::size_t lhs, std::size_t rhs) const {
+                // exhausted sources lose every match
+                if (heads[lhs].done || heads[rhs].done) {
+                    return not heads[lhs].done;
+                }
+
+                // ties go to the lower source id: compare the higher id against the lower one and flip the result if
+                // lhs is the lower id. This needs one comparison and no data dependent branch
+                const bool lhsFirst = lhs < rhs;
+                const auto higher = lhsFirst ? rhs : lhs;
+                const auto lower = lhsFirst ? lhs : rhs;
+                return (*comp)(head(higher), head(lower)) != lhsFirst;
+            }
+
+            std::vector<Cursor> cursors;
+            std::vector<Head> heads;
+            std::vector<std::size_t> losers;
+            std::size_t winner = 0;
+            std::size_t position = 0;
+            const Compare *comp = nullptr;
+        };
+
+        /**
+         * @brief Lazy k-way merge of a runtime number of sorted ranges
+         * @tparam Sources range of sorted ranges (e.g. std::vector<std::vector<T>> or std::vector<ZipView<...>>)
+         * @tparam Compare comparison type
+         */
+        template<typename Sources, typename Compare>
+        struct KWayMergeView DERIVE_VIEW_INTERFACE(KWayMergeView<Sources, Compare>) {
+        private:
+            template<bool Const>
+            using Source = decltype(*std::begin(std::declval<std::add_lvalue_reference_t<
+                    traits::const_if_t<Const, std::remove_reference_t<Sources>>>>()));
+            template<bool Const>
+            using MergeIterator = KWayMergeIterator<decltype(std::begin(std::declval<Source<Const>>())), Compare>;
+
+            template<bool Const, typename S>
+            static auto makeBegin(S &sources, const Compare &comp) {
+                using Cursor = typename MergeIterator<Const>::Cursor;
+                std::vector<Cursor> cursors;
+                for (auto &&source : sources) {
+                    cursors.push_back(Cursor{std::begin(source), common_end(source)});
+                }
+
+                return MergeIterator<Const>(std::move(cursors), comp);
+            }
+        public:
+            /**
+             * CTor.
+             * @tparam S type of the sources
+             * @param sources range of sorted ranges
+             * @param comp comparison
+             */
+            template<typename S>
+            constexpr KWayMergeView(S &&sources, Compare comp) : data(std::forward<S>(sources), std::move(comp)) {}
+
+            KWayMergeView() = default;
+
+            /**
+             * @return KWayMergeIterator to the smallest element
+             */
+            auto begin() {
+                auto &[sources, comp] = data;
+                return makeBegin<false>(sources, comp);
+            }
+
+            /**
+             * @return KWayMergeIterator representing the end of the merge
+             */
+            auto end() {
+                return MergeIterator<false>();
+            }
+
+            /**
+             * @copydoc KWayMergeView::begin()
+             */
+            template<bool C = true>
+            auto begin() const -> MergeIterator<C> {
+                auto &[sources, comp] = data;
+                return makeBegin<true>(sources, comp);
+            }
+
+            /**
+             * @copydoc KWayMergeView::end()
+             */
+            template<bool C = true>
+            auto end() const -> MergeIterator<C> {
+                return MergeIterator<true>();
+            }
+
+        private:
+            std::tuple<Sources, Compare> data;
+        };
+    }
+
+    /**
+     * Lazy k-way merge of sorted ranges, e.g. the sorted runs of an external sort. Produces pairs (sourceId, element)
+     * in sorted order, where sourceId is the position of the element's range in sources. Equivalent elements are
+     * produced in the order of their sources. A loser tree is used, so each element costs about log2(k)
+     * comparisons.
+     * @code
+     * std::vector<std::vector<int>> runs = ...;
+     * for (auto [run, value] : kway_merge(runs)) {
+     *     ...
+     * }
+     * @endcode
+     * @tparam Sources range of ranges. The inner ranges must have the same type and must be sorted by comp. Begin and
+     * end must have the same type unless the inner ranges are random access
+     * @tparam Compare comparison type
+     * @param sources range of sorted ranges. Temporaries are moved into the view
+     * @param comp strict weak ordering of the elements (default std::less)
+     * @return impl::KWayMergeView
+     * @relatesalso impl::KWayMergeView
+     */
+    template<typename Sources, typename Compare = std::less<>>
+    constexpr auto kway_merge(Sources &&sources, Compare comp = {}) {
+        return impl::KWayMergeView<Sources, Compare>(std::forward<Sources>(sources), std::move(comp));
+    }
+}
+
+#endif //ITERATORTOOLS_KWAYMERGE_HPP
@@ -0,0 +1,335 @@
+/**
+ * @file MappedColumn.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains the definition of memory mapped columns. A binary file of fixed-size records is exposed
+ * as contiguous random access range that can directly be used with zip and enumerate without copying the file
+ * contents into a container first. Requires a POSIX system (mmap, madvise).
+ */
+
+#ifndef ITERATORTOOLS_MAPPEDCOLUMN_HPP
+#define ITERATORTOOLS_MAPPEDCOLUMN_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Iterators.hpp"
+
+namespace iterators {
+
+    /**
+     * @brief Access pattern hints that are forwarded to madvise. Hints can be combined using operator|
+     */
+    enum class Advice : unsigned {
+        Normal = 0,
+        Sequential = 1,
+        Random = 2,
+        WillNeed = 4,
+        HugePage = 8
+    };
+
+    /**
+     * Combines two access pattern hints
+     * @param lhs left hand side
+     * @param rhs right hand side
+     * @return Advice containing the hints of both sides
+     */
+    constexpr Advice operator|(Advice lhs, Advice rhs) noexcept {
+        return static_cast<Advice>(static_cast<unsigned>(lhs) | static_cast<unsigned>(rhs));
+    }
+
+    namespace impl {
+        constexpr bool has_hint(Advice advice, Advice hint) noexcept {
+            return (static_cast<unsigned>(advice) & static_cast<unsigned>(hint)) != 0;
+        }
+
+        /**
+         * @brief RAII wrapper around a shared memory mapping of an entire file.
+         */
+        class FileMapping {
+        public:
+            /**
+             * CTor. Maps the entire file into memory
+             * @param path path to the file
+             * @param writable if true, the file is opened for writing and changes to the mapped memory are written
+             * back to the file
+             * @throws std::system_error if the file cannot be opened or mapped
+             */
+            FileMapping(const std::string &path, bool writable) {
+                int fd = ::open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+                if (fd < 0) {
+                    throw std::system_error(errno, std::generic_category(), "cannot open '" + path + "'");
+                }
+
+                struct stat info{};
+                if (::fstat(fd, &info) != 0) {
+                    auto error = errno;
+                    ::close(fd);
+                    throw std::system_error(error, std::generic_category(), "cannot stat '" + path + "'");
+                }
+
+                length = static_cast<std::size_t>(info.st_size);
+                if (length != 0) {
+                    address = ::mmap(nullptr, length, PROT_READ | (writable ? PROT_WRITE : 0), MAP_SHARED, fd, 0);
+                    if (address == MAP_FAILED) {
+                        auto error = errno;
+                        address = nullptr;
+                        ::close(fd);
+                        throw std::system_error(error, std::generic_category(), "cannot map '" + path + "'");
+                    }
+                }
+
+                ::close(fd);
+            }
+
+            FileMapping(const FileMapping &) = delete;
+            FileMapping &operator=(const FileMapping &) = delete;
+
+            ~FileMapping() {
+                if (address != nullptr) {
+                    ::munmap(address, length);
+                }
+            }
+
+            /**
+             * @return start address of the mapping (nullptr for empty files)
+             */
+            [[nodiscard]] void *data() const noexcept {
+                return address;
+            }
+
+            /**
+             * @return size of the mapping in bytes
+             */
+            [[nodiscard]] std::size_t size() const noexcept {
+                return length;
+            }
+
+            /**
+             * Forwards access pattern hints for a part of the mapping to the kernel
+             * @param advice combination of hints
+             * @param offset start of the advised region in bytes
+             * @param count size of the advised region in bytes
+             * @return true if all hints were accepted, false otherwise.
+             * @note Hints are purely advisory. Especially Advice::HugePage is not supported by all file systems.
+             */
+            bool advise(Advice advice, std::size_t offset, std::size_t count) const noexcept {
+                if (address == nullptr || count == 0) {
+                    return true;
+                }
+
+                static const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                auto alignedOffset = offset - offset % pageSize;
+                auto start = static_cast<char *>(address) + alignedOffset;
+                auto size = count + (offset - alignedOffset);
+                bool success = true;
+                if (advice == Advice::Normal) {
+                    success = ::madvise(start, size, MADV_NORMAL) == 0;
+                }
+
+                if (has_hint(advice, Advice::Sequential)) {
+                    success &= ::madvise(start, size, MADV_SEQUENTIAL) == 0;
+                }
+
+                if (has_hint(advice, Advice::Random)) {
+                    success &= ::madvise(start, size, MADV_RANDOM) == 0;
+                }
+
+                if (has_hint(advice, Advice::WillNeed)) {
+                    success &= ::madvise(start, size, MADV_WILLNEED) == 0;
+                }
+
+                if (has_hint(advice, Advice::HugePage)) {
+#ifdef MADV_HUGEPAGE
+                    success &= ::madvise(start, size, MADV_HUGEPAGE) == 0;
+#else
+                    success = false;
+#endif
+                }
+
+                return success;
+            }
+
+        private:
+            void *address = nullptr;
+            std::size_t length = 0;
+        };
+
+        /**
+         * @brief Contiguous random access range over a memory mapped array of fixed-size records.
+         * @details @copybrief
+         * The column shares ownership of the underlying mapping, so copies are cheap and several columns can refer
+         * to different parts of the same file. If T is const, the file is mapped read-only. Otherwise, changes to
+         * the elements are written back to the file.
+         * @tparam T record type. Must be trivially copyable
+         */
+        template<typename T>
+        struct MappedColumn DERIVE_VIEW_INTERFACE(MappedColumn<T>) {
+            static_assert(std::is_trivially_copyable_v<T>, "mapped records must be trivially copyable");
+        public:
+            using value_type = std::remove_const_t<T>;
+            using iterator = T *;
+            using const_iterator = const T *;
+
+            MappedColumn() = default;
+
+            /**
+             * CTor. Creates a column view over a part of an existing mapping
+             * @param mapping shared file mapping
+             * @param offset offset of the first record in bytes. Must be suitably aligned for T
+             * @param count number of records
+             * @throws std::invalid_argument if offset is not a multiple of the alignment of T
+             * @throws std::out_of_range if the records exceed the mapping
+             */
+            MappedColumn(std::shared_ptr<const FileMapping> mapping, std::size_t offset, std::size_t count) :
+                    mapping(std::move(mapping)), count(count) {
+                if (offset % alignof(T) != 0) {
+                    throw std::invalid_argument("record offset " + std::to_string(offset) + " is misaligned");
+                }
+
+                if (count == 0) {
+                    return;
+                }
+
+                if (this->mapping == nullptr || offset > this->mapping->size() ||
+                    count > (this->mapping->size() - offset) / sizeof(T)) {
+                    throw std::out_of_range("records exceed the mapped file");
+                }
+
+                first = reinterpret_cast<T *>(static_cast<char *>(this->mapping->data()) + offset);
+            }
+
+            /**
+             * CTor. Maps the entire file. Read-only if T is const
+             * @param path path to the file
+             * @param advice optional access pattern hints
+             * @throws std::system_error if the file cannot be mapped
+             * @throws std::runtime_error if the file size is not a multiple of the record size
+             */
+            explicit MappedColumn(const std::string &path, Advice advice = Advice::Normal) {
+                auto map = std::make_shared<const FileMapping>(path, not std::is_const_v<T>);
+                if (map->size() % sizeof(T) != 0) {
+                    throw std::runtime_error("size of '" + path + "' is not a multiple of the record size");
+                }
+
+                auto records = map->size() / sizeof(T);
+                *this = MappedColumn(std::move(map), 0, records);
+                this->advise(advice);
+            }
+
+            /**
+             * @return pointer to the first record
+             */
+            constexpr T *begin() noexcept {
+                return first;
+            }
+
+            /**
+             * @return pointer to the record following the last record
+             */
+            constexpr T *end() noexcept {
+                return first + count;
+            }
+
+            /**
+             * @copydoc MappedColumn::begin()
+             * @note returns a pointer that does not allow changing the records
+             */
+            constexpr const T *begin() const noexcept {
+                return first;
+            }
+
+            /**
+             * @copydoc MappedColumn::end()
+             * @note returns a pointer that does not allow changing the records
+             */
+            constexpr const T *end() const noexcept {
+                return first + count;
+            }
+
+            /**
+             * @copydoc MappedColumn::begin()
+             */
+            constexpr T *data() noexcept {
+                return first;
+            }
+
+            /**
+             * @copydoc MappedColumn::begin() const
+             */
+            constexpr const T *data() const noexcept {
+                return first;
+            }
+
+            /**
+             * @return number of records
+             */
+            [[nodiscard]] constexpr std::size_t size() const noexcept {
+                return count;
+            }
+
+            /**
+             * Array subscript operator (no bounds are checked)
+             * @param index index
+             * @return reference to the record at the given index
+             */
+            constexpr T &operator[](std::size_t index) noexcept {
+                return first[index];
+            }
+
+            /**
+             * @copydoc MappedColumn::operator[](std::size_t index)
+             */
+            constexpr const T &operator[](std::size_t index) const noexcept {
+                return first[index];
+            }
+
+            /**
+             * Forwards access pattern hints for the records of this column to the kernel
+             * @param advice combination of hints
+             * @return true if all hints were accepted, false otherwise
+             */
+            bool advise(Advice advice) const noexcept {
+                if (mapping == nullptr) {
+                    return true;
+                }
+
+                auto offset = static_cast<std::size_t>(reinterpret_cast<const char *>(first) -
+                                                       static_cast<const char *>(mapping->data()));
+                return mapping->advise(advice, offset, count * sizeof(T));
+            }
+
+        private:
+            std::shared_ptr<const FileMapping> mapping;
+            T *first = nullptr;
+            std::size_t count = 0;
+        };
+    }
+
+    /**
+     * Maps a binary file of fixed-size records into memory. The resulting column can be used like a container, for
+     * example in zip or enumerate, without reading the file into memory first.
+     * @tparam T record type. Use a const type to map the file read-only
+     * @param path path to the file
+     * @param advice optional access pattern hints (e.g. ```Advice::Sequential | Advice::WillNeed```)
+     * @return impl::MappedColumn spanning the entire file
+     * @throws std::system_error if the file cannot be mapped
+     * @throws std::runtime_error if the file size is not a multiple of the record size
+     * @relatesalso impl::MappedColumn
+     */
+    template<typename T>
+    auto mapped_column(const std::string &path, Advice advice = Advice::Normal) -> impl::MappedColumn<T> {
+        return impl::MappedColumn<T>(path, advice);
+    }
+}
+
+#endif //ITERATORTOOLS_MAPPEDCOLUMN_HPP
@@ -0,0 +1,612 @@
+/**
+ * @file NullableColumn.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains nullable columns: a contiguous value buffer plus a packed validity bitmap (one bit per
+ * row, 1 = valid). Null rows hold a value initialized element, so the value buffer can be processed with SIMD code
+ * regardless of nulls. As zip column, a nullable column yields optional-like proxy references. skip_nulls iterates
+ * the valid rows only and skips null rows word by word using count-trailing-zeros.
+ */
+
+#ifndef ITERATORTOOLS_NULLABLECOLUMN_HPP
+#define ITERATORTOOLS_NULLABLECOLUMN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Iterators.hpp"
+#include "BitColumn.hpp"
+
+namespace iterators {
+    namespace impl {
+        constexpr inline std::size_t ValidityWordBits = 64;
+
+        /**
+         * @brief Optional-like proxy reference to a row of a nullable column
+         * @tparam T element type. Use a const type for read-only access
+         */
+        template<typename T>
+        class NullableReference {
+            using Value = std::remove_const_t<T>;
+            using Word = std::conditional_t<std::is_const_v<T>, const std::uint64_t, std::uint64_t>;
+        public:
+            /**
+             * CTor.
+             * @param value pointer to the value of the row
+             * @param word pointer to the validity word that contains the bit of the row
+             * @param mask mask of the bit of the row
+             */
+            constexpr NullableReference(T *value, Word *word, std::uint64_t mask) noexcept :
+                    element(value), word(word), mask(mask) {}
+
+            constexpr NullableReference(const NullableReference &) noexcept = default;
+
+            /**
+             * @return true if the row is not null
+             */
+            [[nodiscard]] constexpr bool has_value() const noexcept {
+                return (*word & mask) != 0;
+            }
+
+            /**
+             * @copydoc has_value
+             */
+            constexpr explicit operator bool() const noexcept {
+                return has_value();
+            }
+
+            /**
+             * @return reference to the value of the row. The value of a null row is value initialized
+             */
+            constexpr T &operator*() const noexcept {
+                return *element;
+            }
+
+            /**
+             * @return pointer to the value of the row
+             */
+            constexpr T *operator->() const noexcept {
+                return element;
+            }
+
+            /**
+             * @return reference to the value of the row
+             * @throws std::bad_optional_access if the row is null
+             */
+            constexpr T &value() const {
+                if (not has_value()) {
+                    throw std::bad_optional_access();
+                }
+
+                return *element;
+            }
+
+            /**
+             * @tparam U type of the default value
+             * @param defaultValue value returned for null rows
+             * @return copy of the value or defaultValue if the row is null
+             */
+            template<typename U>
+            constexpr Value value_or(U &&defaultValue) const {
+                return has_value() ? *element : static_cast<Value>(std::forward<U>(defaultValue));
+            }
+
+            /**
+             * @return copy of the row as std::optional
+             */
+            constexpr operator std::optional<Value>() const {
+                return has_value() ? std::optional<Value>(*element) : std::nullopt;
+            }
+
+            /**
+             * Assigns a value and marks the row valid
+             * @param value new value
+             * @return reference to this
+             */
+            template<typename U = T, typename = std::enable_if_t<not std::is_const_v<U>>>
+            constexpr const NullableReference &operator=(const Value &value) const {
+                *element = value;
+                *word |= mask;
+                return *this;
+            }
+
+            /**
+             * Marks the row null and value initializes its value
+             * @return reference to this
+             */
+            template<typename U = T, typename = std::enable_if_t<not std::is_const_v<U>>>
+            constexpr const NullableReference &operator=(std::nullopt_t) const {
+                *element = Value{};
+                *word &= ~mask;
+                return *this;
+            }
+
+            /**
+             * Assigns an optional value
+             * @param value new value or std::nullopt
+             * @return reference to this
+             */
+            template<typename U = T, typename = std::enable_if_t<not std::is_const_v<U>>>
+            constexpr const NullableReference &operator=(const std::optional<Value> &value) const {
+                return value.has_value() ? *this = *value : *this = std::nullopt;
+            }
+
+            /**
+             * Assigns the contents (value and validity) of another row
+             * @param other reference to the other row
+             * @return reference to this
+             */
+            constexpr const NullableReference &operator=(const NullableReference &other) const {
+                static_assert(not std::is_const_v<T>, "cannot assign to a read-only nullable reference");
+                return *this = static_cast<std::optional<Value>>(other);
+            }
+
+            /**
+             * Equality comparison with std::nullopt
+             * @return true if the row is null
+             */
+            friend constexpr bool operator==(const NullableReference &ref, std::nullopt_t) noexcept {
+                return not ref.has_value();
+            }
+
+            /**
+             * Inequality comparison with std::nullopt
+             * @return true if the row is valid
+             */
+            friend constexpr bool operator!=(const NullableReference &ref, std::nullopt_t) noexcept {
+                return ref.has_value();
+            }
+
+        private:
+            T *element;
+            Word *word;
+            std::uint64_t mask;
+        };
+
+        namespace traits {
+            template<typename T>
+            struct element_value<NullableReference<T>> {
+                using type = std::optional<std::remove_const_t<T>>;
+            };
+        }
+
+        /**
+         * @brief Random access iterator over the rows of a nullable column. Dereferencing yields a NullableReference
+         * @tparam T element type. Use a const type for read-only access
+         */
+        template<typename T>
+        class NullableIterator : public SynthesizedOperators<NullableIterator<T>> {
+            using Word = std::conditional_t<std::is_const_v<T>, const std::uint64_t, std::uint64_t>;
+        public:
+            using value_type = std::optional<std::remove_const_t<T>>;
+            using reference = NullableReference<T>;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::random_access_iterator_tag;
+
+            using SynthesizedOperators<NullableIterator>::operator++;
+            using SynthesizedOperators<NullableIterator>::operator--;
+
+            constexpr NullableIterator() noexcept = default;
+
+            /**
+             * CTor.
+             * @param values first value of the column
+             * @param words first validity word of the column
+             * @param row row index
+             */
+            constexpr NullableIterator(T *values, Word *words, std::ptrdiff_t row) noexcept :
+                    values(values), words(words), row(row) {}
+
+            /**
+             * Conversion to a read-only iterator
+             */
+            template<typename U = T, typename = std::enable_if_t<not std::is_const_v<U>>>
+            constexpr operator NullableIterator<const U>() const noexcept {
+                return NullableIterator<const U>(values, words, row);
+            }
+
+            constexpr reference operator*() const noexcept {
+                constexpr auto WordBits = static_cast<std::ptrdiff_t>(ValidityWordBits);
+                return reference(values + row, words + row / WordBits, std::uint64_t(1) << (row % WordBits));
+            }
+
+            constexpr NullableIterator &operator++() noexcept {
+                ++row;
+                return *this;
+            }
+
+            constexpr NullableIterator &operator--() noexcept {
+                --row;
+                return *this;
+            }
+
+            constexpr NullableIterator &operator+=(difference_type n) noexcept {
+                row += n;
+                return *this;
+            }
+
+            constexpr NullableIterator &operator-=(difference_type n) noexcept {
+                row -= n;
+                return *this;
+            }
+
+            constexpr difference_type operator-(const NullableIterator &other) const noexcept {
+                return row - other.row;
+            }
+
+            constexpr bool operator==(const NullableIterator &other) const noexcept {
+                return row == other.row;
+            }
+
+            constexpr bool operator<(const NullableIterator &other) const noexcept {
+                return row < other.row;
+            }
+
+            constexpr bool operator>(const NullableIterator &other) const noexcept {
+                return row > other.row;
+            }
+
+        private:
+            T *values = nullptr;
+            Word *words = nullptr;
+            std::ptrdiff_t row = 0;
+        };
+
+        /**
+         * @brief Forward iterator over the valid rows of a nullable column. Yields pairs (row, value). Null rows are
+         * skipped a whole validity word at a time.
+         * @tparam T element type. Use a const type for read-only access
+         */
+        template<typename T>
+        class SkipNullsIterator : public SynthesizedOperators<SkipNullsIterator<T>> {
+            using Word = std::conditional_t<std::is_const_v<T>, const std::uint64_t, std::uint64_t>;
+        public:
+            using reference = RefTuple<std::size_t, T &>;
+            using value_type = reference;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            using SynthesizedOperators<SkipNullsIterator>::operator++;
+
+            constexpr SkipNullsIterator() noexcept = default;
+
+            /**
+             * CTor. Searches the first valid row at or after row
+             * @param values first value of the column
+             * @param bits validity bitmap
+             * @param row start row
+             */
+            constexpr SkipNullsIterator(T *values, BitWords<Word> bits, std::size_t row) noexcept :
+                    values(values), bits(bits), row(find_next_set(bits, row)) {
+                if (this->row < bits.count) {
+                    pending = bits.load(this->row / ValidityWordBits) &
+                              (~std::uint64_t(0) << (this->row % ValidityWordBits));
+                }
+            }
+
+            /**
+             * @return pair (row, value) of the current valid row
+             */
+            constexpr reference operator*() const noexcept {
+                return reference(row, values[row]);
+            }
+
+            /**
+             * Advances to the next valid row
+             * @return reference to this
+             */
+            constexpr SkipNullsIterator &operator++() noexcept {
+                pending &= pending - 1;
+                auto k = row / ValidityWordBits;
+                const auto numWords = bits.numWords();
+                while (pending == 0) {
+                    if (++k == numWords) {
+                        row = bits.count;
+                        return *this;
+                    }
+
+                    pending = bits.load(k);
+                }
+
+                row = k * ValidityWordBits + count_trailing_zeros(pending);
+                return *this;
+            }
+
+            /**
+             * Equality comparison
+             * @param other right hand side
+             * @return true if both iterators refer to the same row
+             */
+            constexpr bool operator==(const SkipNullsIterator &other) const noexcept {
+                return row == other.row;
+            }
+
+            /**
+             * @return index of the current row
+             */
+            [[nodiscard]] constexpr std::size_t index() const noexcept {
+                return row;
+            }
+
+        private:
+            T *values = nullptr;
+            BitWords<Word> bits{nullptr, 0, 0};
+            std::size_t row = 0;
+            std::uint64_t pending = 0;
+        };
+
+        /**
+         * @brief Non-owning view over the valid rows of a nullable column
+         * @tparam T element type. Use a const type for read-only access
+         */
+        template<typename T>
+        struct SkipNullsView DERIVE_VIEW_INTERFACE(SkipNullsView<T>) {
+            using Word = std::conditional_t<std::is_const_v<T>, const std::uint64_t, std::uint64_t>;
+
+            constexpr SkipNullsView() noexcept = default;
+
+            /**
+             * CTor.
+             * @param values first value of the column
+             * @param bits validity bitmap
+             */
+            constexpr SkipNullsView(T *values, BitWords<Word> bits) noexcept : values(values), bits(bits) {}
+
+            /**
+             * @return SkipNullsIterator to the first valid row
+             */
+            constexpr SkipNullsIterator<T> begin() const noexcept {
+                return SkipNullsIterator<T>(values, bits, 0);
+            }
+
+            /**
+             * @return SkipNullsIterator representing the end of the view
+             */
+            constexpr SkipNullsIterator<T> end() const noexcept {
+                return SkipNullsIterator<T>(values, bits, bits.count);
+            }
+
+        private:
+            T *values = nullptr;
+            BitWords<Word> bits{nullptr, 0, 0};
+        };
+
+        /**
+         * @brief Owning nullable column. Stores the values contiguously and the validity of each row in a packed
+         * bitmap. Can be used as zip column, in which case it yields NullableReference proxies.
+         * @tparam T element type. Must be default constructible
+         */
+        template<typename T>
+        class NullableColumn {
+        public:
+            using value_type = std::optional<T>;
+            using iterator = NullableIterator<T>;
+            using const_iterator = NullableIterator<const T>;
+
+            NullableColumn() = default;
+
+            /**
+             * CTor. Creates a column of null rows
+             * @param size number of rows
+             */
+            explicit NullableColumn(std::size_t size) : elements(size), validity(numWords(size)) {}
+
+            /**
+             * CTor. Creates a column of valid rows
+             * @param values values of the rows
+             */
+            explicit NullableColumn(std::vector<T> values) :
+                    elements(std::move(values)), validity(numWords(elements.size()), ~std::uint64_t(0)) {
+                clearTail();
+            }
+
+            iterator begin() noexcept {
+                return iterator(elements.data(), validity.data(), 0);
+            }
+
+            iterator end() noexcept {
+                return iterator(elements.data(), validity.data(), static_cast<std::ptrdiff_t>(elements.size()));
+            }
+
+            const_iterator begin() const noexcept {
+                return const_iterator(elements.data(), validity.data(), 0);
+            }
+
+            const_iterator end() const noexcept {
+                return const_iterator(elements.data(), validity.data(), static_cast<std::ptrdiff_t>(elements.size()));
+            }
+
+            /**
+             * @return number of rows
+             */
+            [[nodiscard]] std::size_t size() const noexcept {
+                return elements.size();
+            }
+
+            /**
+             * @return true if the column has no rows
+             */
+            [[nodiscard]] bool empty() const noexcept {
+                return elements.empty();
+            }
+
+            /**
+             * Array subscript operator (no bounds are checked)
+             * @param row row index
+             * @return reference to the row
+             */
+            NullableReference<T> operator[](std::size_t row) noexcept {
+                return begin()[static_cast<std::ptrdiff_t>(row)];
+            }
+
+            /**
+             * @copydoc NullableColumn::operator[]
+             */
+            NullableReference<const T> operator[](std::size_t row) const noexcept {
+                return begin()[static_cast<std::ptrdiff_t>(row)];
+            }
+
+            /**
+             * Appends a valid row
+             * @param value value of the row
+             */
+            void push_back(const T &value) {
+                grow();
+                elements.push_back(value);
+                validity.back() |= std::uint64_t(1) << ((elements.size() - 1) % ValidityWordBits);
+            }
+
+            /**
+             * Appends a null row
+             */
+            void push_back(std::nullopt_t) {
+                grow();
+                elements.emplace_back();
+            }
+
+            /**
+             * Appends a row
+             * @param value value of the row or std::nullopt
+             */
+            void push_back(const std::optional<T> &value) {
+                if (value.has_value()) {
+                    push_back(*value);
+                } else {
+                    push_back(std::nullopt);
+                }
+            }
+
+            /**
+             * Changes the number of rows. New rows are null
+             * @param size new number of rows
+             */
+            void resize(std::size_t size) {
+                elements.resize(size);
+                validity.resize(numWords(size));
+                clearTail();
+            }
+
+            /**
+             * Reserves memory for a number of rows
+             * @param capacity number of rows
+             */
+            void reserve(std::size_t capacity) {
+                elements.reserve(capacity);
+                validity.reserve(numWords(capacity));
+            }
+
+            /**
+             * @return contiguous value buffer. Null rows hold value initialized elements
+             */
+            [[nodiscard]] std::vector<T> &values() noexcept {
+                return elements;
+            }
+
+            /**
+             * @copydoc NullableColumn::values()
+             */
+            [[nodiscard]] const std::vector<T> &values() const noexcept {
+                return elements;
+            }
+
+            /**
+             * @return validity bitmap (1 = valid) as bit column
+             * @note Changing the size of the value buffer directly invalidates the bitmap
+             */
+            [[nodiscard]] BitSpan<std::uint64_t> validityBits() noexcept {
+                return BitSpan<std::uint64_t>(validity.data(), elements.size());
+            }
+
+            /**
+             * @copydoc NullableColumn::validityBits()
+             */
+            [[nodiscard]] BitSpan<const std::uint64_t> validityBits() const noexcept {
+                return BitSpan<const std::uint64_t>(validity.data(), elements.size());
+            }
+
+            /**
+             * @return number of null rows
+             */
+            [[nodiscard]] std::size_t nullCount() const {
+                return elements.size() - count_set(validityBits());
+            }
+
+        private:
+            static constexpr std::size_t numWords(std::size_t rows) noexcept {
+                return (rows + ValidityWordBits - 1) / ValidityWordBits;
+            }
+
+            void grow() {
+                if (elements.size() % ValidityWordBits == 0) {
+                    validity.push_back(0);
+                }
+            }
+
+            // bits beyond the last row are kept 0, so that growing the column yields null rows
+            void clearTail() {
+                if (auto used = elements.size() % ValidityWordBits; used != 0) {
+                    validity.back() &= (std::uint64_t(1) << used) - 1;
+                }
+            }
+
+            std::vector<T> elements;
+            std::vector<std::uint64_t> validity;
+        };
+    }
+
+    /**
+     * Creates a nullable column (value buffer plus validity bitmap) of null rows. Rows can be appended with
+     * push_back(value) or push_back(std::nullopt). Zipped, the column yields optional-like references.
+     * @code
+     * auto prices = nullable_column<double>();
+     * prices.push_back(1.5);
+     * prices.push_back(std::nullopt);
+     * for (auto [id, price] : zip(ids, prices)) {
+     *     if (price) { total += *price; }
+     * }
+     * @endcode
+     * @tparam T element type
+     * @param size initial number of (null) rows
+     * @return impl::NullableColumn
+     * @relatesalso impl::NullableColumn
+     */
+    template<typename T>
+    auto nullable_column(std::size_t size = 0) -> impl::NullableColumn<T> {
+        return impl::NullableColumn<T>(size);
+    }
+
+    /**
+     * Creates a view over the valid rows of a nullable column. Yields pairs (row, value). Null rows are skipped a
+     * whole bitmap word at a time using count-trailing-zeros, so sparse valid rows cost no per-row branches.
+     * @code
+     * for (auto [row, price] : skip_nulls(prices)) {
+     *     total += price * quantities[row];
+     * }
+     * @endcode
+     * @tparam T element type
+     * @param column nullable column. Must outlive the view
+     * @return impl::SkipNullsView
+     * @relatesalso impl::SkipNullsView
+     */
+    template<typename T>
+    auto skip_nulls(impl::NullableColumn<T> &column) noexcept -> impl::SkipNullsView<T> {
+        return impl::SkipNullsView<T>(column.values().data(), impl::bit_words(column.validityBits()));
+    }
+
+    /**
+     * @copydoc skip_nulls
+     */
+    template<typename T>
+    auto skip_nulls(const impl::NullableColumn<T> &column) noexcept -> impl::SkipNullsView<const T> {
+        return impl::SkipNullsView<const T>(column.values().data(), impl::bit_words(column.validityBits()));
+    }
+}
+
+#endif //ITERATORTOOLS_NULLABLECOLUMN_HPP
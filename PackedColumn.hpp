@@ -0,0 +1,439 @@
+/**
+ * @file PackedColumn.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains a read-only bit-packed integer column. Values are stored in blocks of 128 using
+ * frame-of-reference encoding: each block stores its minimum and the differences to it with the smallest bit width
+ * that fits. Iterators that scan a block unpack it at once (with SSE2 where available) into a buffer, random access
+ * to a single element is O(1).
+ */
+
+#ifndef ITERATORTOOLS_PACKEDCOLUMN_HPP
+#define ITERATORTOOLS_PACKEDCOLUMN_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "Iterators.hpp"
+#include "BitColumn.hpp"
+
+namespace iterators {
+    namespace impl {
+        /**
+         * Number of values per block
+         */
+        constexpr inline std::size_t PackedBlockSize = 128;
+
+        /**
+         * Number of interleaved 32 bit lanes. Value j of a block is stored in lane j % PackedLanes, so that one
+         * 128 bit load contains the next bits of four consecutive values
+         */
+        constexpr inline std::size_t PackedLanes = 4;
+
+        /**
+         * @brief Header of a packed block
+         * @tparam T element type
+         */
+        template<typename T>
+        struct PackedBlock {
+            T base;                 ///< minimum of the block
+            std::size_t offset;     ///< position of the first word of the block
+            unsigned width;         ///< number of bits per value
+        };
+
+        constexpr unsigned packed_width(std::uint64_t maxDelta) noexcept {
+            return maxDelta == 0 ? 0 : 64 - count_leading_zeros(maxDelta);
+        }
+
+        constexpr std::uint64_t packed_mask(unsigned width) noexcept {
+            return width >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+        }
+
+        /**
+         * Extracts a single value of a block
+         * @param words first word of the block
+         * @param width bit width of the block
+         * @param index index of the value within the block
+         * @return difference to the base of the block
+         */
+        inline std::uint64_t packed_extract(const std::uint32_t *words, unsigned width, std::size_t index) noexcept {
+            const auto bit = (index / PackedLanes) * width;
+            const auto *lane = words + (bit / 32) * PackedLanes + index % PackedLanes;
+            const auto shift = static_cast<unsigned>(bit % 32);
+            // words are padded, so reading up to two words past the value is safe
+            auto delta = (std::uint64_t(lane[0]) | std::uint64_t(lane[PackedLanes]) << 32) >> shift;
+            if (shift + width > 64) {
+                delta |= std::uint64_t(lane[2 * PackedLanes]) << (64 - shift);
+            }
+
+            return delta & packed_mask(width);
+        }
+
+#if defined(__SSE2__) || defined(_M_X64)
+        template<typename T>
+        inline void packed_store(__m128i values, T base, T *dest) noexcept {
+            using U = std::make_unsigned_t<T>;
+            if constexpr (sizeof(T) == 4) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dest),
+                                 _mm_add_epi32(values, _mm_set1_epi32(static_cast<int>(base))));
+            } else if constexpr (sizeof(T) == 8) {
+                const auto base64 = _mm_set1_epi64x(static_cast<long long>(base));
+                const auto zero = _mm_setzero_si128();
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dest),
+                                 _mm_add_epi64(_mm_unpacklo_epi32(values, zero), base64));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + 2),
+                                 _mm_add_epi64(_mm_unpackhi_epi32(values, zero), base64));
+            } else {
+                alignas(16) std::uint32_t deltas[PackedLanes];
+                _mm_store_si128(reinterpret_cast<__m128i *>(deltas), values);
+                for (std::size_t lane = 0; lane < PackedLanes; ++lane) {
+                    dest[lane] = static_cast<T>(static_cast<U>(static_cast<U>(base) + deltas[lane]));
+                }
+            }
+        }
+
+        /**
+         * Unpacks a block of width Width. One vector holds the next 32 bits of four consecutive values. A value
+         * that crosses a word boundary gets its high bits from the next vector. All shifts are compile time
+         * constants, the loop is fully unrolled
+         */
+        template<unsigned Width, typename T, std::size_t ...K>
+        void packed_unpack_sse(const std::uint32_t *words, T base, T *out, std::index_sequence<K...>) noexcept {
+            const auto *in = reinterpret_cast<const __m128i *>(words);
+            const auto mask = _mm_set1_epi32(static_cast<int>(packed_mask(Width)));
+            auto step = [&](auto k) {
+                constexpr unsigned bit = (decltype(k)::value * Width) % 32;
+                constexpr unsigned word = (decltype(k)::value * Width) / 32;
+                auto values = _mm_srli_epi32(_mm_loadu_si128(in + word), bit);
+                if constexpr (bit + Width > 32) {
+                    values = _mm_or_si128(values, _mm_slli_epi32(_mm_loadu_si128(in + word + 1), 32 - bit));
+                }
+
+                packed_store(_mm_and_si128(values, mask), base, out + decltype(k)::value * PackedLanes);
+            };
+            (step(std::integral_constant<std::size_t, K>{}), ...);
+        }
+
+        template<typename T, std::size_t ...Width>
+        constexpr auto packed_unpack_table(std::index_sequence<Width...>) noexcept {
+            using Steps = std::make_index_sequence<PackedBlockSize / PackedLanes>;
+            using Unpack = void (*)(const std::uint32_t *, T, T *, Steps);
+            return std::array<Unpack, sizeof...(Width)>{&packed_unpack_sse<static_cast<unsigned>(Width), T>...};
+        }
+#endif
+
+        /**
+         * Unpacks a whole block
+         * @tparam T element type
+         * @param block block header
+         * @param words first word of the block
+         * @param out output buffer of PackedBlockSize elements
+         */
+        template<typename T>
+        void packed_unpack(const PackedBlock<T> &block, const std::uint32_t *words, T *out) noexcept {
+            using U = std::make_unsigned_t<T>;
+#if defined(__SSE2__) || defined(_M_X64)
+            static constexpr auto Table = packed_unpack_table<T>(std::make_index_sequence<33>());
+            if (block.width <= 32) {
+                Table[block.width](words, block.base, out, std::make_index_sequence<PackedBlockSize / PackedLanes>());
+                return;
+            }
+#endif
+            for (std::size_t i = 0; i < PackedBlockSize; ++i) {
+                out[i] = static_cast<T>(static_cast<U>(static_cast<U>(block.base) +
+                                                       packed_extract(words, block.width, i)));
+            }
+        }
+
+        template<typename T>
+        class PackedColumn;
+
+        /**
+         * @brief Random access iterator over a PackedColumn.
+         * @details @copybrief
+         * The first dereference of an iterator decodes only its element in O(1), like PackedColumn::operator[], so
+         * subscripts (which dereference a temporary copy) never unpack a block. Every further dereference of an
+         * element of a new block unpacks the whole block into a buffer owned by the iterator, so a scan decodes every
+         * block once. The buffer is allocated by the first unpack, iterators that are never scanned (e.g. end
+         * iterators) do not allocate.
+         * @tparam T element type
+         * @note Copies of the iterator do not copy the buffer
+         */
+        template<typename T>
+        class PackedIterator : public SynthesizedOperators<PackedIterator<T>> {
+        public:
+            using value_type = T;
+            using reference = T;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::random_access_iterator_tag;
+
+            using SynthesizedOperators<PackedIterator>::operator++;
+            using SynthesizedOperators<PackedIterator>::operator--;
+
+            PackedIterator() noexcept = default;
+
+            /**
+             * CTor.
+             * @param column underlying column
+             * @param index position
+             */
+            PackedIterator(const PackedColumn<T> *column, std::size_t index) noexcept :
+                    column(column), index(index) {}
+
+            PackedIterator(const PackedIterator &other) noexcept : column(other.column), index(other.index) {}
+
+            PackedIterator &operator=(const PackedIterator &other) noexcept {
+                column = other.column;
+                index = other.index;
+                cachedBlock = NoBlock;
+                return *this;
+            }
+
+            /**
+             * @return value at the current position
+             * @throws std::bad_alloc if the block buffer cannot be allocated
+             */
+            T operator*() const {
+                if (index / PackedBlockSize == cachedBlock) {
+                    return buffer[index % PackedBlockSize];
+                }
+
+                return load();
+            }
+
+            constexpr PackedIterator &operator++() noexcept {
+                ++index;
+                return *this;
+            }
+
+            constexpr PackedIterator &operator--() noexcept {
+                --index;
+                return *this;
+            }
+
+            constexpr PackedIterator &operator+=(difference_type n) noexcept {
+                index += static_cast<std::size_t>(n);
+                return *this;
+            }
+
+            constexpr PackedIterator &operator-=(difference_type n) noexcept {
+                index -= static_cast<std::size_t>(n);
+                return *this;
+            }
+
+            constexpr difference_type operator-(const PackedIterator &other) const noexcept {
+                return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+            }
+
+            constexpr bool operator==(const PackedIterator &other) const noexcept {
+                return index == other.index;
+            }
+
+            constexpr bool operator<(const PackedIterator &other) const noexcept {
+                return index < other.index;
+            }
+
+            constexpr bool operator>(const PackedIterator &other) const noexcept {
+                return index > other.index;
+            }
+
+        private:
+            static constexpr std::size_t NoBlock = std::numeric_limits<std::size_t>::max();
+            static constexpr std::size_t Touched = NoBlock - 1;
+
+            T load() const {
+                // a single dereference (e.g. a subscript) only decodes its element, the second one unpacks the block
+                if (cachedBlock == NoBlock) {
+                    cachedBlock = Touched;
+                    return (*column)[index];
+                }
+
+                if (buffer == nullptr) {
+                    buffer.reset(new T[PackedBlockSize]);
+                }
+
+                cachedBlock = index / PackedBlockSize;
+                column->unpack(cachedBlock, buffer.get());
+                return buffer[index % PackedBlockSize];
+            }
+
+            const PackedColumn<T> *column = nullptr;
+            std::size_t index = 0;
+            mutable std::size_t cachedBlock = NoBlock;
+            mutable std::unique_ptr<T[]> buffer;
+        };
+
+        /**
+         * @brief Read-only bit-packed integer column with frame-of-reference encoding
+         * @tparam T integral element type
+         */
+        template<typename T>
+        class PackedColumn {
+            static_assert(std::is_integral_v<T> && not std::is_same_v<T, bool>,
+                          "packed columns require integral element types");
+            using U = std::make_unsigned_t<T>;
+        public:
+            using value_type = T;
+            using iterator = PackedIterator<T>;
+            using const_iterator = PackedIterator<T>;
+
+            PackedColumn() = default;
+
+            /**
+             * CTor. Packs a range of integers
+             * @tparam Range input range type
+             * @param values range of values convertible to T
+             */
+            template<typename Range>
+            explicit PackedColumn(const Range &values) {
+                std::array<T, PackedBlockSize> block{};
+                std::size_t fill = 0;
+                for (const auto &value : values) {
+                    block[fill++] = static_cast<T>(value);
+                    if (fill == PackedBlockSize) {
+                        pack(block.data(), fill);
+                        fill = 0;
+                    }
+                }
+
+                if (fill > 0) {
+                    pack(block.data(), fill);
+                }
+
+                // padding for the loads of packed_extract and the vector loads of packed_unpack
+                words.resize(words.size() + 3 * PackedLanes, 0);
+                words.shrink_to_fit();
+                blocks.shrink_to_fit();
+            }
+
+            const_iterator begin() const noexcept {
+                return const_iterator(this, 0);
+            }
+
+            const_iterator end() const noexcept {
+                return const_iterator(this, length);
+            }
+
+            /**
+             * @return number of values
+             */
+            [[nodiscard]] std::size_t size() const noexcept {
+                return length;
+            }
+
+            /**
+             * @return true if the column is empty
+             */
+            [[nodiscard]] bool empty() const noexcept {
+                return length == 0;
+            }
+
+            /**
+             * Array subscript operator. Decodes a single value in O(1) (no bounds are checked)
+             * @param index position
+             * @return value at index
+             */
+            T operator[](std::size_t index) const noexcept {
+                const auto &block = blocks[index / PackedBlockSize];
+                return static_cast<T>(static_cast<U>(static_cast<U>(block.base) + packed_extract(
+                        words.data() + block.offset, block.width, index % PackedBlockSize)));
+            }
+
+            /**
+             * Unpacks a block of PackedBlockSize values. Values of the last block beyond size() are unspecified
+             * @param block block index
+             * @param out output buffer with room for PackedBlockSize values
+             */
+            void unpack(std::size_t block, T *out) const noexcept {
+                const auto &header = blocks[block];
+                packed_unpack(header, words.data() + header.offset, out);
+            }
+
+            /**
+             * @return number of blocks
+             */
+            [[nodiscard]] std::size_t blockCount() const noexcept {
+                return blocks.size();
+            }
+
+            /**
+             * @param block block index
+             * @return number of bits per value in the block
+             */
+            [[nodiscard]] unsigned bitWidth(std::size_t block) const noexcept {
+                return blocks[block].width;
+            }
+
+            /**
+             * @return number of bytes used by the packed values and the block headers
+             */
+            [[nodiscard]] std::size_t memoryUsage() const noexcept {
+                return words.size() * sizeof(std::uint32_t) + blocks.size() * sizeof(PackedBlock<T>);
+            }
+
+        private:
+            void pack(const T *values, std::size_t count) {
+                const auto [min, max] = std::minmax_element(values, values + count);
+                const PackedBlock<T> header{*min, words.size(),
+                                            packed_width(static_cast<U>(static_cast<U>(*max) - static_cast<U>(*min)))};
+                blocks.push_back(header);
+                length += count;
+                // each lane stores PackedBlockSize / PackedLanes values, i.e. width 32 bit words
+                const auto first = words.size();
+                words.resize(first + header.width * PackedLanes, 0);
+                for (std::size_t i = 0; i < count && header.width > 0; ++i) {
+                    const std::uint64_t delta = static_cast<U>(static_cast<U>(values[i]) - static_cast<U>(*min));
+                    const auto bit = (i / PackedLanes) * header.width;
+                    auto word = first + (bit / 32) * PackedLanes + i % PackedLanes;
+                    const auto shift = static_cast<unsigned>(bit % 32);
+                    words[word] |= static_cast<std::uint32_t>(delta << shift);
+                    for (auto written = 32 - shift; written < header.width; written += 32) {
+                        word += PackedLanes;
+                        words[word] |= static_cast<std::uint32_t>(delta >> written);
+                    }
+                }
+            }
+
+            std::vector<std::uint32_t> words;
+            std::vector<PackedBlock<T>> blocks;
+            std::size_t length = 0;
+        };
+    }
+
+    /**
+     * Creates a bit-packed copy of a range of integers. Each block of 128 values stores its minimum and the
+     * differences to it with the smallest sufficient bit width, so columns of ids or small deltas shrink by the ratio
+     * of sizeof(T) * 8 to that width. The column is read-only and can be used as zip column. Scans unpack one block
+     * at a time.
+     * @code
+     * auto ids = packed_column(rawIds);
+     * for (auto [id, price] : zip(ids, prices)) { ... }
+     * @endcode
+     * @tparam T integral element type (default: value type of the range)
+     * @tparam Range input range type
+     * @param values range of integers
+     * @return impl::PackedColumn
+     * @relatesalso impl::PackedColumn
+     */
+    template<typename T = void, typename Range>
+    auto packed_column(const Range &values) {
+        using Value = std::conditional_t<std::is_void_v<T>, std::remove_cv_t<std::remove_reference_t<
+                decltype(*std::begin(values))>>, T>;
+        return impl::PackedColumn<Value>(values);
+    }
+}
+
+#endif //ITERATORTOOLS_PACKEDCOLUMN_HPP
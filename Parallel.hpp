@@ -0,0 +1,763 @@
+/**
+ * @file Parallel.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains parallel algorithms for random access (zipped) ranges. The work is split into contiguous
+ * chunks that are processed by the global impl::ThreadPool. No external threading library is required.
+ */
+
+#ifndef ITERATORTOOLS_PARALLEL_HPP
+#define ITERATORTOOLS_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Iterators.hpp"
+#include "Algorithms.hpp"
+#include "ThreadPool.hpp"
+
+namespace iterators {
+
+    /**
+     * @brief Controls how parallel reductions split the work and combine partial results
+     */
+    enum class Combine {
+        /**
+         * One chunk per thread. The result depends on the number of threads for non-associative operations
+         */
+        Fast,
+        /**
+         * Chunks of fixed size (impl::DeterministicChunkSize) that are combined in order. The result only depends on
+         * the input, which makes floating point reductions reproducible across machines
+         */
+        Deterministic
+    };
+
+    namespace impl {
+        /**
+         * Minimum number of elements per chunk
+         */
+        constexpr inline std::size_t MinChunkSize = std::size_t(1) << 14;
+
+        /**
+         * Number of elements per chunk in deterministic mode
+         */
+        constexpr inline std::size_t DeterministicChunkSize = std::size_t(1) << 15;
+
+        /**
+         * @brief Value padded to a full cache line to avoid false sharing between threads
+         * @tparam T value type
+         */
+        template<typename T>
+        struct alignas(CacheLineSize) Padded {
+            T value;
+        };
+
+        /**
+         * @param count number of elements
+         * @param combine chunking mode
+         * @return number of elements per chunk
+         */
+        inline std::size_t chunk_size(std::size_t count, Combine combine) {
+            if (combine == Combine::Deterministic) {
+                return DeterministicChunkSize;
+            }
+
+            auto threads = ThreadPool::instance().concurrency();
+            return std::max((count + threads - 1) / threads, MinChunkSize);
+        }
+
+        template<typename Range>
+        auto parallel_bounds(Range &range) {
+            auto first = std::begin(range);
+            static_assert(traits::is_random_accessible_v<decltype(first)>,
+                          "parallel algorithms require random access ranges");
+            auto count = static_cast<std::size_t>(impl::distance(first, std::end(range)));
+            return std::make_pair(first, count);
+        }
+
+        template<std::size_t K, typename Iterator, typename T, typename ReduceOp, typename MapOp>
+        T chunked_transform_reduce(const Iterator &first, std::size_t count, std::size_t chunkSize, T init,
+                                   ReduceOp &reduceOp, MapOp &mapOp) {
+            using Difference = typename std::iterator_traits<Iterator>::difference_type;
+            const auto numChunks = (count + chunkSize - 1) / chunkSize;
+            std::vector<Padded<std::optional<T>>> partials(numChunks);
+            ThreadPool::instance().run(numChunks, [&](std::size_t chunk) {
+                auto begin = first + static_cast<Difference>(chunk * chunkSize);
+                auto end = first + static_cast<Difference>(std::min(count, (chunk + 1) * chunkSize));
+                T seed = mapOp(*begin);
+                ++begin;
+                partials[chunk].value.emplace(transform_reduce_range<K>(begin, end, std::move(seed), reduceOp, mapOp));
+            });
+
+            for (auto &partial : partials) {
+                init = reduceOp(std::move(init), std::move(*partial.value));
+            }
+
+            return init;
+        }
+    }
+
+    /**
+     * Parallel version of transform_reduce. The range is split into contiguous chunks that are reduced concurrently
+     * (each one with K accumulators and SIMD kernels where possible). The padded per-chunk partial results are
+     * combined in chunk order on the calling thread.
+     * @tparam K number of independent accumulators per chunk (default 4)
+     * @tparam Range random access range type, e.g. impl::ZipView or the range returned by counter_range. Zipped
+     * ranges can contain infinite columns (e.g. from enumerate) as long as one column is bounded
+     * @tparam T accumulator type
+     * @tparam ReduceOp binary reduction operation. Must be associative, commutative and safe to call concurrently
+     * @tparam MapOp unary mapping operation. Must be safe to call concurrently
+     * @param range input range
+     * @param init initial value
+     * @param reduceOp reduction operation
+     * @param mapOp mapping operation applied to each element
+     * @param combine chunking mode. Use Combine::Deterministic for reproducible floating point results
+     * @return init reduced with all mapped elements
+     * @throws the first exception thrown by reduceOp or mapOp
+     */
+    template<std::size_t K = 4, typename Range, typename T, typename ReduceOp, typename MapOp>
+    T parallel_transform_reduce(Range &&range, T init, ReduceOp reduceOp, MapOp mapOp,
+                                Combine combine = Combine::Fast) {
+        auto [first, count] = impl::parallel_bounds(range);
+        if (count == 0) {
+            return init;
+        }
+
+        return impl::chunked_transform_reduce<K>(first, count, impl::chunk_size(count, combine), std::move(init),
+                                                 reduceOp, mapOp);
+    }
+
+    /**
+     * Parallel version of reduce. See parallel_transform_reduce for details
+     * @tparam K number of independent accumulators per chunk (default 4)
+     * @tparam Range random access range type
+     * @tparam T accumulator type
+     * @tparam ReduceOp binary reduction operation. Must be associative, commutative and safe to call concurrently
+     * @param range input range
+     * @param init initial value
+     * @param reduceOp reduction operation (default std::plus)
+     * @param combine chunking mode. Use Combine::Deterministic for reproducible floating point results
+     * @return init reduced with all elements
+     */
+    template<std::size_t K = 4, typename Range, typename T, typename ReduceOp = std::plus<>>
+    T parallel_reduce(Range &&range, T init, ReduceOp reduceOp = {}, Combine combine = Combine::Fast) {
+        return parallel_transform_reduce<K>(std::forward<Range>(range), std::move(init), std::move(reduceOp),
+                                            impl::Identity{}, combine);
+    }
+
+    namespace impl {
+        /**
+         * Number of elements below which sorting is done serially
+         */
+        constexpr inline std::size_t MinParallelSortSize = std::size_t(1) << 15;
+
+        /**
+         * Granularity of chunks that write to columns concurrently. A multiple of the word size of std::vector<bool>
+         * so that threads never write to the same word
+         */
+        constexpr inline std::size_t ChunkGranularity = 1024;
+
+        /**
+         * Splits [0, count) into chunks of roughly equal size that are multiples of ChunkGranularity and invokes
+         * function(begin, end) for each chunk using the global thread pool
+         * @param count number of elements
+         * @param function function to call for each chunk
+         */
+        template<typename Function>
+        void parallel_for_chunks(std::size_t count, Function &&function) {
+            auto &pool = ThreadPool::instance();
+            auto chunkSize = (count + pool.concurrency() - 1) / pool.concurrency();
+            chunkSize = std::max((chunkSize + ChunkGranularity - 1) / ChunkGranularity * ChunkGranularity,
+                                 ChunkGranularity);
+            pool.run((count + chunkSize - 1) / chunkSize, [&](std::size_t chunk) {
+                function(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+            });
+        }
+
+        /**
+         * @brief Key of a row together with its original position
+         */
+        template<typename Key>
+        struct SortEntry {
+            Key key;
+            std::size_t index;
+        };
+
+        /**
+         * Finds the split of a merge path diagonal
+         * @return number of elements taken from the first range among the first diagonal elements of the merged
+         * output
+         */
+        template<typename Iterator, typename Compare>
+        std::size_t merge_path_split(Iterator first, std::size_t firstSize, Iterator second, std::size_t secondSize,
+                                     std::size_t diagonal, Compare &comp) {
+            auto low = diagonal > secondSize ? diagonal - secondSize : 0;
+            auto high = std::min(diagonal, firstSize);
+            while (low < high) {
+                auto mid = low + (high - low) / 2;
+                if (comp(second[diagonal - mid - 1], first[mid])) {
+                    high = mid;
+                } else {
+                    low = mid + 1;
+                }
+            }
+
+            return low;
+        }
+
+        /**
+         * Stable parallel merge sort. Sorted runs are merged pairwise, each merge is split into independent parts
+         * using merge path partitioning
+         * @param entries entries to sort
+         * @param comp strict weak ordering
+         */
+        template<typename T, typename Compare>
+        void parallel_merge_sort(std::vector<T> &entries, Compare comp) {
+            auto &pool = ThreadPool::instance();
+            const auto count = entries.size();
+            std::size_t numRuns = 1;
+            while (numRuns < pool.concurrency() && count / (numRuns * 2) >= MinParallelSortSize / 2) {
+                numRuns *= 2;
+            }
+
+            auto runBegin = [count, numRuns](std::size_t run) { return run * count / numRuns; };
+            pool.run(numRuns, [&](std::size_t run) {
+                std::sort(entries.begin() + static_cast<std::ptrdiff_t>(runBegin(run)),
+                          entries.begin() + static_cast<std::ptrdiff_t>(runBegin(run + 1)), comp);
+            });
+
+            if (numRuns == 1) {
+                return;
+            }
+
+            std::vector<T> buffer(count);
+            auto *source = &entries;
+            auto *target = &buffer;
+            for (std::size_t width = 1; width < numRuns; width *= 2) {
+                const auto numMerges = numRuns / (2 * width);
+                const auto parts = std::max<std::size_t>(pool.concurrency() / numMerges, 1);
+                pool.run(numMerges * parts, [&](std::size_t task) {
+                    auto merge = task / parts;
+                    auto part = task % parts;
+                    auto begin = runBegin(2 * merge * width);
+                    auto middle = runBegin((2 * merge + 1) * width);
+                    auto end = runBegin((2 * merge + 2) * width);
+                    auto first = source->begin() + static_cast<std::ptrdiff_t>(begin);
+                    auto second = source->begin() + static_cast<std::ptrdiff_t>(middle);
+                    auto firstSize = middle - begin;
+                    auto secondSize = end - middle;
+                    auto diagonalBegin = part * (end - begin) / parts;
+                    auto diagonalEnd = (part + 1) * (end - begin) / parts;
+                    auto splitBegin = merge_path_split(first, firstSize, second, secondSize, diagonalBegin, comp);
+                    auto splitEnd = merge_path_split(first, firstSize, second, secondSize, diagonalEnd, comp);
+                    std::merge(std::make_move_iterator(first + static_cast<std::ptrdiff_t>(splitBegin)),
+                               std::make_move_iterator(first + static_cast<std::ptrdiff_t>(splitEnd)),
+                               std::make_move_iterator(second + static_cast<std::ptrdiff_t>(diagonalBegin - splitBegin)),
+                               std::make_move_iterator(second + static_cast<std::ptrdiff_t>(diagonalEnd - splitEnd)),
+                               target->begin() + static_cast<std::ptrdiff_t>(begin + diagonalBegin), comp);
+                });
+
+                std::swap(source, target);
+            }
+
+            if (source != &entries) {
+                entries.swap(buffer);
+            }
+        }
+
+        /**
+         * Rearranges a column according to a permutation such that column[i] = old column[permutation[i]]
+         * @param column random access iterator to the first element of the column
+         * @param permutation permutation of [0, permutation.size())
+         */
+        template<typename Iterator>
+        void parallel_permute(Iterator column, const std::vector<std::size_t> &permutation) {
+            using Value = typename std::iterator_traits<Iterator>::value_type;
+            static_assert(std::is_nothrow_move_constructible_v<Value>, "column values must be nothrow movable");
+            const auto count = permutation.size();
+            std::unique_ptr<Value[], void (*)(Value *)> buffer(
+                    static_cast<Value *>(::operator new[](count * sizeof(Value), std::align_val_t(alignof(Value)))),
+                    [](Value *pointer) { ::operator delete[](pointer, std::align_val_t(alignof(Value))); });
+            parallel_for_chunks(count, [&](std::size_t begin, std::size_t end) {
+                for (auto i = begin; i < end; ++i) {
+                    ::new(static_cast<void *>(buffer.get() + i)) Value(
+                            std::move(column[static_cast<std::ptrdiff_t>(permutation[i])]));
+                }
+            });
+
+            parallel_for_chunks(count, [&](std::size_t begin, std::size_t end) {
+                for (auto i = begin; i < end; ++i) {
+                    column[static_cast<std::ptrdiff_t>(i)] = std::move(buffer[i]);
+                    buffer[i].~Value();
+                }
+            });
+        }
+
+        template<typename Iterators, std::size_t ...Idx>
+        void permute_columns(const Iterators &columns, const std::vector<std::size_t> &permutation,
+                             std::index_sequence<Idx...>) {
+            (parallel_permute(std::get<Idx>(columns), permutation), ...);
+        }
+    }
+
+    /**
+     * Sorts the rows of a zipped range by one of its columns in parallel. The keys are copied together with their
+     * row indices and sorted using a parallel merge sort. Then, all columns are permuted in parallel. The sort is
+     * stable.
+     * @tparam KeyIdx index of the key column (default 0)
+     * @tparam ZipRange zipped random access range type (e.g. impl::ZipView). All columns must be assignable
+     * @tparam Compare comparison function type
+     * @param zipRange rows to sort
+     * @param comp strict weak ordering of the key values (default std::less)
+     * @note Columns are permuted in chunks that are multiples of impl::ChunkGranularity elements, which makes
+     * std::vector<bool> columns safe to use.
+     */
+    template<std::size_t KeyIdx = 0, typename ZipRange, typename Compare = std::less<>>
+    void parallel_zip_sort(ZipRange &&zipRange, Compare comp = {}) {
+        auto [first, count] = impl::parallel_bounds(zipRange);
+        const auto &columns = first.getIterators();
+        using Iterators = std::remove_cv_t<std::remove_reference_t<decltype(columns)>>;
+        auto keyColumn = std::get<KeyIdx>(columns);
+        using Key = typename std::iterator_traits<decltype(keyColumn)>::value_type;
+        using Entry = impl::SortEntry<Key>;
+        std::vector<Entry> entries(count);
+        impl::parallel_for_chunks(count, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                entries[i] = Entry{keyColumn[static_cast<std::ptrdiff_t>(i)], i};
+            }
+        });
+
+        impl::parallel_merge_sort(entries, [&comp](const Entry &lhs, const Entry &rhs) {
+            if (comp(lhs.key, rhs.key)) {
+                return true;
+            }
+
+            return not comp(rhs.key, lhs.key) && lhs.index < rhs.index;
+        });
+
+        std::vector<std::size_t> permutation(count);
+        impl::parallel_for_chunks(count, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                permutation[i] = entries[i].index;
+            }
+        });
+
+        entries = std::vector<Entry>();
+        impl::permute_columns(columns, permutation, std::make_index_sequence<std::tuple_size_v<Iterators>>());
+    }
+
+    namespace impl {
+        /**
+         * Number of elements per chunk of parallel searches. Chunks are handed out in ascending order, so smaller
+         * chunks mean less wasted work after a match has been found
+         */
+        constexpr inline std::size_t SearchChunkSize = std::size_t(1) << 12;
+
+        /**
+         * Searches [first, first + count) in parallel. The position of the best match found so far is published
+         * through an atomic. Chunks beyond it are skipped and running scans stop at the next check
+         * @tparam FirstMatch if true, the first match is searched. Otherwise, the search stops at any match
+         * @return position of the first (or any) match or count if there is no match
+         */
+        template<bool FirstMatch, typename Iterator, typename Predicate>
+        std::size_t parallel_find_index(const Iterator &first, std::size_t count, Predicate &pred) {
+            using Difference = typename std::iterator_traits<Iterator>::difference_type;
+            std::atomic<std::size_t> best{count};
+            auto publish = [&best](std::size_t position) {
+                auto current = best.load(std::memory_order_relaxed);
+                while (position < current && not best.compare_exchange_weak(current, position,
+                                                                            std::memory_order_relaxed)) {}
+            };
+
+            constexpr std::size_t CheckInterval = 256;
+            ThreadPool::instance().run((count + SearchChunkSize - 1) / SearchChunkSize, [&](std::size_t chunk) {
+                auto begin = chunk * SearchChunkSize;
+                auto end = std::min(count, begin + SearchChunkSize);
+                auto it = first + static_cast<Difference>(begin);
+                for (auto position = begin; position < end; ++position, ++it) {
+                    if (position % CheckInterval == 0) {
+                        auto current = best.load(std::memory_order_relaxed);
+                        if (FirstMatch ? position >= current : current != count) {
+                            return;
+                        }
+                    }
+
+                    if (pred(*it)) {
+                        publish(position);
+                        return;
+                    }
+                }
+            });
+
+            return best.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Parallel version of std::find_if. The range is split into small chunks that are processed in ascending order.
+     * Once a match has been found, chunks after it are skipped, the result is still the first match
+     * @tparam Range random access range type (e.g. impl::ZipView)
+     * @tparam Predicate unary predicate type. Must be safe to call concurrently
+     * @param range range to search
+     * @param pred predicate that is invoked with the range elements
+     * @return iterator to the first element that satisfies pred or begin + size if there is none
+     */
+    template<typename Range, typename Predicate>
+    auto parallel_find_if(Range &&range, Predicate pred) {
+        auto [first, count] = impl::parallel_bounds(range);
+        using Difference = typename std::iterator_traits<decltype(first)>::difference_type;
+        return first + static_cast<Difference>(impl::parallel_find_index<true>(first, count, pred));
+    }
+
+    /**
+     * Parallel version of std::any_of. All threads stop as soon as any match has been found
+     * @tparam Range random access range type (e.g. impl::ZipView)
+     * @tparam Predicate unary predicate type. Must be safe to call concurrently
+     * @param range range to search
+     * @param pred predicate that is invoked with the range elements
+     * @return true if at least one element satisfies pred
+     */
+    template<typename Range, typename Predicate>
+    bool parallel_any_of(Range &&range, Predicate pred) {
+        auto [first, count] = impl::parallel_bounds(range);
+        return impl::parallel_find_index<false>(first, count, pred) != count;
+    }
+
+    namespace impl {
+        /**
+         * Two-pass parallel prefix scan over the mapped elements. The first pass reduces each chunk, the partial
+         * results are scanned serially and the second pass scans each chunk starting from its offset. The output may
+         * alias the input.
+         * @tparam Inclusive inclusive or exclusive scan
+         * @return output iterator to the element following the last written element
+         */
+        template<bool Inclusive, typename T, typename Iterator, typename OutputIterator, typename ReduceOp,
+                 typename MapOp>
+        OutputIterator parallel_scan(const Iterator &first, std::size_t count, OutputIterator out,
+                                     std::optional<T> init, ReduceOp &reduceOp, MapOp &mapOp, Combine combine) {
+            static_assert(traits::is_random_accessible_v<OutputIterator>,
+                          "parallel scans require a random access output");
+            using Difference = typename std::iterator_traits<Iterator>::difference_type;
+            using OutDifference = typename std::iterator_traits<OutputIterator>::difference_type;
+            const auto chunkSize = chunk_size(count, combine);
+            const auto numChunks = (count + chunkSize - 1) / chunkSize;
+            auto scanChunk = [&](std::size_t chunk, std::optional<T> accumulator) {
+                auto begin = chunk * chunkSize;
+                auto end = std::min(count, begin + chunkSize);
+                auto it = first + static_cast<Difference>(begin);
+                auto dest = out + static_cast<OutDifference>(begin);
+                for (auto i = begin; i < end; ++i, ++it, ++dest) {
+                    // the next accumulation is computed before writing since the output may alias the input
+                    T next = next_accumulation<Inclusive>(accumulator, mapOp(*it), reduceOp);
+                    if constexpr (Inclusive) {
+                        *dest = next;
+                    } else {
+                        *dest = std::move(*accumulator);
+                    }
+
+                    accumulator = std::move(next);
+                }
+            };
+
+            if (numChunks <= 1) {
+                scanChunk(0, std::move(init));
+                return out + static_cast<OutDifference>(count);
+            }
+
+            std::vector<Padded<std::optional<T>>> partials(numChunks - 1);
+            auto &pool = ThreadPool::instance();
+            pool.run(numChunks - 1, [&](std::size_t chunk) {
+                auto begin = first + static_cast<Difference>(chunk * chunkSize);
+                auto end = first + static_cast<Difference>((chunk + 1) * chunkSize);
+                T sum(mapOp(*begin));
+                for (auto it = std::next(begin); it != end; ++it) {
+                    sum = reduceOp(std::move(sum), mapOp(*it));
+                }
+
+                partials[chunk].value = std::move(sum);
+            });
+
+            std::vector<std::optional<T>> offsets(numChunks);
+            offsets.front() = std::move(init);
+            for (std::size_t chunk = 1; chunk < numChunks; ++chunk) {
+                offsets[chunk] = next_accumulation<true>(offsets[chunk - 1], *partials[chunk - 1].value, reduceOp);
+            }
+
+            pool.run(numChunks, [&](std::size_t chunk) { scanChunk(chunk, std::move(offsets[chunk])); });
+            return out + static_cast<OutDifference>(count);
+        }
+    }
+
+    /**
+     * Parallel inclusive prefix scan over mapped elements. Writes the accumulation of the mapped elements 0 to i of
+     * the range to out[i]. Uses two passes over the input: chunk reductions followed by chunk scans.
+     * @tparam Range random access range type (e.g. impl::ZipView)
+     * @tparam OutputIterator random access output iterator type
+     * @tparam ReduceOp binary operation type. Must be associative and safe to call concurrently
+     * @tparam MapOp unary mapping operation type. Must be safe to call concurrently
+     * @param range input range
+     * @param out beginning of the destination range. May be the beginning of the input range
+     * @param reduceOp binary operation
+     * @param mapOp mapping operation applied to each element
+     * @param combine chunking mode. Use Combine::Deterministic for reproducible floating point results
+     * @return output iterator to the element following the last written element
+     */
+    template<typename Range, typename OutputIterator, typename ReduceOp, typename MapOp>
+    OutputIterator parallel_transform_inclusive_scan(Range &&range, OutputIterator out, ReduceOp reduceOp,
+                                                     MapOp mapOp, Combine combine = Combine::Fast) {
+        auto [first, count] = impl::parallel_bounds(range);
+        using Mapped = decltype(mapOp(*first));
+        using T = std::decay_t<std::invoke_result_t<ReduceOp &, Mapped, Mapped>>;
+        return impl::parallel_scan<true, T>(first, count, std::move(out), std::nullopt, reduceOp, mapOp, combine);
+    }
+
+    /**
+     * Parallel exclusive prefix scan over mapped elements. Writes init accumulated with the mapped elements 0 to
+     * i - 1 of the range to out[i]. Uses two passes over the input: chunk reductions followed by chunk scans.
+     * @tparam Range random access range type (e.g. impl::ZipView)
+     * @tparam OutputIterator random access output iterator type
+     * @tparam T accumulator type
+     * @tparam ReduceOp binary operation type. Must be associative and safe to call concurrently
+     * @tparam MapOp unary mapping operation type. Must be safe to call concurrently
+     * @param range input range
+     * @param out beginning of the destination range. May be the beginning of the input range
+     * @param init initial value
+     * @param reduceOp binary operation
+     * @param mapOp mapping operation applied to each element
+     * @param combine chunking mode. Use Combine::Deterministic for reproducible floating point results
+     * @return output iterator to the element following the last written element
+     */
+    template<typename Range, typename OutputIterator, typename T, typename ReduceOp, typename MapOp>
+    OutputIterator parallel_transform_exclusive_scan(Range &&range, OutputIterator out, T init, ReduceOp reduceOp,
+                                                     MapOp mapOp, Combine combine = Combine::Fast) {
+        auto [first, count] = impl::parallel_bounds(range);
+        return impl::parallel_scan<false, T>(first, count, std::move(out), std::optional<T>(std::move(init)),
+                                             reduceOp, mapOp, combine);
+    }
+
+    /**
+     * Parallel inclusive prefix scan. Writes the accumulation of the elements 0 to i of the range to out[i].
+     * See parallel_transform_inclusive_scan for details
+     * @tparam Range random access range type
+     * @tparam OutputIterator random access output iterator type
+     * @tparam Op binary operation type. Must be associative and safe to call concurrently
+     * @param range input range
+     * @param out beginning of the destination range. May be the beginning of the input range
+     * @param op binary operation (default std::plus)
+     * @param combine chunking mode. Use Combine::Deterministic for reproducible floating point results
+     * @return output iterator to the element following the last written element
+     */
+    template<typename Range, typename OutputIterator, typename Op = std::plus<>>
+    OutputIterator parallel_inclusive_scan(Range &&range, OutputIterator out, Op op = {},
+                                           Combine combine = Combine::Fast) {
+        return parallel_transform_inclusive_scan(std::forward<Range>(range), std::move(out), std::move(op),
+                                                 impl::Identity{}, combine);
+    }
+
+    /**
+     * Parallel exclusive prefix scan. Writes init accumulated with the elements 0 to i - 1 of the range to out[i].
+     * See parallel_transform_exclusive_scan for details
+     * @tparam Range random access range type
+     * @tparam OutputIterator random access output iterator type
+     * @tparam T accumulator type
+     * @tparam Op binary operation type. Must be associative and safe to call concurrently
+     * @param range input range
+     * @param out beginning of the destination range. May be the beginning of the input range
+     * @param init initial value
+     * @param op binary operation (default std::plus)
+     * @param combine chunking mode. Use Combine::Deterministic for reproducible floating point results
+     * @return output iterator to the element following the last written element
+     */
+    template<typename Range, typename OutputIterator, typename T, typename Op = std::plus<>>
+    OutputIterator parallel_exclusive_scan(Range &&range, OutputIterator out, T init, Op op = {},
+                                           Combine combine = Combine::Fast) {
+        return parallel_transform_exclusive_scan(std::forward<Range>(range), std::move(out), std::move(init),
+                                                 std::move(op), impl::Identity{}, combine);
+    }
+
+    namespace impl {
+        namespace traits {
+            template<typename Columns, std::size_t ...Idx>
+            constexpr bool has_plain_references(std::index_sequence<Idx...>) {
+                return (std::is_reference_v<typename std::iterator_traits<
+                        std::tuple_element_t<Idx, Columns>>::reference> && ...);
+            }
+
+            /**
+             * True if all columns of an iterator yield real references. Proxy references (e.g. bits of
+             * std::vector<bool>) may share memory between neighbouring elements
+             */
+            template<typename Iterator>
+            constexpr inline bool has_plain_references_v = has_plain_references<decltype(column_iterators(
+                    std::declval<const Iterator &>()))>(std::make_index_sequence<std::tuple_size_v<decltype(
+                    column_iterators(std::declval<const Iterator &>()))>>());
+        }
+    }
+
+    /**
+     * Parallel version of compact. The first pass evaluates the predicate into mask words and counts the selected
+     * rows per chunk. After an exclusive scan of the counts, the second pass compacts each chunk branch-free to its
+     * offset in the output.
+     * @tparam Range random access range type (e.g. impl::ZipView)
+     * @tparam Predicate unary predicate type. Must be safe to call concurrently
+     * @tparam OutRange random access output range type with the same number of columns as the input. Its columns
+     * must yield real references (no bit-packed columns)
+     * @param range input range
+     * @param pred predicate that is invoked with the rows of range
+     * @param out output range. Must have room for all selected rows and must not overlap the input
+     * @return iterator to the output row following the last written row
+     */
+    template<typename Range, typename Predicate, typename OutRange>
+    auto parallel_compact(Range &&range, Predicate pred, OutRange &&out) {
+        auto [first, count] = impl::parallel_bounds(range);
+        auto outFirst = std::begin(out);
+        using OutputIterator = decltype(outFirst);
+        using Difference = typename std::iterator_traits<decltype(first)>::difference_type;
+        using OutDifference = typename std::iterator_traits<OutputIterator>::difference_type;
+        static_assert(impl::traits::is_random_accessible_v<OutputIterator>,
+                      "parallel compaction requires a random access output");
+        static_assert(impl::traits::has_plain_references_v<OutputIterator>,
+                      "output columns must not use proxy references");
+        constexpr auto BlockSize = impl::CompactBlockSize;
+        // chunks consist of whole blocks so that each mask word belongs to exactly one chunk
+        const auto chunkSize = (impl::chunk_size(count, Combine::Fast) + BlockSize - 1) / BlockSize * BlockSize;
+        const auto numChunks = (count + chunkSize - 1) / chunkSize;
+        std::vector<std::uint64_t> masks((count + BlockSize - 1) / BlockSize);
+        std::vector<impl::Padded<std::size_t>> offsets(numChunks);
+        auto &pool = impl::ThreadPool::instance();
+        pool.run(numChunks, [&, first = first, count = count](std::size_t chunk) {
+            std::size_t selected = 0;
+            for (auto block = chunk * chunkSize; block < std::min(count, (chunk + 1) * chunkSize);
+                 block += BlockSize) {
+                auto mask = impl::predicate_mask(first + static_cast<Difference>(block),
+                                                 std::min(BlockSize, count - block), pred);
+                masks[block / BlockSize] = mask;
+                selected += impl::popcount(mask);
+            }
+
+            offsets[chunk].value = selected;
+        });
+
+        std::size_t total = 0;
+        for (auto &offset : offsets) {
+            total += std::exchange(offset.value, total);
+        }
+
+        pool.run(numChunks, [&, first = first, count = count](std::size_t chunk) {
+            auto written = offsets[chunk].value;
+            for (auto block = chunk * chunkSize; block < std::min(count, (chunk + 1) * chunkSize);
+                 block += BlockSize) {
+                written += impl::compact_block(first + static_cast<Difference>(block), masks[block / BlockSize],
+                                               outFirst + static_cast<OutDifference>(written));
+            }
+        });
+
+        return outFirst + static_cast<OutDifference>(total);
+    }
+
+    /**
+     * Parallel version of bucketize. Each chunk of the input computes its own histogram. The per-chunk histograms
+     * are combined into output positions such that the result is identical to the serial version. Then all chunks
+     * scatter their rows concurrently.
+     * @tparam KeyIdx index of the key column (default 0)
+     * @tparam Range random access range type (e.g. impl::ZipView)
+     * @tparam OutRange random access output range type with the same number of columns as the input. Its columns
+     * must yield real references (no bit-packed columns)
+     * @tparam BucketFn function type that maps keys to bucket indices. Must be safe to call concurrently
+     * @param range input range
+     * @param numBuckets number of buckets
+     * @param out output range. Must have room for all rows and must not overlap the input
+     * @param bucketFn function that maps a key to a bucket index in [0, numBuckets) (default: the key itself)
+     * @return bucket offsets (numBuckets + 1 values). Bucket i occupies the output rows [offsets[i], offsets[i + 1])
+     */
+    template<std::size_t KeyIdx = 0, typename Range, typename OutRange, typename BucketFn = impl::Identity>
+    std::vector<std::size_t> parallel_bucketize(Range &&range, std::size_t numBuckets, OutRange &&out,
+                                                BucketFn bucketFn = {}) {
+        auto [first, count] = impl::parallel_bounds(range);
+        auto outFirst = std::begin(out);
+        static_assert(impl::traits::is_random_accessible_v<decltype(outFirst)>,
+                      "parallel bucketize requires a random access output");
+        static_assert(impl::traits::has_plain_references_v<decltype(outFirst)>,
+                      "output columns must not use proxy references");
+        const auto chunkSize = impl::chunk_size(count, Combine::Fast);
+        const auto numChunks = (count + chunkSize - 1) / chunkSize;
+        std::vector<std::size_t> histograms(numChunks * numBuckets);
+        auto &pool = impl::ThreadPool::instance();
+        pool.run(numChunks, [&, first = first, count = count](std::size_t chunk) {
+            impl::bucket_histogram<KeyIdx>(first, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize),
+                                           histograms.data() + chunk * numBuckets, bucketFn);
+        });
+
+        std::vector<std::size_t> offsets(numBuckets + 1);
+        std::size_t position = 0;
+        for (std::size_t bucket = 0; bucket < numBuckets; ++bucket) {
+            offsets[bucket] = position;
+            for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+                position += std::exchange(histograms[chunk * numBuckets + bucket], position);
+            }
+        }
+
+        offsets.back() = position;
+        pool.run(numChunks, [&, first = first, count = count](std::size_t chunk) {
+            impl::scatter_rows<KeyIdx>(first, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize), outFirst,
+                                       histograms.data() + chunk * numBuckets, numBuckets, bucketFn);
+        });
+
+        return offsets;
+    }
+
+    /**
+     * Parallel version of top_k. Every chunk of the input selects its k first rows in its own heap of row indices.
+     * The candidates of all chunks are merged serially. The result is identical to the serial version.
+     * @tparam Range random access range type (e.g. impl::ZipView)
+     * @tparam Compare row comparison type. Must be safe to call concurrently
+     * @param range input range. Temporaries are moved into the result
+     * @param k number of rows to select
+     * @param comp strict weak ordering of the rows (default std::less, which selects the k smallest rows)
+     * @return impl::IndexedView over range that contains the min(k, size) first rows in sorted order
+     */
+    template<typename Range, typename Compare = std::less<>>
+    auto parallel_top_k(Range &&range, std::size_t k, Compare comp = {}) {
+        auto [first, count] = impl::parallel_bounds(range);
+        const auto chunkSize = impl::chunk_size(count, Combine::Fast);
+        const auto numChunks = (count + chunkSize - 1) / chunkSize;
+        std::vector<std::vector<std::size_t>> heaps(numChunks);
+        impl::ThreadPool::instance().run(numChunks, [&, first = first, count = count](std::size_t chunk) {
+            std::vector<std::size_t> heap;
+            heap.reserve(std::min(k, chunkSize));
+            impl::top_k_heap(first, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize), k, comp, heap);
+            heaps[chunk] = std::move(heap);
+        });
+
+        std::size_t numCandidates = 0;
+        for (const auto &heap : heaps) {
+            numCandidates += heap.size();
+        }
+
+        std::vector<std::size_t> rows;
+        rows.reserve(numCandidates);
+        for (const auto &heap : heaps) {
+            rows.insert(rows.end(), heap.begin(), heap.end());
+        }
+
+        const auto selected = std::min(k, rows.size());
+        std::partial_sort(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(selected), rows.end(),
+                          impl::RowOrder<decltype(first), Compare>{first, &comp});
+        rows.resize(selected);
+        return indexed(std::forward<Range>(range), std::move(rows));
+    }
+}
+
+#endif //ITERATORTOOLS_PARALLEL_HPP
@@ -0,0 +1,419 @@
+/**
+ * @file Prefetch.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains software prefetching range adaptors. While iterating, they issue prefetch instructions
+ * for elements a fixed number of steps ahead. Variants exist that prefetch the pointee of pointer ranges and the
+ * table entries referenced by index ranges. The adaptors can be used as zip columns.
+ */
+
+#ifndef ITERATORTOOLS_PREFETCH_HPP
+#define ITERATORTOOLS_PREFETCH_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include "Iterators.hpp"
+
+namespace iterators {
+    namespace impl {
+
+        /**
+         * Issues a read prefetch for the given address. Prefetching never faults, invalid addresses are ignored
+         * @param address address to prefetch
+         */
+        inline void prefetch_address(const void *address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(address, 0, 3);
+#else
+            (void) address;
+#endif
+        }
+
+        namespace traits {
+            template<typename T, typename = std::void_t<>>
+            struct has_get : std::false_type {};
+
+            template<typename T>
+            struct has_get<T, std::void_t<decltype(std::declval<const T &>().get())>> : std::true_type {};
+        }
+
+        /**
+         * Address of the object a pointer-like value refers to. Does not access the pointee for raw and smart
+         * pointers
+         * @tparam Pointer pointer type (raw pointer, smart pointer or iterator)
+         * @param pointer pointer-like value
+         * @return address of the pointee
+         */
+        template<typename Pointer>
+        constexpr const void *pointee_address(const Pointer &pointer) noexcept {
+            if constexpr (std::is_pointer_v<Pointer>) {
+                return static_cast<const void *>(pointer);
+            } else if constexpr (traits::has_get<Pointer>::value) {
+                return static_cast<const void *>(pointer.get());
+            } else {
+                return static_cast<const void *>(std::addressof(*pointer));
+            }
+        }
+
+        /**
+         * @brief Prefetch target: the element itself. Nothing is prefetched for proxy references
+         */
+        struct ElementTarget {
+            template<typename Iterator>
+            constexpr const void *operator()(const Iterator &it) const noexcept {
+                if constexpr (std::is_lvalue_reference_v<decltype(*it)>) {
+                    return static_cast<const void *>(std::addressof(*it));
+                } else {
+                    return nullptr;
+                }
+            }
+        };
+
+        /**
+         * @brief Prefetch target: the object the element points to
+         */
+        struct PointeeTarget {
+            template<typename Iterator>
+            constexpr const void *operator()(const Iterator &it) const noexcept {
+                return pointee_address(*it);
+            }
+        };
+
+        /**
+         * @brief Prefetch target: the table entry the element indexes
+         * @tparam TableIterator random access iterator to the first table entry
+         */
+        template<typename TableIterator>
+        struct GatherTarget {
+            template<typename Iterator>
+            constexpr const void *operator()(const Iterator &it) const noexcept {
+                return static_cast<const void *>(std::addressof(table[static_cast<std::ptrdiff_t>(*it)]));
+            }
+
+            TableIterator table;
+        };
+
+        /**
+         * @brief Iterator that runs Distance steps ahead of a PrefetchIterator over a non random access range
+         * @tparam Iterator underlying iterator type
+         * @tparam RandomAccess whether Iterator is random access. Random access iterators compute the element ahead
+         * directly, so nothing is stored
+         */
+        template<typename Iterator, bool RandomAccess>
+        struct PrefetchLead {
+            Iterator lead{};
+            std::size_t lag = 0;
+        };
+
+        template<typename Iterator>
+        struct PrefetchLead<Iterator, true> {};
+
+        /**
+         * @brief Iterator adaptor that prefetches the target of the element Distance steps ahead while iterating.
+         * @details @copybrief
+         * Random access iterators compute the element ahead directly. All other iterators keep a second iterator
+         * (PrefetchLead) that runs Distance steps ahead. The adaptor supports the same operators as the underlying iterator.
+         * @tparam Iterator underlying iterator type
+         * @tparam Target function object that yields the address to prefetch given an iterator
+         * @tparam Distance prefetch distance in elements
+         */
+        template<typename Iterator, typename Target, std::size_t Distance>
+        class PrefetchIterator : public SynthesizedOperators<PrefetchIterator<Iterator, Target, Distance>>,
+                                 private PrefetchLead<Iterator, traits::is_random_accessible_v<Iterator>> {
+            static constexpr bool RandomAccess = traits::is_random_accessible_v<Iterator>;
+        public:
+            using value_type = typename std::iterator_traits<Iterator>::value_type;
+            using reference = typename std::iterator_traits<Iterator>::reference;
+            using pointer = typename std::iterator_traits<Iterator>::pointer;
+            using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+            using iterator_category = std::conditional_t<RandomAccess, std::random_access_iterator_tag,
+                    typename std::iterator_traits<Iterator>::iterator_category>;
+
+            using SynthesizedOperators<PrefetchIterator>::operator++;
+            using SynthesizedOperators<PrefetchIterator>::operator--;
+
+            constexpr PrefetchIterator() = default;
+
+            /**
+             * CTor. Prefetches the first Distance elements
+             * @param it underlying iterator
+             * @param last end of the underlying range. Elements beyond last are never prefetched
+             * @param target prefetch target function
+             */
+            PrefetchIterator(Iterator it, Iterator last, Target target) :
+                    it(std::move(it)), last(std::move(last)), target(std::move(target)) {
+                if constexpr (RandomAccess) {
+                    auto remaining = std::min<difference_type>(this->last - this->it, Distance + 1);
+                    for (difference_type i = 1; i < remaining; ++i) {
+                        prefetch_address(this->target(this->it + i));
+                    }
+                } else {
+                    this->lead = this->it;
+                    while (this->lag < Distance && this->lead != this->last) {
+                        advanceLead();
+                    }
+                }
+            }
+
+            /**
+             * @return reference to the current element
+             */
+            constexpr reference operator*() const noexcept(noexcept(*std::declval<Iterator>())) {
+                return *it;
+            }
+
+            /**
+             * Increments the iterator and prefetches the element Distance steps ahead
+             * @return reference to this
+             */
+            PrefetchIterator &operator++() {
+                ++it;
+                if constexpr (RandomAccess) {
+                    prefetchAhead();
+                } else {
+                    --this->lag;
+                    if (this->lead != last) {
+                        advanceLead();
+                    }
+                }
+
+                return *this;
+            }
+
+            /**
+             * Decrements the iterator. Only available for bidirectional iterators
+             * @return reference to this
+             */
+            template<bool IsBidirectional = traits::is_bidirectional_v<Iterator>>
+            auto operator--() -> std::enable_if_t<IsBidirectional, PrefetchIterator &> {
+                --it;
+                if constexpr (not RandomAccess) {
+                    if (++this->lag > Distance) {
+                        --this->lead;
+                        --this->lag;
+                    }
+                }
+
+                return *this;
+            }
+
+            /**
+             * Compound assignment increment. Only available for random access iterators
+             * @param n increment
+             * @return reference to this
+             */
+            template<bool IsRandomAccessible = RandomAccess>
+            auto operator+=(difference_type n) -> std::enable_if_t<IsRandomAccessible, PrefetchIterator &> {
+                it += n;
+                prefetchAhead();
+                return *this;
+            }
+
+            /**
+             * Compound assignment decrement. Only available for random access iterators
+             * @param n decrement
+             * @return reference to this
+             */
+            template<bool IsRandomAccessible = RandomAccess>
+            auto operator-=(difference_type n) -> std::enable_if_t<IsRandomAccessible, PrefetchIterator &> {
+                it -= n;
+                return *this;
+            }
+
+            /**
+             * Difference of underlying iterators. Only available for random access iterators
+             * @param other right hand side
+             * @return number of steps between other and *this
+             */
+            template<bool IsRandomAccessible = RandomAccess>
+            auto operator-(const PrefetchIterator &other) const
+            -> std::enable_if_t<IsRandomAccessible, difference_type> {
+                return it - other.it;
+            }
+
+            /**
+             * Less comparison of underlying iterators. Only available for random access iterators
+             * @param other right hand side
+             * @return true if the underlying iterator compares less than the one from other
+             */
+            template<bool IsRandomAccessible = RandomAccess>
+            auto operator<(const PrefetchIterator &other) const -> std::enable_if_t<IsRandomAccessible, bool> {
+                return it < other.it;
+            }
+
+            /**
+             * Greater comparison of underlying iterators. Only available for random access iterators
+             * @param other right hand side
+             * @return true if the underlying iterator compares greater than the one from other
+             */
+            template<bool IsRandomAccessible = RandomAccess>
+            auto operator>(const PrefetchIterator &other) const -> std::enable_if_t<IsRandomAccessible, bool> {
+                return it > other.it;
+            }
+
+            /**
+             * Equality comparison of underlying iterators
+             * @param other right hand side
+             * @return true if the underlying iterators are equal
+             */
+            constexpr bool operator==(const PrefetchIterator &other) const {
+                return it == other.it;
+            }
+
+            /**
+             * @return underlying iterator
+             */
+            constexpr const Iterator &base() const noexcept {
+                return it;
+            }
+
+        private:
+            void prefetchAhead() {
+                if (last - it > static_cast<difference_type>(Distance)) {
+                    prefetch_address(target(it + static_cast<difference_type>(Distance)));
+                }
+            }
+
+            void advanceLead() {
+                ++this->lead;
+                ++this->lag;
+                if (this->lead != last) {
+                    prefetch_address(target(this->lead));
+                }
+            }
+
+            Iterator it{};
+            Iterator last{};
+            Target target{};
+        };
+
+        /**
+         * @brief Range adaptor whose iterators prefetch elements ahead. Ranges are captured by reference,
+         * temporaries are moved into the adaptor.
+         * @tparam Range underlying range type. Begin and end must have the same type
+         * @tparam Target function object that yields the address to prefetch given an iterator
+         * @tparam Distance prefetch distance in elements
+         */
+        template<typename Range, typename Target, std::size_t Distance>
+        struct PrefetchView DERIVE_VIEW_INTERFACE(PrefetchView<Range, Target, Distance>) {
+        private:
+            template<bool Const>
+            using Iterator = decltype(std::begin(std::declval<std::add_lvalue_reference_t<
+                    traits::const_if_t<Const, std::remove_reference_t<Range>>>>()));
+        public:
+            /**
+             * CTor.
+             * @tparam R range type
+             * @param range underlying range
+             * @param target prefetch target function
+             */
+            template<typename R>
+            constexpr PrefetchView(R &&range, Target target) : range(std::forward<R>(range), target) {}
+
+            PrefetchView() = default;
+
+            /**
+             * @return PrefetchIterator to the first element
+             */
+            auto begin() {
+                auto &[r, target] = range;
+                return PrefetchIterator<Iterator<false>, Target, Distance>(std::begin(r), std::end(r), target);
+            }
+
+            /**
+             * @return PrefetchIterator to the element following the last element
+             */
+            auto end() {
+                auto &[r, target] = range;
+                return PrefetchIterator<Iterator<false>, Target, Distance>(std::end(r), std::end(r), target);
+            }
+
+            /**
+             * @copydoc PrefetchView::begin()
+             */
+            template<bool C = true>
+            auto begin() const -> PrefetchIterator<Iterator<C>, Target, Distance> {
+                auto &[r, target] = range;
+                return PrefetchIterator<Iterator<true>, Target, Distance>(std::begin(r), std::end(r), target);
+            }
+
+            /**
+             * @copydoc PrefetchView::end()
+             */
+            template<bool C = true>
+            auto end() const -> PrefetchIterator<Iterator<C>, Target, Distance> {
+                auto &[r, target] = range;
+                return PrefetchIterator<Iterator<true>, Target, Distance>(std::end(r), std::end(r), target);
+            }
+
+#ifndef __USE_VIEW_INTERFACE__
+            /**
+             * Returns the size of the underlying range. Only available if the range knows its size
+             * @tparam HasSize SFINAE guard, do not specify explicitly
+             * @return size of the underlying range
+             */
+            template<bool HasSize = traits::has_size_v<Range>>
+            constexpr auto size() const -> std::enable_if_t<HasSize, std::size_t> {
+                return std::size(std::get<0>(range));
+            }
+#endif
+
+        private:
+            // stored in a tuple (like ZipView) so that views over lvalue references remain assignable
+            std::tuple<Range, Target> range;
+        };
+    }
+
+    /**
+     * Range adaptor that prefetches elements Distance steps ahead while iterating. Can be used as zip column.
+     * @tparam Distance prefetch distance in elements (default 16)
+     * @tparam Range range type
+     * @param range underlying range. Temporaries are moved into the adaptor
+     * @return impl::PrefetchView over range
+     * @relatesalso impl::PrefetchView
+     */
+    template<std::size_t Distance = 16, typename Range>
+    constexpr auto prefetch(Range &&range) {
+        return impl::PrefetchView<Range, impl::ElementTarget, Distance>(std::forward<Range>(range),
+                                                                        impl::ElementTarget{});
+    }
+
+    /**
+     * Range adaptor for ranges of pointers (raw pointers, smart pointers or iterators). While iterating, prefetches
+     * the object the element Distance steps ahead points to. Can be used as zip column.
+     * @tparam Distance prefetch distance in elements (default 16)
+     * @tparam Range range type
+     * @param range range of pointers. Temporaries are moved into the adaptor
+     * @return impl::PrefetchView over range
+     * @relatesalso impl::PrefetchView
+     */
+    template<std::size_t Distance = 16, typename Range>
+    constexpr auto prefetch_pointee(Range &&range) {
+        return impl::PrefetchView<Range, impl::PointeeTarget, Distance>(std::forward<Range>(range),
+                                                                        impl::PointeeTarget{});
+    }
+
+    /**
+     * Range adaptor for ranges of indices into a random access table. While iterating, prefetches the table entry
+     * that the index Distance steps ahead refers to. The elements themselves (the indices) are not changed.
+     * Can be used as zip column.
+     * @tparam Distance prefetch distance in elements (default 16)
+     * @tparam Range range type
+     * @tparam Table random access container type
+     * @param indices range of indices. Temporaries are moved into the adaptor
+     * @param table table the indices refer to. Must outlive the adaptor
+     * @return impl::PrefetchView over indices
+     * @relatesalso impl::PrefetchView
+     */
+    template<std::size_t Distance = 16, typename Range, typename Table>
+    constexpr auto prefetch_gather(Range &&indices, Table &table) {
+        using Target = impl::GatherTarget<decltype(std::begin(table))>;
+        return impl::PrefetchView<Range, Target, Distance>(std::forward<Range>(indices), Target{std::begin(table)});
+    }
+}
+
+#endif //ITERATORTOOLS_PREFETCH_HPP
@@ -0,0 +1,417 @@
+/**
+ * @file ReadAhead.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains a read-ahead input range. Elements are produced on a background thread into two
+ * alternating buffers while the consumer processes the other buffer. This overlaps I/O (or parsing) with
+ * processing. The range can be used with zip and enumerate like any other input range.
+ */
+
+#ifndef ITERATORTOOLS_READAHEAD_HPP
+#define ITERATORTOOLS_READAHEAD_HPP
+
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+
+#include "Iterators.hpp"
+
+namespace iterators {
+    namespace impl {
+
+        /**
+         * @brief Shared state of a read-ahead range. Owns the background thread and the two buffers.
+         * @details @copybrief
+         * The producer fills one buffer while the consumer reads from the other. An empty buffer signals the end of
+         * the sequence. Exceptions thrown by the producer are rethrown on the consumer's thread.
+         * @tparam T element type
+         */
+        template<typename T>
+        class ReadAheadState {
+        public:
+            /**
+             * Appends at most capacity elements to the given buffer. Returning without appending anything signals
+             * the end of the sequence
+             */
+            using Producer = std::function<void(std::vector<T> &buffer, std::size_t capacity)>;
+
+            /**
+             * CTor. Starts the background thread
+             * @param producer function that produces the elements
+             * @param capacity number of elements per buffer
+             */
+            ReadAheadState(Producer producer, std::size_t capacity) :
+                    producer(std::move(producer)), capacity(std::max(capacity, std::size_t(1))) {
+                for (auto &buffer : buffers) {
+                    buffer.reserve(this->capacity);
+                }
+
+                worker = std::thread([this] { produce(); });
+            }
+
+            ReadAheadState(const ReadAheadState &) = delete;
+            ReadAheadState &operator=(const ReadAheadState &) = delete;
+
+            ~ReadAheadState() {
+                {
+                    std::lock_guard lock(mutex);
+                    stop = true;
+                }
+
+                condition.notify_all();
+                worker.join();
+            }
+
+            /**
+             * Blocks until the first buffer is ready. Subsequent calls have no effect
+             */
+            void start() {
+                if (not started) {
+                    started = true;
+                    acquire();
+                }
+            }
+
+            /**
+             * Advances to the next element. Blocks if the next buffer is not ready yet
+             */
+            void next() {
+                if (++position == buffers[current].size()) {
+                    {
+                        std::lock_guard lock(mutex);
+                        ready[current] = false;
+                    }
+
+                    condition.notify_all();
+                    current ^= 1;
+                    acquire();
+                }
+            }
+
+            /**
+             * @return reference to the current element
+             */
+            [[nodiscard]] T &get() noexcept {
+                return buffers[current][position];
+            }
+
+            /**
+             * @return true if all elements have been consumed
+             */
+            [[nodiscard]] bool exhausted() {
+                start();
+                return finished;
+            }
+
+        private:
+            void acquire() {
+                position = 0;
+                {
+                    std::unique_lock lock(mutex);
+                    condition.wait(lock, [this] { return ready[current]; });
+                }
+
+                if (buffers[current].empty()) {
+                    finished = true;
+                    if (error != nullptr) {
+                        std::rethrow_exception(std::exchange(error, nullptr));
+                    }
+                }
+            }
+
+            void produce() {
+                std::size_t index = 0;
+                while (true) {
+                    {
+                        std::unique_lock lock(mutex);
+                        condition.wait(lock, [this, index] { return stop || not ready[index]; });
+                        if (stop) {
+                            return;
+                        }
+                    }
+
+                    auto &buffer = buffers[index];
+                    buffer.clear();
+                    try {
+                        producer(buffer, capacity);
+                    } catch (...) {
+                        buffer.clear();
+                        error = std::current_exception();
+                    }
+
+                    bool last = buffer.empty();
+                    {
+                        std::lock_guard lock(mutex);
+                        ready[index] = true;
+                    }
+
+                    condition.notify_all();
+                    if (last) {
+                        return;
+                    }
+
+                    index ^= 1;
+                }
+            }
+
+            Producer producer;
+            std::size_t capacity;
+            std::array<std::vector<T>, 2> buffers;
+            std::array<bool, 2> ready{};
+            std::exception_ptr error;
+            bool stop = false;
+            std::mutex mutex;
+            std::condition_variable condition;
+            // consumer side, only accessed by the consuming thread
+            std::size_t current = 0;
+            std::size_t position = 0;
+            bool started = false;
+            bool finished = false;
+            std::thread worker;
+        };
+
+        /**
+         * @brief Holds the element consumed by a postfix increment
+         * @tparam T element type
+         */
+        template<typename T>
+        struct PostIncrementProxy {
+            constexpr T &operator*() noexcept {
+                return value;
+            }
+
+            T value;
+        };
+
+        /**
+         * @brief Input iterator of a read-ahead range. All copies share the position of the range
+         * @tparam T element type
+         */
+        template<typename T>
+        class ReadAheadIterator {
+        public:
+            using value_type = T;
+            using reference = T &;
+            using pointer = T *;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::input_iterator_tag;
+
+            /**
+             * CTor. Default constructed iterators represent the end of the sequence
+             */
+            constexpr ReadAheadIterator() noexcept = default;
+
+            explicit ReadAheadIterator(ReadAheadState<T> *state) : state(state) {
+                state->start();
+            }
+
+            /**
+             * @return reference to the current element. The reference is valid until the iterator is incremented
+             */
+            T &operator*() const noexcept {
+                return state->get();
+            }
+
+            /**
+             * Advances to the next element. Blocks if the background thread has not provided it yet
+             * @return reference to this
+             * @throws any exception thrown by the producer of the range
+             */
+            ReadAheadIterator &operator++() {
+                state->next();
+                return *this;
+            }
+
+            /**
+             * Postfix increment
+             * @return Proxy object that holds the consumed element
+             */
+            PostIncrementProxy<T> operator++(int) {
+                PostIncrementProxy<T> proxy{std::move(**this)};
+                ++*this;
+                return proxy;
+            }
+
+            /**
+             * Equality comparison. Two iterators compare equal if they are both at the end of the sequence or if
+             * they belong to the same range
+             * @param other right hand side
+             * @return true if both iterators are equal
+             */
+            bool operator==(const ReadAheadIterator &other) const {
+                return atEnd() == other.atEnd() && (atEnd() || state == other.state);
+            }
+
+            /**
+             * Inequality comparison
+             * @param other right hand side
+             * @return true if both iterators are not equal
+             */
+            bool operator!=(const ReadAheadIterator &other) const {
+                return !(*this == other);
+            }
+
+        private:
+            [[nodiscard]] bool atEnd() const {
+                return state == nullptr || state->exhausted();
+            }
+
+            ReadAheadState<T> *state = nullptr;
+        };
+
+        /**
+         * @brief Single pass input range whose elements are read ahead on a background thread into double buffers.
+         * @details @copybrief
+         * The background thread starts as soon as the range is created. Destroying the range stops the thread after
+         * the buffer that is currently being filled is complete.
+         * @tparam T element type
+         */
+        template<typename T>
+        class ReadAheadRange {
+        public:
+            /**
+             * CTor.
+             * @param producer function that appends at most capacity elements to the given buffer. Appending
+             * nothing signals the end of the sequence
+             * @param bufferSize number of elements per buffer
+             */
+            ReadAheadRange(typename ReadAheadState<T>::Producer producer, std::size_t bufferSize) :
+                    state(std::make_unique<ReadAheadState<T>>(std::move(producer), bufferSize)) {}
+
+            /**
+             * @return iterator to the current element. Blocks until the first buffer is ready
+             */
+            ReadAheadIterator<T> begin() {
+                return ReadAheadIterator<T>(state.get());
+            }
+
+            /**
+             * @return iterator representing the end of the sequence
+             */
+            constexpr ReadAheadIterator<T> end() const noexcept {
+                return ReadAheadIterator<T>{};
+            }
+
+        private:
+            std::unique_ptr<ReadAheadState<T>> state;
+        };
+
+        template<typename Range>
+        struct RangeCursor {
+            explicit RangeCursor(Range &&range) : range(std::forward<Range>(range)), current(std::begin(this->range)),
+                                                  last(std::end(this->range)) {}
+
+            Range range;
+            decltype(std::begin(range)) current;
+            decltype(std::end(range)) last;
+        };
+    }
+
+    /**
+     * Creates a read-ahead range from an arbitrary input range. The source range is iterated on a background thread
+     * and its elements are copied into double buffers.
+     * @tparam Range source range type. Ranges passed as lvalue references must outlive the read-ahead range,
+     * temporaries are moved into the read-ahead range
+     * @param source source range
+     * @param bufferSize number of elements per buffer (default 4096)
+     * @return impl::ReadAheadRange that can be used with zip and enumerate
+     * @relatesalso impl::ReadAheadRange
+     */
+    template<typename Range, typename = std::enable_if_t<impl::traits::is_container_v<Range>>>
+    auto prefetched(Range &&source, std::size_t bufferSize = 4096) {
+        using T = typename std::iterator_traits<decltype(std::begin(source))>::value_type;
+        auto cursor = std::make_shared<impl::RangeCursor<Range>>(std::forward<Range>(source));
+        return impl::ReadAheadRange<T>([cursor](std::vector<T> &buffer, std::size_t capacity) {
+            for (; buffer.size() < capacity && cursor->current != cursor->last; ++cursor->current) {
+                buffer.emplace_back(*cursor->current);
+            }
+        }, bufferSize);
+    }
+
+    /**
+     * Creates a read-ahead range that parses elements from an input stream on a background thread using formatted
+     * extraction (like std::istream_iterator)
+     * @tparam T element type
+     * @param stream source stream. Must outlive the read-ahead range and must not be used by other threads while the
+     * range exists
+     * @param bufferSize number of elements per buffer (default 4096)
+     * @return impl::ReadAheadRange that can be used with zip and enumerate
+     * @relatesalso impl::ReadAheadRange
+     */
+    template<typename T>
+    auto prefetched(std::istream &stream, std::size_t bufferSize = 4096) -> impl::ReadAheadRange<T> {
+        return impl::ReadAheadRange<T>([&stream](std::vector<T> &buffer, std::size_t capacity) {
+            T value;
+            while (buffer.size() < capacity && stream >> value) {
+                buffer.emplace_back(std::move(value));
+            }
+        }, bufferSize);
+    }
+
+    /**
+     * Creates a read-ahead range that reads raw fixed-size records from a file descriptor on a background thread.
+     * @tparam T record type. Must be trivially copyable
+     * @param fd readable file descriptor. Must stay open while the range exists. The descriptor is not closed by
+     * the range
+     * @param bufferSize number of records per buffer (default 4096)
+     * @return impl::ReadAheadRange that can be used with zip and enumerate
+     * @note Reading fails with std::system_error on I/O errors and with std::runtime_error if the input ends with
+     * an incomplete record, after the complete records before it. The exceptions are rethrown when incrementing the
+     * range's iterator.
+     * @note Reads are always issued from a background thread (no io_uring).
+     * @relatesalso impl::ReadAheadRange
+     */
+    template<typename T>
+    auto prefetched(int fd, std::size_t bufferSize = 4096) -> impl::ReadAheadRange<T> {
+        static_assert(std::is_trivially_copyable_v<T>, "records must be trivially copyable");
+        return impl::ReadAheadRange<T>([fd, torn = false](std::vector<T> &buffer, std::size_t capacity) mutable {
+            if (torn) {
+                throw std::runtime_error("input ends with an incomplete record");
+            }
+
+            buffer.resize(capacity);
+            auto bytes = reinterpret_cast<char *>(buffer.data());
+            std::size_t filled = 0;
+            while (filled < capacity * sizeof(T)) {
+                auto result = ::read(fd, bytes + filled, capacity * sizeof(T) - filled);
+                if (result < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+
+                    throw std::system_error(errno, std::generic_category(), "cannot read records");
+                }
+
+                if (result == 0) {
+                    break;
+                }
+
+                filled += static_cast<std::size_t>(result);
+            }
+
+            // publish the complete records first, the next fill reports the incomplete one
+            torn = filled % sizeof(T) != 0;
+            if (torn && filled < sizeof(T)) {
+                throw std::runtime_error("input ends with an incomplete record");
+            }
+
+            buffer.resize(filled / sizeof(T));
+        }, bufferSize);
+    }
+}
+
+#endif //ITERATORTOOLS_READAHEAD_HPP
@@ -0,0 +1,306 @@
+/**
+ * @file RleColumn.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains a read-only run-length encoded column. Consecutive equal values are stored once
+ * together with the end of their run. The column can be zipped with dense columns. Its iterators expose the
+ * remaining length of the current run, so reduce, transform_reduce and for_each_run process a whole run at once.
+ */
+
+#ifndef ITERATORTOOLS_RLECOLUMN_HPP
+#define ITERATORTOOLS_RLECOLUMN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Iterators.hpp"
+#include "Algorithms.hpp"
+
+namespace iterators {
+    namespace impl {
+        template<typename T>
+        class RleColumn;
+
+        /**
+         * Reference type of a RleColumn. std::vector<bool> cannot hand out references, so bool values are returned
+         * by value
+         */
+        template<typename T>
+        using rle_reference_t = std::conditional_t<std::is_same_v<T, bool>, bool, const T &>;
+
+        /**
+         * @brief Random access iterator over a RleColumn. Keeps track of the current run, so sequential iteration
+         * costs O(1) per row and jumps cost O(1) within a run and O(log runs) otherwise.
+         * @tparam T element type
+         */
+        template<typename T>
+        class RleIterator : public SynthesizedOperators<RleIterator<T>> {
+        public:
+            using value_type = T;
+            using reference = rle_reference_t<T>;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::random_access_iterator_tag;
+
+            using SynthesizedOperators<RleIterator>::operator++;
+            using SynthesizedOperators<RleIterator>::operator--;
+
+            constexpr RleIterator() noexcept = default;
+
+            /**
+             * CTor.
+             * @param column underlying column
+             * @param position row index
+             * @param run index of the run that contains position
+             */
+            constexpr RleIterator(const RleColumn<T> *column, std::size_t position, std::size_t run) noexcept :
+                    column(column), position(position), run(run) {}
+
+            constexpr reference operator*() const noexcept {
+                return column->runValues()[run];
+            }
+
+            /**
+             * @return number of rows from the current position to the end of the current run
+             */
+            [[nodiscard]] constexpr std::size_t runRemaining() const noexcept {
+                return column->runEnds()[run] - position;
+            }
+
+            /**
+             * @return index of the current run
+             */
+            [[nodiscard]] constexpr std::size_t runIndex() const noexcept {
+                return run;
+            }
+
+            constexpr RleIterator &operator++() noexcept {
+                ++position;
+                if (position == column->runEnds()[run]) {
+                    ++run;
+                }
+
+                return *this;
+            }
+
+            constexpr RleIterator &operator--() noexcept {
+                --position;
+                if (run > 0 && position < column->runEnds()[run - 1]) {
+                    --run;
+                }
+
+                return *this;
+            }
+
+            RleIterator &operator+=(difference_type n) noexcept {
+                position += static_cast<std::size_t>(n);
+                const auto &ends = column->runEnds();
+                const auto start = run == 0 ? 0 : ends[run - 1];
+                if (position >= start && run < ends.size() && position < ends[run]) {
+                    return *this;
+                }
+
+                // skipping to the start of the next run is the common case of run-wise algorithms
+                if (run + 1 < ends.size() && position >= ends[run] && position < ends[run + 1]) {
+                    ++run;
+                } else {
+                    run = static_cast<std::size_t>(std::upper_bound(ends.begin(), ends.end(), position) -
+                                                   ends.begin());
+                }
+
+                return *this;
+            }
+
+            RleIterator &operator-=(difference_type n) noexcept {
+                return *this += -n;
+            }
+
+            constexpr difference_type operator-(const RleIterator &other) const noexcept {
+                return static_cast<difference_type>(position) - static_cast<difference_type>(other.position);
+            }
+
+            constexpr bool operator==(const RleIterator &other) const noexcept {
+                return position == other.position;
+            }
+
+            constexpr bool operator<(const RleIterator &other) const noexcept {
+                return position < other.position;
+            }
+
+            constexpr bool operator>(const RleIterator &other) const noexcept {
+                return position > other.position;
+            }
+
+        private:
+            const RleColumn<T> *column = nullptr;
+            std::size_t position = 0;
+            std::size_t run = 0;
+        };
+
+        /**
+         * @brief Read-only run-length encoded column
+         * @tparam T element type. Must be equality comparable
+         */
+        template<typename T>
+        class RleColumn {
+        public:
+            using value_type = T;
+            using reference = rle_reference_t<T>;
+            using iterator = RleIterator<T>;
+            using const_iterator = RleIterator<T>;
+
+            RleColumn() = default;
+
+            /**
+             * CTor. Encodes a range
+             * @tparam Range input range type
+             * @param values range of values convertible to T
+             */
+            template<typename Range>
+            explicit RleColumn(const Range &values) {
+                for (const auto &value : values) {
+                    push_back(value);
+                }
+
+                runs.shrink_to_fit();
+                ends.shrink_to_fit();
+            }
+
+            const_iterator begin() const noexcept {
+                return const_iterator(this, 0, 0);
+            }
+
+            const_iterator end() const noexcept {
+                return const_iterator(this, size(), runs.size());
+            }
+
+            /**
+             * Appends a run. Merges it with the last run if the values are equal
+             * @param value value of the run
+             * @param count length of the run
+             */
+            void push_back(const T &value, std::size_t count = 1) {
+                if (count == 0) {
+                    return;
+                }
+
+                if (not runs.empty() && runs.back() == value) {
+                    ends.back() += count;
+                } else {
+                    runs.push_back(value);
+                    ends.push_back(size() + count);
+                }
+            }
+
+            /**
+             * @return number of rows
+             */
+            [[nodiscard]] std::size_t size() const noexcept {
+                return ends.empty() ? 0 : ends.back();
+            }
+
+            /**
+             * @return true if the column has no rows
+             */
+            [[nodiscard]] bool empty() const noexcept {
+                return ends.empty();
+            }
+
+            /**
+             * Array subscript operator. Searches the run in O(log runs) (no bounds are checked)
+             * @param index row index
+             * @return reference to the value of the row (a copy if T is bool)
+             */
+            reference operator[](std::size_t index) const noexcept {
+                return runs[static_cast<std::size_t>(std::upper_bound(ends.begin(), ends.end(), index) -
+                                                     ends.begin())];
+            }
+
+            /**
+             * @return number of runs
+             */
+            [[nodiscard]] std::size_t runCount() const noexcept {
+                return runs.size();
+            }
+
+            /**
+             * @return value of each run
+             */
+            [[nodiscard]] const std::vector<T> &runValues() const noexcept {
+                return runs;
+            }
+
+            /**
+             * @return exclusive end row of each run. Run r covers the rows [runEnds()[r - 1], runEnds()[r])
+             */
+            [[nodiscard]] const std::vector<std::size_t> &runEnds() const noexcept {
+                return ends;
+            }
+
+        private:
+            std::vector<T> runs;
+            std::vector<std::size_t> ends;
+        };
+    }
+
+    /**
+     * Creates a run-length encoded copy of a range. The column is read-only and can be used as zip column. reduce
+     * over the column and transform_reduce with product over a zip of the column and one dense column handle each
+     * run with a single multiplication.
+     * @code
+     * auto region = rle_column(regionIds);
+     * double revenue = transform_reduce(zip(region, sales), 0.0, std::plus<>{}, product{});
+     * @endcode
+     * @tparam T element type (default: value type of the range)
+     * @tparam Range input range type
+     * @param values range of values
+     * @return impl::RleColumn
+     * @relatesalso impl::RleColumn
+     */
+    template<typename T = void, typename Range>
+    auto rle_column(const Range &values) {
+        using Value = std::conditional_t<std::is_void_v<T>, std::remove_cv_t<std::remove_reference_t<
+                decltype(*std::begin(values))>>, T>;
+        return impl::RleColumn<Value>(values);
+    }
+
+    /**
+     * Invokes a function once per run of a run-length encoded column or of a zip that contains one. Use it to
+     * apply the run value to a block of dense rows without looking it up for each row.
+     * @code
+     * for_each_run(zip(rate, amounts), [](double r, auto first, auto last) {
+     *     for (; first != last; ++first) {
+     *         std::get<1>(*first) *= r;
+     *     }
+     * });
+     * @endcode
+     * @tparam Range impl::RleColumn or random access zip with a RleColumn column
+     * @tparam Function function type
+     * @param range input range. Runs of the first RleColumn column define the blocks
+     * @param function function that is called with the run value and the iterators [first, last) of the rows of the
+     * run
+     * @return the function
+     */
+    template<typename Range, typename Function>
+    Function for_each_run(Range &&range, Function function) {
+        auto first = std::begin(range);
+        auto last = std::end(range);
+        using Iterator = decltype(first);
+        static_assert(impl::traits::has_runs<Iterator>::value || impl::traits::has_run_column<Iterator>::value,
+                      "for_each_run requires a run-length encoded column");
+        static_assert(impl::traits::is_random_accessible_v<Iterator>, "for_each_run requires a random access range");
+        while (first != last) {
+            auto next = first + impl::run_length(first, last);
+            function(*impl::run_iterator(first), first, next);
+            first = next;
+        }
+
+        return function;
+    }
+}
+
+#endif //ITERATORTOOLS_RLECOLUMN_HPP
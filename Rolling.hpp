@@ -0,0 +1,338 @@
+/**
+ * @file Rolling.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains lazy rolling-window aggregates (sum, mean, min and max). The i-th element of a rolling
+ * view is the aggregate of the last w elements up to and including element i of the source. Each element costs
+ * amortized O(1), independent of the window size. Rolling views have the same length as their source and can be
+ * zipped with it.
+ */
+
+#ifndef ITERATORTOOLS_ROLLING_HPP
+#define ITERATORTOOLS_ROLLING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Iterators.hpp"
+#include "Algorithms.hpp"
+
+namespace iterators {
+    namespace impl {
+        /**
+         * Accumulator type of rolling sums: integers are widened to 64 bits so that sums of narrow types do not wrap
+         */
+        template<typename T>
+        using rolling_sum_t = std::conditional_t<std::is_integral_v<T>, std::conditional_t<
+                std::is_signed_v<T>, long long, unsigned long long>, T>;
+
+        /**
+         * @brief Running sum of a window. Elements entering the window are added, elements leaving it are
+         * subtracted. Integer sums are accumulated in 64 bits.
+         * @tparam T element type
+         */
+        template<typename T>
+        struct RollingSum {
+            using result_type = rolling_sum_t<T>;
+
+            void push(std::size_t, const T &value) {
+                sum += static_cast<result_type>(value);
+            }
+
+            void pop(std::size_t, const T &value) {
+                sum -= static_cast<result_type>(value);
+            }
+
+            [[nodiscard]] result_type result(std::size_t) const {
+                return sum;
+            }
+
+        protected:
+            result_type sum{};
+        };
+
+        /**
+         * @brief Running mean of a window. Integer sums are kept exact in 64 bits, the mean is a double
+         * @tparam T element type
+         */
+        template<typename T>
+        struct RollingMean : RollingSum<T> {
+            using result_type = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+            [[nodiscard]] result_type result(std::size_t count) const {
+                return static_cast<result_type>(this->sum) / static_cast<result_type>(count);
+            }
+        };
+
+        /**
+         * @brief Minimum of a window with respect to comp. Uses a monotonic deque of candidates: an element is
+         * dropped as soon as a newer element that is not worse enters the window, so every element is pushed and
+         * popped at most once.
+         * @tparam T element type
+         * @tparam Compare comparison type
+         */
+        template<typename T, typename Compare>
+        struct RollingExtremum {
+            using result_type = T;
+
+            void push(std::size_t index, const T &value) {
+                while (not candidates.empty() && not Compare{}(candidates.back().second, value)) {
+                    candidates.pop_back();
+                }
+
+                candidates.emplace_back(index, value);
+            }
+
+            void pop(std::size_t index, const T &) {
+                if (candidates.front().first == index) {
+                    candidates.pop_front();
+                }
+            }
+
+            [[nodiscard]] result_type result(std::size_t) const {
+                return candidates.front().second;
+            }
+
+        private:
+            std::deque<std::pair<std::size_t, T>> candidates;
+        };
+
+        /**
+         * @brief Iterator of a rolling view. A second iterator trails the current position by the window size and
+         * removes elements that leave the window from the aggregate.
+         * @tparam Iterator forward iterator of the source
+         * @tparam Window aggregate type (e.g. RollingSum)
+         * @note Copying the iterator copies the aggregate. For rolling_min and rolling_max this is O(w)
+         */
+        template<typename Iterator, typename Window>
+        class RollingIterator : public SynthesizedOperators<RollingIterator<Iterator, Window>> {
+            static_assert(std::is_base_of_v<std::forward_iterator_tag,
+                                  typename std::iterator_traits<Iterator>::iterator_category>,
+                          "rolling views require forward iterators");
+        public:
+            using value_type = typename Window::result_type;
+            using reference = value_type;
+            using pointer = void;
+            using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+            using iterator_category = std::forward_iterator_tag;
+
+            using SynthesizedOperators<RollingIterator>::operator++;
+
+            constexpr RollingIterator() = default;
+
+            /**
+             * CTor. Adds the first element to the window
+             * @param it underlying iterator
+             * @param last end of the source
+             * @param window window size. Must be positive
+             */
+            RollingIterator(Iterator it, Iterator last, std::size_t window) :
+                    head(it), tail(std::move(it)), last(std::move(last)), window(window) {
+                if (head != this->last) {
+                    aggregate.push(0, *head);
+                }
+            }
+
+            /**
+             * @return aggregate of the window that ends at the current element
+             */
+            value_type operator*() const {
+                return aggregate.result(std::min(index + 1, window));
+            }
+
+            /**
+             * Moves the window by one element
+             * @return reference to this
+             */
+            RollingIterator &operator++() {
+                ++head;
+                ++index;
+                if (head != last) {
+                    if (index >= window) {
+                        aggregate.pop(index - window, *tail);
+                        ++tail;
+                    }
+
+                    aggregate.push(index, *head);
+                }
+
+                return *this;
+            }
+
+            /**
+             * Equality comparison
+             * @param other right hand side
+             * @return true if the underlying iterators are equal
+             */
+            constexpr bool operator==(const RollingIterator &other) const {
+                return head == other.head;
+            }
+
+            /**
+             * @return underlying iterator
+             */
+            constexpr const Iterator &base() const noexcept {
+                return head;
+            }
+
+        private:
+            Iterator head{};
+            Iterator tail{};
+            Iterator last{};
+            std::size_t index = 0;
+            std::size_t window = 1;
+            Window aggregate;
+        };
+
+        /**
+         * @brief Lazy rolling-window aggregate over a range
+         * @tparam Range source range type. Begin and end must have the same type unless the range is random access
+         * @tparam Window aggregate type (e.g. RollingSum)
+         */
+        template<typename Range, typename Window>
+        struct RollingView DERIVE_VIEW_INTERFACE(RollingView<Range, Window>) {
+        private:
+            template<bool Const>
+            using Iterator = RollingIterator<decltype(std::begin(std::declval<std::add_lvalue_reference_t<
+                    traits::const_if_t<Const, std::remove_reference_t<Range>>>>())), Window>;
+        public:
+            /**
+             * CTor.
+             * @tparam R range type
+             * @param range source range
+             * @param window window size
+             * @throws std::invalid_argument if window is 0
+             */
+            template<typename R>
+            constexpr RollingView(R &&range, std::size_t window) : range(std::forward<R>(range)), window(window) {
+                if (window == 0) {
+                    throw std::invalid_argument("rolling window size must be positive");
+                }
+            }
+
+            RollingView() = default;
+
+            /**
+             * @return RollingIterator to the aggregate of the first window
+             */
+            auto begin() {
+                auto &r = std::get<0>(range);
+                return Iterator<false>(std::begin(r), common_end(r), window);
+            }
+
+            /**
+             * @return RollingIterator to the element following the last element
+             */
+            auto end() {
+                auto &r = std::get<0>(range);
+                return Iterator<false>(common_end(r), common_end(r), window);
+            }
+
+            /**
+             * @copydoc RollingView::begin()
+             */
+            template<bool C = true>
+            auto begin() const -> Iterator<C> {
+                auto &r = std::get<0>(range);
+                return Iterator<true>(std::begin(r), common_end(r), window);
+            }
+
+            /**
+             * @copydoc RollingView::end()
+             */
+            template<bool C = true>
+            auto end() const -> Iterator<C> {
+                auto &r = std::get<0>(range);
+                return Iterator<true>(common_end(r), common_end(r), window);
+            }
+
+            /**
+             * Returns the size of the source range. Only available if the range knows its size
+             * @tparam HasSize SFINAE guard, do not specify explicitly
+             * @return size of the source range
+             */
+            template<bool HasSize = traits::has_size_v<Range>>
+            constexpr auto size() const -> std::enable_if_t<HasSize, std::size_t> {
+                return std::size(std::get<0>(range));
+            }
+
+        private:
+            std::tuple<Range> range;
+            std::size_t window = 1;
+        };
+
+        template<typename Range>
+        using rolling_value_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(
+                std::declval<Range &>()))>>;
+    }
+
+    /**
+     * Lazy rolling sum. The i-th element of the resulting view is the sum of the elements max(0, i - window + 1) to i
+     * of the range. Each element costs one addition and one subtraction. Sums of integers are long long (unsigned
+     * long long for unsigned types), so windows over narrow types do not overflow.
+     * @code
+     * for (auto [time, value, sum] : zip(timestamps, values, rolling_sum(values, 10))) { ... }
+     * @endcode
+     * @tparam Range forward range type
+     * @param range source range. Temporaries are moved into the view
+     * @param window window size. Must be positive
+     * @return impl::RollingView over range
+     * @throws std::invalid_argument if window is 0
+     * @note Floating point sums are updated incrementally and may differ from a direct sum by rounding errors
+     * @relatesalso impl::RollingView
+     */
+    template<typename Range>
+    constexpr auto rolling_sum(Range &&range, std::size_t window) {
+        using T = impl::rolling_value_t<Range>;
+        return impl::RollingView<Range, impl::RollingSum<T>>(std::forward<Range>(range), window);
+    }
+
+    /**
+     * Lazy rolling mean. The i-th element of the resulting view is the mean of the elements
+     * max(0, i - window + 1) to i of the range. Means of integers are doubles.
+     * @copydetails rolling_sum
+     */
+    template<typename Range>
+    constexpr auto rolling_mean(Range &&range, std::size_t window) {
+        using T = impl::rolling_value_t<Range>;
+        return impl::RollingView<Range, impl::RollingMean<T>>(std::forward<Range>(range), window);
+    }
+
+    /**
+     * Lazy rolling minimum. The i-th element of the resulting view is the minimum of the elements
+     * max(0, i - window + 1) to i of the range. Uses a monotonic deque, so each element costs amortized O(1)
+     * comparisons.
+     * @tparam Range forward range type
+     * @param range source range. Temporaries are moved into the view
+     * @param window window size. Must be positive
+     * @return impl::RollingView over range
+     * @throws std::invalid_argument if window is 0
+     * @relatesalso impl::RollingView
+     */
+    template<typename Range>
+    constexpr auto rolling_min(Range &&range, std::size_t window) {
+        using T = impl::rolling_value_t<Range>;
+        return impl::RollingView<Range, impl::RollingExtremum<T, std::less<>>>(std::forward<Range>(range), window);
+    }
+
+    /**
+     * Lazy rolling maximum. The i-th element of the resulting view is the maximum of the elements
+     * max(0, i - window + 1) to i of the range.
+     * @copydetails rolling_min
+     */
+    template<typename Range>
+    constexpr auto rolling_max(Range &&range, std::size_t window) {
+        using T = impl::rolling_value_t<Range>;
+        return impl::RollingView<Range, impl::RollingExtremum<T, std::greater<>>>(std::forward<Range>(range),
+                                                                                   window);
+    }
+}
+
+#endif //ITERATORTOOLS_ROLLING_HPP
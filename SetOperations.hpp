@@ -0,0 +1,431 @@
+/**
+ * @file SetOperations.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains lazy set operations (intersection, union and difference) over sorted ranges, e.g. sorted
+ * id columns of zip views. Runs of non-matching elements are skipped by galloping. Contiguous 32 bit integer keys are
+ * compared in blocks using SSE2.
+ */
+
+#ifndef ITERATORTOOLS_SETOPERATIONS_HPP
+#define ITERATORTOOLS_SETOPERATIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "Iterators.hpp"
+#include "Algorithms.hpp"
+#include "BitColumn.hpp"
+
+namespace iterators {
+    namespace impl {
+        /**
+         * @brief Kind of set operation
+         */
+        enum class SetOperation {
+            Intersection, Union, Difference
+        };
+
+        namespace traits {
+            template<typename Iterator, typename Target, typename Key, typename Compare, typename = std::void_t<>>
+            struct has_simd_skip : std::false_type {};
+
+            // the target is compared as T, so it has to be of the same type to not be truncated
+            template<typename Iterator, typename Target, typename Key, typename Compare>
+            struct has_simd_skip<Iterator, Target, Key, Compare,
+                    std::void_t<typename std::iterator_traits<Iterator>::value_type>> {
+                using T = typename std::iterator_traits<Iterator>::value_type;
+                static constexpr bool value = std::is_same_v<Key, Identity> && is_contiguous_v<Iterator> &&
+                                              (std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::uint32_t>) &&
+                                              std::is_same_v<std::decay_t<Target>, T> &&
+                                              (std::is_same_v<Compare, std::less<>> ||
+                                               std::is_same_v<Compare, std::less<T>>);
+            };
+
+            template<typename Iterator, typename Target, typename Key, typename Compare>
+            constexpr inline bool has_simd_skip_v = has_simd_skip<Iterator, Target, Key, Compare>::value;
+        }
+
+        /**
+         * Number of elements that are compared in SIMD blocks before switching to galloping
+         */
+        constexpr inline std::size_t SimdSkipLength = 16;
+
+        /**
+         * Skips all elements whose key is less than target
+         * @param it start of the sorted range
+         * @param last end of the sorted range
+         * @param target key to search for
+         * @param key key function
+         * @param comp comparison
+         * @return first iterator whose key is not less than target or last
+         */
+        template<typename Iterator, typename Target, typename Key, typename Compare>
+        Iterator skip_less(Iterator it, const Iterator &last, const Target &target, const Key &key,
+                           const Compare &comp) {
+#if defined(__SSE2__) || defined(_M_X64)
+            if constexpr (traits::has_simd_skip_v<Iterator, Target, Key, Compare>) {
+                using T = typename std::iterator_traits<Iterator>::value_type;
+                using Difference = typename std::iterator_traits<Iterator>::difference_type;
+                // unsigned keys are compared as signed keys after flipping the sign bit
+                const auto bias = _mm_set1_epi32(std::is_signed_v<T> ? 0 : std::numeric_limits<std::int32_t>::min());
+                const auto needle = _mm_xor_si128(_mm_set1_epi32(static_cast<std::int32_t>(target)), bias);
+                for (std::size_t i = 0; i < SimdSkipLength && last - it >= 4; i += 4) {
+                    auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(std::addressof(*it)));
+                    auto less = _mm_cmplt_epi32(_mm_xor_si128(block, bias), needle);
+                    auto mask = static_cast<std::uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(less)));
+                    if (mask != 0xF) {
+                        return it + static_cast<Difference>(popcount(mask));
+                    }
+
+                    it += 4;
+                }
+            }
+#endif
+            return advance_while(std::move(it), last, [&](auto &&element) { return comp(key(element), target); });
+        }
+
+        /**
+         * @brief Key functions and comparison of a set operation
+         */
+        template<typename LeftKey, typename RightKey, typename Compare>
+        struct SetKeys {
+            LeftKey left;
+            RightKey right;
+            Compare comp;
+        };
+
+        template<SetOperation Operation, typename LeftRef, typename RightRef>
+        struct set_reference {
+            using type = std::conditional_t<std::is_same_v<LeftRef, RightRef>, LeftRef,
+                    std::common_type_t<LeftRef, RightRef>>;
+        };
+
+        template<typename LeftRef, typename RightRef>
+        struct set_reference<SetOperation::Intersection, LeftRef, RightRef> {
+            using type = RefTuple<LeftRef, RightRef>;
+        };
+
+        template<typename LeftRef, typename RightRef>
+        struct set_reference<SetOperation::Difference, LeftRef, RightRef> {
+            using type = LeftRef;
+        };
+
+        /**
+         * @brief Iterator of a lazy set operation over two sorted ranges.
+         * @details @copybrief
+         * - Intersection: pairs (leftElement, rightElement) with equivalent keys. Like std::set_intersection,
+         *   duplicates are matched one to one
+         * - Union: elements of both ranges in order. Elements with equivalent keys are produced once (from the left
+         *   range)
+         * - Difference: elements of the left range without equivalent element in the right range
+         * @tparam LeftIt iterator type of the left range
+         * @tparam RightIt iterator type of the right range
+         * @tparam Keys SetKeys type
+         * @tparam Operation set operation
+         */
+        template<typename LeftIt, typename RightIt, typename Keys, SetOperation Operation>
+        class SetOperationIterator : public SynthesizedOperators<SetOperationIterator<LeftIt, RightIt, Keys,
+                Operation>> {
+            enum class Side {
+                Left, Right, Both
+            };
+        public:
+            using reference = typename set_reference<Operation, typename std::iterator_traits<LeftIt>::reference,
+                    typename std::iterator_traits<RightIt>::reference>::type;
+            using value_type = std::conditional_t<Operation == SetOperation::Intersection, reference,
+                    std::remove_cv_t<std::remove_reference_t<reference>>>;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            using SynthesizedOperators<SetOperationIterator>::operator++;
+
+            constexpr SetOperationIterator() = default;
+
+            /**
+             * CTor. Searches the first element
+             * @param left beginning of the left range
+             * @param leftEnd end of the left range
+             * @param right beginning of the right range
+             * @param rightEnd end of the right range
+             * @param keys key functions and comparison. Must outlive the iterator
+             */
+            SetOperationIterator(LeftIt left, LeftIt leftEnd, RightIt right, RightIt rightEnd, const Keys &keys) :
+                    left(std::move(left)), leftEnd(std::move(leftEnd)), right(std::move(right)),
+                    rightEnd(std::move(rightEnd)), keys(std::addressof(keys)) {
+                settle();
+            }
+
+            /**
+             * @return current element
+             */
+            constexpr reference operator*() const {
+                if constexpr (Operation == SetOperation::Intersection) {
+                    return reference(*left, *right);
+                } else if constexpr (Operation == SetOperation::Difference) {
+                    return *left;
+                } else {
+                    if (side == Side::Right) {
+                        return *right;
+                    }
+
+                    return *left;
+                }
+            }
+
+            /**
+             * Advances to the next element
+             * @return reference to this
+             */
+            SetOperationIterator &operator++() {
+                if constexpr (Operation == SetOperation::Intersection) {
+                    ++left;
+                    ++right;
+                } else if constexpr (Operation == SetOperation::Difference) {
+                    ++left;
+                } else {
+                    if (side != Side::Right) {
+                        ++left;
+                    }
+
+                    if (side != Side::Left) {
+                        ++right;
+                    }
+                }
+
+                settle();
+                return *this;
+            }
+
+            /**
+             * Equality comparison
+             * @param other right hand side
+             * @return true if both iterators point to the same position in both ranges
+             */
+            constexpr bool operator==(const SetOperationIterator &other) const {
+                return left == other.left && right == other.right;
+            }
+
+        private:
+            bool less(const LeftIt &l, const RightIt &r) const {
+                return keys->comp(keys->left(*l), keys->right(*r));
+            }
+
+            bool greater(const LeftIt &l, const RightIt &r) const {
+                return keys->comp(keys->right(*r), keys->left(*l));
+            }
+
+            void finish() {
+                left = leftEnd;
+                right = rightEnd;
+            }
+
+            void settle() {
+                if constexpr (Operation == SetOperation::Intersection) {
+                    while (left != leftEnd && right != rightEnd) {
+                        if (less(left, right)) {
+                            auto &&row = *right;
+                            left = skip_less(std::move(left), leftEnd, keys->right(row), keys->left, keys->comp);
+                        } else if (greater(left, right)) {
+                            auto &&row = *left;
+                            right = skip_less(std::move(right), rightEnd, keys->left(row), keys->right, keys->comp);
+                        } else {
+                            return;
+                        }
+                    }
+
+                    finish();
+                } else if constexpr (Operation == SetOperation::Difference) {
+                    while (left != leftEnd) {
+                        if (right != rightEnd && greater(left, right)) {
+                            auto &&row = *left;
+                            right = skip_less(std::move(right), rightEnd, keys->left(row), keys->right, keys->comp);
+                        }
+
+                        if (right == rightEnd || less(left, right)) {
+                            return;
+                        }
+
+                        ++left;
+                        ++right;
+                    }
+
+                    finish();
+                } else {
+                    if (left == leftEnd) {
+                        side = Side::Right;
+                    } else if (right == rightEnd || less(left, right)) {
+                        side = Side::Left;
+                    } else if (greater(left, right)) {
+                        side = Side::Right;
+                    } else {
+                        side = Side::Both;
+                    }
+                }
+            }
+
+            LeftIt left{};
+            LeftIt leftEnd{};
+            RightIt right{};
+            RightIt rightEnd{};
+            const Keys *keys = nullptr;
+            Side side = Side::Both;
+        };
+
+        /**
+         * @brief Lazy set operation over two sorted ranges
+         * @tparam Left left range type. Begin and end must have the same type unless the range is random access
+         * @tparam Right right range type. Begin and end must have the same type unless the range is random access
+         * @tparam LeftKey key function type of the left range
+         * @tparam RightKey key function type of the right range
+         * @tparam Compare comparison type
+         * @tparam Operation set operation
+         */
+        template<typename Left, typename Right, typename LeftKey, typename RightKey, typename Compare,
+                 SetOperation Operation>
+        struct SetOperationView DERIVE_VIEW_INTERFACE(SetOperationView<Left, Right, LeftKey, RightKey, Compare,
+                                                      Operation>) {
+        private:
+            using Keys = SetKeys<LeftKey, RightKey, Compare>;
+            template<bool Const, typename Range>
+            using Iterator = decltype(std::begin(std::declval<std::add_lvalue_reference_t<
+                    traits::const_if_t<Const, std::remove_reference_t<Range>>>>()));
+            template<bool Const>
+            using SetIterator = SetOperationIterator<Iterator<Const, Left>, Iterator<Const, Right>, Keys, Operation>;
+        public:
+            /**
+             * CTor.
+             * @tparam L left range type
+             * @tparam R right range type
+             * @param left left range
+             * @param right right range
+             * @param keys key functions and comparison
+             */
+            template<typename L, typename R>
+            constexpr SetOperationView(L &&left, R &&right, Keys keys) :
+                    ranges(std::forward<L>(left), std::forward<R>(right), std::move(keys)) {}
+
+            SetOperationView() = default;
+
+            /**
+             * @return SetOperationIterator to the first element
+             */
+            auto begin() {
+                auto &[left, right, keys] = ranges;
+                return SetIterator<false>(std::begin(left), common_end(left), std::begin(right), common_end(right),
+                                          keys);
+            }
+
+            /**
+             * @return SetOperationIterator representing the end of the view
+             */
+            auto end() {
+                auto &[left, right, keys] = ranges;
+                return SetIterator<false>(common_end(left), common_end(left), common_end(right), common_end(right),
+                                          keys);
+            }
+
+            /**
+             * @copydoc SetOperationView::begin()
+             */
+            template<bool C = true>
+            auto begin() const -> SetIterator<C> {
+                auto &[left, right, keys] = ranges;
+                return SetIterator<true>(std::begin(left), common_end(left), std::begin(right), common_end(right),
+                                         keys);
+            }
+
+            /**
+             * @copydoc SetOperationView::end()
+             */
+            template<bool C = true>
+            auto end() const -> SetIterator<C> {
+                auto &[left, right, keys] = ranges;
+                return SetIterator<true>(common_end(left), common_end(left), common_end(right), common_end(right),
+                                         keys);
+            }
+
+        private:
+            std::tuple<Left, Right, Keys> ranges;
+        };
+
+        template<SetOperation Operation, typename Left, typename Right, typename LeftKey, typename RightKey,
+                 typename Compare>
+        constexpr auto make_set_view(Left &&left, Right &&right, LeftKey leftKey, RightKey rightKey, Compare comp) {
+            using Keys = SetKeys<LeftKey, RightKey, Compare>;
+            return SetOperationView<Left, Right, LeftKey, RightKey, Compare, Operation>(
+                    std::forward<Left>(left), std::forward<Right>(right),
+                    Keys{std::move(leftKey), std::move(rightKey), std::move(comp)});
+        }
+    }
+
+    /**
+     * Lazy intersection of two sorted ranges. Produces pairs (leftElement, rightElement) with equivalent keys.
+     * Duplicates are matched one to one like in std::set_intersection. Non-matching runs are skipped by galloping,
+     * which makes intersections of a small and a large range fast.
+     * @tparam Left left range type (e.g. impl::ZipView)
+     * @tparam Right right range type (e.g. impl::ZipView)
+     * @tparam LeftKey key function type of the left range
+     * @tparam RightKey key function type of the right range
+     * @tparam Compare comparison type
+     * @param left left range sorted by leftKey. Temporaries are moved into the view
+     * @param right right range sorted by rightKey. Temporaries are moved into the view
+     * @param leftKey function that returns the key of a left element, e.g. element<0>{} (default: the element)
+     * @param rightKey function that returns the key of a right element (default: the element)
+     * @param comp strict weak ordering of the keys that both ranges are sorted by (default std::less)
+     * @return impl::SetOperationView
+     * @relatesalso impl::SetOperationView
+     */
+    template<typename Left, typename Right, typename LeftKey = impl::Identity, typename RightKey = impl::Identity,
+             typename Compare = std::less<>>
+    constexpr auto set_intersection_view(Left &&left, Right &&right, LeftKey leftKey = {}, RightKey rightKey = {},
+                                         Compare comp = {}) {
+        return impl::make_set_view<impl::SetOperation::Intersection>(
+                std::forward<Left>(left), std::forward<Right>(right), std::move(leftKey), std::move(rightKey),
+                std::move(comp));
+    }
+
+    /**
+     * Lazy union of two sorted ranges. Produces the elements of both ranges in sorted order. Elements with equivalent
+     * keys are produced once (from the left range). If the reference types of both ranges differ, elements are
+     * produced by value.
+     * @copydetails set_intersection_view
+     */
+    template<typename Left, typename Right, typename LeftKey = impl::Identity, typename RightKey = impl::Identity,
+             typename Compare = std::less<>>
+    constexpr auto set_union_view(Left &&left, Right &&right, LeftKey leftKey = {}, RightKey rightKey = {},
+                                  Compare comp = {}) {
+        return impl::make_set_view<impl::SetOperation::Union>(
+                std::forward<Left>(left), std::forward<Right>(right), std::move(leftKey), std::move(rightKey),
+                std::move(comp));
+    }
+
+    /**
+     * Lazy difference of two sorted ranges. Produces the elements of the left range that have no equivalent element
+     * in the right range. Duplicates are matched one to one like in std::set_difference. Runs of the right range are
+     * skipped by galloping.
+     * @copydetails set_intersection_view
+     */
+    template<typename Left, typename Right, typename LeftKey = impl::Identity, typename RightKey = impl::Identity,
+             typename Compare = std::less<>>
+    constexpr auto set_difference_view(Left &&left, Right &&right, LeftKey leftKey = {}, RightKey rightKey = {},
+                                       Compare comp = {}) {
+        return impl::make_set_view<impl::SetOperation::Difference>(
+                std::forward<Left>(left), std::forward<Right>(right), std::move(leftKey), std::move(rightKey),
+                std::move(comp));
+    }
+}
+
+#endif //ITERATORTOOLS_SETOPERATIONS_HPP
@@ -0,0 +1,168 @@
+/**
+ * @file SharedCounter.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains a range of integers that is shared between threads. Iterators fetch chunks of
+ * consecutive numbers from a common atomic counter, so every number is produced exactly once across all threads.
+ * This gives dynamic load balancing without a scheduler.
+ */
+
+#ifndef ITERATORTOOLS_SHAREDCOUNTER_HPP
+#define ITERATORTOOLS_SHAREDCOUNTER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "Iterators.hpp"
+#include "ThreadPool.hpp"
+
+namespace iterators {
+    namespace impl {
+        template<typename T>
+        struct SharedCounterRange;
+
+        /**
+         * @brief Input iterator over the numbers of a SharedCounterRange. Fetches a new chunk of numbers from the
+         * shared counter whenever the current chunk is exhausted. A default constructed iterator marks the end.
+         * @tparam T integral type
+         */
+        template<typename T>
+        struct SharedCounterIterator : public SynthesizedOperators<SharedCounterIterator<T>> {
+            using value_type = T;
+            using reference = T;
+            using pointer = void;
+            using iterator_category = std::input_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+
+            using SynthesizedOperators<SharedCounterIterator<T>>::operator++;
+
+            /**
+             * Creates an end iterator
+             */
+            constexpr SharedCounterIterator() noexcept = default;
+
+            /**
+             * CTor. Fetches the first chunk
+             * @param range shared range
+             */
+            explicit SharedCounterIterator(SharedCounterRange<T> &range) noexcept: range(&range) {
+                fetch();
+            }
+
+            /**
+             * Advances to the next number. Fetches a new chunk if the current one is exhausted
+             * @return reference to this
+             */
+            SharedCounterIterator &operator++() noexcept {
+                if (++current == chunkEnd) {
+                    fetch();
+                }
+
+                return *this;
+            }
+
+            /**
+             * Equality comparison.
+             * @param other right hand side
+             * @return true if both iterators are exhausted or if both refer to the same number of the same range
+             */
+            constexpr bool operator==(const SharedCounterIterator &other) const noexcept {
+                return range == other.range && (range == nullptr || current == other.current);
+            }
+
+            /**
+             * @return the current number
+             */
+            constexpr T operator*() const noexcept {
+                return current;
+            }
+
+        private:
+            void fetch() noexcept {
+                auto start = range->next.fetch_add(range->grain, std::memory_order_relaxed);
+                if (start >= range->stop) {
+                    range = nullptr;
+                    return;
+                }
+
+                current = start;
+                chunkEnd = static_cast<T>(start + std::min<T>(range->grain, static_cast<T>(range->stop - start)));
+            }
+
+            SharedCounterRange<T> *range = nullptr;
+            T current = T(0);
+            T chunkEnd = T(0);
+        };
+
+        /**
+         * @brief Range of integers [start, stop) that is consumed cooperatively by all threads that iterate over it.
+         * Every call to begin() returns an iterator that takes its numbers from the same shared counter.
+         * @tparam T integral type
+         * @note The range is neither copyable nor movable. It must outlive all iterators.
+         */
+        template<typename T>
+        struct SharedCounterRange {
+            static_assert(std::is_integral_v<T>, "shared counter ranges require an integral type");
+
+            /**
+             * CTor
+             * @param start start of the range
+             * @param stop end of the range (exclusive)
+             * @param grain number of consecutive numbers fetched at once. Must be positive
+             * @note stop + (number of threads) * grain must be representable in T
+             */
+            constexpr SharedCounterRange(T start, T stop, T grain) noexcept: next(start), stop(stop), grain(grain) {}
+
+            SharedCounterRange(const SharedCounterRange &) = delete;
+            SharedCounterRange &operator=(const SharedCounterRange &) = delete;
+
+            /**
+             * @return iterator that takes its numbers from the shared counter
+             */
+            [[nodiscard]] SharedCounterIterator<T> begin() noexcept {
+                return SharedCounterIterator<T>(*this);
+            }
+
+            /**
+             * @return end iterator
+             */
+            [[nodiscard]] static constexpr SharedCounterIterator<T> end() noexcept {
+                return SharedCounterIterator<T>();
+            }
+
+        private:
+            friend struct SharedCounterIterator<T>;
+            alignas(CacheLineSize) std::atomic<T> next;
+            T stop;
+            T grain;
+        };
+    }
+
+    /**
+     * Creates a range of integers [start, stop) that can be iterated concurrently by multiple threads. Each iterator
+     * fetches chunks of grain consecutive numbers from a shared atomic counter, so every number is visited by exactly
+     * one thread.
+     * @code
+     * auto shared = shared_counter_range(std::size_t(0), rows.size(), std::size_t(64));
+     * // on every thread
+     * for (auto i : shared) {
+     *     process(rows[i]);
+     * }
+     * @endcode
+     * @tparam T integral type
+     * @param start first value
+     * @param stop end of the range (exclusive)
+     * @param grain number of consecutive numbers fetched at once (default 1). Larger values reduce contention
+     * @return impl::SharedCounterRange
+     * @relatesalso impl::SharedCounterRange
+     */
+    template<typename T>
+    auto shared_counter_range(T start, T stop, T grain = T(1)) noexcept {
+        return impl::SharedCounterRange<T>(start, stop, grain);
+    }
+}
+
+#endif //ITERATORTOOLS_SHAREDCOUNTER_HPP
@@ -0,0 +1,340 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "Algorithms.hpp"
+
+TEST(Algorithms, reduce) {
+    using namespace iterators;
+    for (int size = 0; size < 40; ++size) {
+        std::vector<int> values(static_cast<std::size_t>(size));
+        std::iota(values.begin(), values.end(), 1);
+        std::list<int> list(values.begin(), values.end());
+        auto expected = std::accumulate(values.begin(), values.end(), 5);
+        EXPECT_EQ(reduce(values, 5), expected);
+        EXPECT_EQ(reduce<1>(values, 5), expected);
+        EXPECT_EQ(reduce<3>(values, 5), expected);
+        EXPECT_EQ(reduce<8>(list, 5), expected);
+        EXPECT_EQ(reduce<3>(list, 5), expected);
+    }
+
+    std::vector<int> numbers{3, 9, -2, 7, 4, 1};
+    EXPECT_EQ(reduce(numbers, 0, [](int a, int b) { return std::max(a, b); }), 9);
+    EXPECT_EQ(reduce<2>(numbers, 1, std::multiplies<>{}), 3 * 9 * -2 * 7 * 4);
+}
+
+TEST(Algorithms, floating_point_sum) {
+    using namespace iterators;
+    for (std::size_t size : {0, 1, 7, 16, 33, 1001}) {
+        std::vector<double> doubles(size);
+        std::vector<float> floats(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            doubles[i] = 0.5 * static_cast<double>(i);
+            floats[i] = 0.25f * static_cast<float>(i % 17);
+        }
+
+        EXPECT_DOUBLE_EQ(reduce(doubles, 1.0), std::accumulate(doubles.begin(), doubles.end(), 1.0));
+        EXPECT_FLOAT_EQ(reduce(floats, 0.f), std::accumulate(floats.begin(), floats.end(), 0.f));
+    }
+}
+
+TEST(Algorithms, integer_sum) {
+    using namespace iterators;
+    for (std::size_t size : {0, 1, 7, 16, 33, 1001}) {
+        std::vector<std::int32_t> ints(size);
+        std::vector<std::int64_t> longs(size);
+        std::vector<std::int32_t> weights(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            ints[i] = static_cast<std::int32_t>(i % 23) - 11;
+            longs[i] = static_cast<std::int64_t>(i) * 3000000000;
+            weights[i] = static_cast<std::int32_t>(i % 3) + 1;
+        }
+
+        EXPECT_EQ(reduce(ints, 5), std::accumulate(ints.begin(), ints.end(), 5));
+        EXPECT_EQ(reduce(longs, std::int64_t(-1)), std::accumulate(longs.begin(), longs.end(), std::int64_t(-1)));
+        EXPECT_EQ(transform_reduce(zip(ints, weights), 2, std::plus<>{}, product{}),
+                  std::inner_product(ints.begin(), ints.end(), weights.begin(), 2));
+    }
+}
+
+TEST(Algorithms, dot_product) {
+    using namespace iterators;
+    for (std::size_t size : {0, 3, 8, 31, 500}) {
+        std::vector<double> a(size);
+        std::vector<double> b(size + 3, 2.0);
+        std::vector<float> c(size);
+        std::vector<float> d(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            a[i] = static_cast<double>(i);
+            c[i] = static_cast<float>(i % 5);
+            d[i] = 0.5f;
+        }
+
+        EXPECT_DOUBLE_EQ(transform_reduce(zip(a, b), 0.0, std::plus<>{}, product{}),
+                         std::inner_product(a.begin(), a.end(), b.begin(), 0.0));
+        EXPECT_FLOAT_EQ(transform_reduce(zip(c, d), 1.f, std::plus<float>{}, product{}),
+                        std::inner_product(c.begin(), c.end(), d.begin(), 1.f));
+        std::list<double> list(b.begin(), b.end());
+        EXPECT_DOUBLE_EQ(transform_reduce(zip(a, list), 0.0, std::plus<>{}, product{}),
+                         std::inner_product(a.begin(), a.end(), b.begin(), 0.0));
+    }
+}
+
+TEST(Algorithms, indexed_gather_reduce) {
+    using namespace iterators;
+    std::vector<double> table(1000);
+    std::iota(table.begin(), table.end(), 0.5);
+    for (std::size_t size : {0, 1, 7, 256, 257, 1000}) {
+        std::vector<std::uint32_t> unsignedIndices(size);
+        std::vector<std::int64_t> indices(size);
+        double expected = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            indices[i] = static_cast<std::int64_t>((i * 37) % table.size());
+            unsignedIndices[i] = static_cast<std::uint32_t>(indices[i]);
+            expected += table[static_cast<std::size_t>(indices[i])];
+        }
+
+        EXPECT_DOUBLE_EQ(reduce(indexed(table, indices), 1.0), expected + 1);
+        EXPECT_DOUBLE_EQ(reduce(indexed(table, unsignedIndices), 1.0), expected + 1);
+        EXPECT_DOUBLE_EQ(transform_reduce(indexed(table, indices), 0.0, std::plus<>{}, [](double d) { return 2 * d; }),
+                         2 * expected);
+    }
+
+    std::vector<int> numbers{3, 1, 4, 1, 5};
+    std::list<int> listIndices{4, 4, 0};
+    EXPECT_EQ(reduce(indexed(numbers, listIndices), 0), 13);
+    EXPECT_EQ(reduce(indexed(numbers, std::vector{2, 0, 2}), 1, std::multiplies<>{}), 48);
+}
+
+TEST(Algorithms, zipped_and_enumerated) {
+    using namespace iterators;
+    std::vector<int> values{4, 5, 6};
+    auto weighted = transform_reduce(enumerate(values), std::size_t(0), std::plus<>{}, [](auto row) {
+        auto [index, value] = row;
+        return index * static_cast<std::size_t>(value);
+    });
+
+    EXPECT_EQ(weighted, 5 + 12);
+    std::vector<int> factors{1, 2, 3};
+    EXPECT_EQ(transform_reduce<2>(zip(values, factors, values), 0, std::plus<>{}, product{}), 16 + 50 + 108);
+    EXPECT_EQ(product{}(2, 3, 4), 24);
+}
+
+namespace {
+    struct NoDefault {
+        explicit NoDefault(int value) : value(value) {}
+        int value;
+    };
+}
+
+TEST(Algorithms, non_default_constructible) {
+    using namespace iterators;
+    std::list<int> values{1, 2, 3, 4, 5, 6, 7};
+    auto add = [](NoDefault a, NoDefault b) { return NoDefault(a.value + b.value); };
+    auto map = [](int value) { return NoDefault(value); };
+    EXPECT_EQ(transform_reduce(values, NoDefault(0), add, map).value, 28);
+    std::vector<int> vector(values.begin(), values.end());
+    EXPECT_EQ(transform_reduce(vector, NoDefault(1), add, map).value, 29);
+}
+
+TEST(Algorithms, scan_views) {
+    using namespace iterators;
+    std::vector<int> counts{3, 0, 2, 5, 1};
+    std::vector<int> inclusive(inclusive_scan(counts).begin(), inclusive_scan(counts).end());
+    EXPECT_EQ(inclusive, (std::vector{3, 3, 5, 10, 11}));
+    auto offsets = exclusive_scan(counts, std::size_t(0));
+    EXPECT_EQ(offsets.size(), counts.size());
+    std::vector<std::size_t> expected{0, 3, 3, 5, 10};
+    EXPECT_TRUE(std::equal(offsets.begin(), offsets.end(), expected.begin(), expected.end()));
+    std::vector<int> products(inclusive_scan(counts, std::multiplies<>{}, 2).begin(),
+                              inclusive_scan(counts, std::multiplies<>{}, 2).end());
+    EXPECT_EQ(products, (std::vector{6, 0, 0, 0, 0}));
+    std::list<int> list(counts.begin(), counts.end());
+    std::size_t index = 0;
+    for (auto [count, offset] : zip(list, exclusive_scan(list, 10))) {
+        EXPECT_EQ(offset, 10 + static_cast<int>(expected[index++]));
+        EXPECT_EQ(count, counts[index - 1]);
+    }
+
+    std::vector<int> empty;
+    EXPECT_EQ(inclusive_scan(empty).begin(), inclusive_scan(empty).end());
+}
+
+TEST(Algorithms, scan_zipped) {
+    using namespace iterators;
+    std::vector<int> prices{1, 2, 3};
+    std::vector<int> quantities{4, 5, 6};
+    auto revenue = exclusive_scan(zip(prices, quantities), 0, [](int sum, auto row) { return sum + product{}(row); });
+    std::vector<int> result(revenue.begin(), revenue.end());
+    EXPECT_EQ(result, (std::vector{0, 4, 14}));
+    static_assert(std::is_same_v<std::iterator_traits<decltype(revenue.begin())>::iterator_category,
+                                 std::forward_iterator_tag>);
+}
+
+TEST(Algorithms, scan_applies_op_once) {
+    using namespace iterators;
+    std::vector<int> values{1, 2, 3, 4, 5};
+    std::size_t calls = 0;
+    auto counting = [&calls](int lhs, int rhs) {
+        ++calls;
+        return lhs + rhs;
+    };
+
+    auto inclusive = inclusive_scan(values, counting, 0);
+    std::vector<int> sums;
+    for (auto it = inclusive.begin(); it != inclusive.end(); ++it) {
+        sums.push_back(*it);
+        EXPECT_EQ(*it, sums.back());
+    }
+
+    EXPECT_EQ(sums, (std::vector{1, 3, 6, 10, 15}));
+    EXPECT_EQ(calls, values.size());
+    calls = 0;
+    auto skipped = inclusive.begin();
+    ++skipped;
+    ++skipped;
+    EXPECT_EQ(*skipped, 6);
+    auto copy = skipped;
+    EXPECT_EQ(*++copy, 10);
+    EXPECT_EQ(calls, 4);
+}
+
+TEST(Algorithms, compact) {
+    using namespace iterators;
+    for (std::size_t size : {0, 1, 63, 64, 65, 1000}) {
+        std::vector<int> ids(size);
+        std::vector<double> values(size);
+        std::vector<std::string> names(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            ids[i] = static_cast<int>(i);
+            values[i] = static_cast<double>((i * 37) % 11);
+            names[i] = std::to_string(i);
+        }
+
+        auto pred = [](auto row) { return std::get<1>(row) < 5.0; };
+        std::vector<int> outIds(size, -1);
+        std::vector<double> outValues(size);
+        std::vector<std::string> outNames(size);
+        auto end = compact(zip(ids, values, names), pred, zip(outIds, outValues, outNames));
+        std::vector<int> expected;
+        std::copy_if(ids.begin(), ids.end(), std::back_inserter(expected), [&values](int id) {
+            return values[static_cast<std::size_t>(id)] < 5.0;
+        });
+
+        ASSERT_EQ(static_cast<std::size_t>(end - zip(outIds, outValues, outNames).begin()), expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(outIds[i], expected[i]);
+            EXPECT_EQ(outValues[i], values[static_cast<std::size_t>(expected[i])]);
+            EXPECT_EQ(outNames[i], std::to_string(expected[i]));
+        }
+
+        EXPECT_TRUE(std::all_of(outIds.begin() + static_cast<long>(expected.size()), outIds.end(),
+                                [](int id) { return id == -1; }));
+        auto inPlace = compact(zip(ids, values), pred, zip(ids, values)) - zip(ids, values).begin();
+        EXPECT_EQ(std::vector<int>(ids.begin(), ids.begin() + inPlace), expected);
+    }
+}
+
+TEST(Algorithms, compact_fallback) {
+    using namespace iterators;
+    std::list<int> values{1, 2, 3, 4, 5, 6};
+    std::vector<bool> flags{true, false, true, false, true, false};
+    std::vector<int> out(3);
+    auto end = compact(zip(values, flags), [](auto row) { return std::get<1>(row); }, zip(out, std::vector<bool>(3)));
+    EXPECT_EQ(out, (std::vector{1, 3, 5}));
+    (void) end;
+    std::vector<bool> bits(100);
+    std::vector<int> numbers(100);
+    std::iota(numbers.begin(), numbers.end(), 0);
+    auto count = compact(numbers, [](int n) { return n % 3 == 0; }, bits) - bits.begin();
+    EXPECT_EQ(count, 34);
+    EXPECT_EQ(std::count(bits.begin(), bits.end(), true), 33);
+}
+
+TEST(Algorithms, bucketize) {
+    using namespace iterators;
+    for (std::size_t numBuckets : {1, 7, 256}) {
+        constexpr std::size_t Size = 5000;
+        std::vector<unsigned> keys(Size);
+        std::vector<std::string> payload(Size);
+        for (std::size_t i = 0; i < Size; ++i) {
+            keys[i] = static_cast<unsigned>((i * 7919) % 1000);
+            payload[i] = std::to_string(i);
+        }
+
+        auto bucketFn = [numBuckets](unsigned key) { return key % numBuckets; };
+        std::vector<unsigned> outKeys(Size);
+        std::vector<std::string> outPayload(Size);
+        auto offsets = bucketize(zip(keys, payload), numBuckets, zip(outKeys, outPayload), bucketFn);
+        ASSERT_EQ(offsets.size(), numBuckets + 1);
+        EXPECT_EQ(offsets.front(), 0);
+        EXPECT_EQ(offsets.back(), Size);
+        std::vector<std::size_t> order(Size);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return bucketFn(keys[a]) < bucketFn(keys[b]);
+        });
+
+        for (std::size_t i = 0; i < Size; ++i) {
+            EXPECT_EQ(outKeys[i], keys[order[i]]);
+            EXPECT_EQ(outPayload[i], payload[order[i]]);
+        }
+
+        for (std::size_t bucket = 0; bucket < numBuckets; ++bucket) {
+            for (auto i = offsets[bucket]; i < offsets[bucket + 1]; ++i) {
+                EXPECT_EQ(bucketFn(outKeys[i]), bucket);
+            }
+        }
+    }
+}
+
+TEST(Algorithms, bucketize_key_index) {
+    using namespace iterators;
+    std::vector<double> values{0.5, 1.5, 2.5, 3.5};
+    std::vector<int> buckets{1, 0, 1, 0};
+    std::vector<double> outValues(4);
+    std::vector<int> outBuckets(4);
+    auto offsets = bucketize<1>(zip(values, buckets), 3, zip(outValues, outBuckets));
+    EXPECT_EQ(offsets, (std::vector<std::size_t>{0, 2, 4, 4}));
+    EXPECT_EQ(outValues, (std::vector{1.5, 3.5, 0.5, 2.5}));
+}
+
+TEST(Algorithms, top_k) {
+    using namespace iterators;
+    std::vector<int> scores{5, 1, 9, 3, 9, 7, 1, 5, 8, 2};
+    std::vector<std::string> names{"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"};
+    auto byScore = [](const auto &lhs, const auto &rhs) { return std::get<0>(lhs) > std::get<0>(rhs); };
+    std::vector<std::size_t> order(scores.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](auto lhs, auto rhs) { return scores[lhs] > scores[rhs]; });
+    for (std::size_t k : {0, 1, 3, 5, 10, 20}) {
+        auto best = top_k(zip(scores, names), k, byScore);
+        std::vector<std::string> expected;
+        for (std::size_t i = 0; i < std::min(k, order.size()); ++i) {
+            expected.emplace_back(names[order[i]]);
+        }
+
+        std::vector<std::string> actual;
+        for (auto [score, name] : best) {
+            actual.emplace_back(name);
+        }
+
+        EXPECT_EQ(actual, expected);
+    }
+
+    auto smallest = top_k(scores, 4);
+    EXPECT_EQ(std::vector<int>(smallest.begin(), smallest.end()), (std::vector<int>{1, 1, 2, 3}));
+    for (auto [score, name] : top_k(zip(scores, names), 2, byScore)) {
+        name += "!";
+    }
+
+    EXPECT_EQ(names[2], "c!");
+    EXPECT_EQ(names[4], "e!");
+    auto owning = top_k(std::vector<int>{4, 2, 6}, 2, std::greater<>{});
+    EXPECT_EQ(std::vector<int>(owning.begin(), owning.end()), (std::vector<int>{6, 4}));
+}
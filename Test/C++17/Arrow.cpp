@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Arrow.hpp"
+
+TEST(Arrow, export_import_roundtrip) {
+    using namespace iterators;
+    std::vector<std::int32_t> ids{1, 2, 3, 4};
+    std::vector<double> prices{0.5, 1.5, 2.5, 3.5};
+    ArrowArray array{};
+    ArrowSchema schema{};
+    arrow_export(zip(ids, prices), {"id", "price"}, &array, &schema);
+    ASSERT_NE(array.release, nullptr);
+    ASSERT_NE(schema.release, nullptr);
+    EXPECT_STREQ(schema.format, "+s");
+    ASSERT_EQ(schema.n_children, 2);
+    EXPECT_STREQ(schema.children[0]->format, "i");
+    EXPECT_STREQ(schema.children[0]->name, "id");
+    EXPECT_STREQ(schema.children[1]->format, "g");
+    EXPECT_STREQ(schema.children[1]->name, "price");
+    EXPECT_EQ(array.length, 4);
+    EXPECT_EQ(array.children[0]->buffers[1], ids.data());
+    EXPECT_EQ(array.children[1]->buffers[1], prices.data());
+    std::size_t row = 0;
+    for (auto [id, price] : arrow_struct<std::int32_t, double>(array, schema)) {
+        EXPECT_EQ(&id, &ids[row]);
+        EXPECT_EQ(price, prices[row]);
+        ++row;
+    }
+
+    EXPECT_EQ(row, ids.size());
+    auto column = arrow_column<double>(*array.children[1], *schema.children[1]);
+    EXPECT_EQ(column.data(), prices.data());
+    EXPECT_EQ(column.size(), 4);
+    EXPECT_THROW(arrow_column<float>(*array.children[1], *schema.children[1]), std::invalid_argument);
+    EXPECT_THROW((arrow_struct<std::int32_t>(array, schema)), std::invalid_argument);
+    EXPECT_THROW((arrow_struct<std::int64_t, double>(array, schema)), std::invalid_argument);
+    schema.release(&schema);
+    array.release(&array);
+    EXPECT_EQ(schema.release, nullptr);
+    EXPECT_EQ(array.release, nullptr);
+}
+
+TEST(Arrow, owned_columns_and_moved_children) {
+    using namespace iterators;
+    std::vector<std::uint64_t> values(1000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = i * i;
+    }
+
+    const auto *data = values.data();
+    ArrowArray array{};
+    ArrowSchema schema{};
+    arrow_export(zip(std::move(values), std::vector<float>(1000, 2.f)), {"square", "two"}, &array, &schema);
+    EXPECT_EQ(array.children[0]->buffers[1], data);
+    // move the first child out and release the parents, the child must stay valid
+    ArrowArray child = *array.children[0];
+    ArrowSchema childSchema = *schema.children[0];
+    array.children[0]->release = nullptr;
+    schema.children[0]->release = nullptr;
+    array.release(&array);
+    schema.release(&schema);
+    EXPECT_STREQ(childSchema.name, "square");
+    auto squares = arrow_column<std::uint64_t>(child, childSchema);
+    ASSERT_EQ(squares.size(), 1000);
+    for (auto [i, square] : enumerate(squares)) {
+        EXPECT_EQ(square, i * i);
+    }
+
+    child.release(&child);
+    childSchema.release(&childSchema);
+    EXPECT_EQ(child.release, nullptr);
+}
+
+TEST(Arrow, import_offsets_and_validity) {
+    using namespace iterators;
+    std::vector<std::int16_t> values{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::uint8_t validity[2]{0b10110110, 0b00000011};
+    std::uint8_t flags[2]{0b01010101, 0b00000001};
+    const void *valueBuffers[2]{validity, values.data()};
+    const void *flagBuffers[2]{nullptr, flags};
+    ArrowArray valueArray{10, 3, 0, 2, 0, valueBuffers, nullptr, nullptr, nullptr, nullptr};
+    ArrowArray flagArray{10, 0, 0, 2, 0, flagBuffers, nullptr, nullptr, nullptr, nullptr};
+    ArrowSchema valueSchema{"s", "value", nullptr, ARROW_FLAG_NULLABLE, 0, nullptr, nullptr, nullptr, nullptr};
+    ArrowSchema flagSchema{"b", "flag", nullptr, 0, 0, nullptr, nullptr, nullptr, nullptr};
+    ArrowArray *childArrays[2]{&valueArray, &flagArray};
+    ArrowSchema *childSchemas[2]{&valueSchema, &flagSchema};
+    const void *structBuffers[1]{nullptr};
+    ArrowArray structArray{6, 0, 3, 1, 2, structBuffers, childArrays, nullptr, nullptr, nullptr};
+    ArrowSchema structSchema{"+s", nullptr, nullptr, 0, 2, childSchemas, nullptr, nullptr, nullptr};
+    std::vector<std::int16_t> importedValues;
+    std::vector<bool> importedFlags;
+    for (auto [value, flag] : arrow_struct<std::int16_t, bool>(structArray, structSchema)) {
+        importedValues.emplace_back(value);
+        importedFlags.emplace_back(flag);
+    }
+
+    EXPECT_EQ(importedValues, (std::vector<std::int16_t>{3, 4, 5, 6, 7, 8}));
+    EXPECT_EQ(importedFlags, (std::vector<bool>{false, true, false, true, false, true}));
+    valueArray.offset = 1;
+    valueArray.length = 9;
+    auto valid = arrow_validity(valueArray);
+    ASSERT_TRUE(valid.has_value());
+    EXPECT_EQ(std::vector<bool>(valid->begin(), valid->end()),
+              (std::vector<bool>{true, true, false, true, true, false, true, true, true}));
+    EXPECT_EQ(arrow_column<std::int16_t>(valueArray, valueSchema)[0], 1);
+    EXPECT_FALSE(arrow_validity(flagArray).has_value());
+}
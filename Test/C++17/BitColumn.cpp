@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <numeric>
+#include <vector>
+#include "BitColumn.hpp"
+
+namespace {
+    std::vector<bool> make_bits(std::size_t size, std::size_t stride) {
+        std::vector<bool> bits(size);
+        for (std::size_t i = 0; i < size; i += stride) {
+            bits[i] = true;
+        }
+
+        return bits;
+    }
+}
+
+TEST(BitColumn, count_and_find) {
+    using namespace iterators;
+    for (std::size_t size : {0, 1, 63, 64, 65, 200}) {
+        auto bits = make_bits(size, 7);
+        std::deque<bool> reference(bits.begin(), bits.end());
+        EXPECT_EQ(count_set(bits), static_cast<std::size_t>(std::count(bits.begin(), bits.end(), true)));
+        EXPECT_EQ(count_set(bits), count_set(reference));
+        EXPECT_EQ(count_set(bit_span(bits)), count_set(reference));
+        for (std::size_t from = 0; from <= size + 1; ++from) {
+            EXPECT_EQ(find_set(bits, from), find_set(reference, from));
+        }
+    }
+
+    std::vector<bool> sparse(1000);
+    EXPECT_EQ(find_set(sparse), 1000);
+    sparse[999] = true;
+    EXPECT_EQ(find_set(sparse), 999);
+    EXPECT_EQ(find_set(sparse, 999), 999);
+}
+
+TEST(BitColumn, bit_span_offset) {
+    using namespace iterators;
+    std::uint64_t words[3] = {0xF0F0F0F0F0F0F0F0ull, 0x1ull, 0x8000000000000000ull};
+    auto span = bit_span(words, 140, 4);
+    EXPECT_EQ(span.size(), 140);
+    std::vector<bool> expected;
+    for (std::size_t i = 4; i < 144; ++i) {
+        expected.emplace_back((words[i / 64] >> (i % 64)) & 1);
+    }
+
+    EXPECT_TRUE(std::equal(span.begin(), span.end(), expected.begin(), expected.end()));
+    EXPECT_EQ(count_set(span), static_cast<std::size_t>(std::count(expected.begin(), expected.end(), true)));
+    EXPECT_EQ(find_set(span, 57), 57);
+    EXPECT_EQ(find_set(span, 60), 60);
+    EXPECT_EQ(find_set(span, 61), 140);
+    span[1] = true;
+    EXPECT_EQ(words[0] & 0x20, 0x20);
+    EXPECT_EQ(words[2], 0x8000000000000000ull);
+}
+
+TEST(BitColumn, zip_column) {
+    using namespace iterators;
+    std::vector<bool> flags{true, false, true};
+    std::vector<int> values{1, 2, 3};
+    for (auto [flag, value] : zip(bit_span(flags), values)) {
+        if (flag) {
+            value *= 10;
+        }
+
+        flag = !flag;
+    }
+
+    EXPECT_EQ(values, (std::vector{10, 2, 30}));
+    EXPECT_EQ(flags, (std::vector{false, true, false}));
+    const auto &constFlags = flags;
+    static_assert(std::is_same_v<decltype(*bit_span(constFlags).begin()), bool>);
+}
+
+TEST(BitColumn, apply_mask) {
+    using namespace iterators;
+    auto mask = make_bits(130, 3);
+    std::vector<int> values(130, 1);
+    apply_mask(mask, values, 0);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], i % 3 == 0 ? 1 : 0);
+    }
+
+    std::list<int> listValues(5, 1);
+    apply_mask(std::vector<bool>{true, false, true}, listValues, 7);
+    EXPECT_EQ(listValues, (std::list{1, 7, 1, 1, 1}));
+    std::vector<bool> target(130, true);
+    apply_mask(mask, target, false);
+    EXPECT_EQ(target, mask);
+    std::vector<bool> inverse(130, false);
+    apply_mask(mask, inverse, true);
+    EXPECT_EQ(count_set(inverse), 130 - count_set(mask));
+    std::uint64_t words[3] = {~0ull, ~0ull, ~0ull};
+    apply_mask(std::vector<bool>(70, false), bit_span(words, 70, 10), false);
+    EXPECT_EQ(words[0], 0x3FFull);
+    EXPECT_EQ(words[1], ~0ull << 16);
+    EXPECT_EQ(words[2], ~0ull);
+}
+
+TEST(BitColumn, apply_mask_different_word_types) {
+    using namespace iterators;
+    const std::uint8_t validity[] = {0xF7, 0xEF};
+    std::vector<bool> target(16, true);
+    apply_mask(bit_span(validity, 16), target, false);
+    std::vector<bool> expected(16, true);
+    expected[3] = false;
+    expected[12] = false;
+    EXPECT_EQ(target, expected);
+    std::vector<std::uint8_t> bytes{0xFF, 0xFF, 0xFF};
+    apply_mask(make_bits(20, 3), bit_span(bytes.data(), 20), false);
+    for (std::size_t i = 0; i < 20; ++i) {
+        EXPECT_EQ(((bytes[i / 8] >> (i % 8)) & 1) != 0, i % 3 == 0) << i;
+    }
+
+    EXPECT_EQ(bytes[2] >> 4, 0xF);
+}
+
+TEST(BitColumn, find_set_narrow_words) {
+    using namespace iterators;
+    const std::uint8_t bytes[] = {0x81, 0x00, 0x10};
+    const std::uint16_t shorts[] = {0x8001, 0x0000, 0x0010};
+    for (std::size_t from = 0; from < 24; ++from) {
+        const std::size_t expected = from == 0 ? 0 : from <= 7 ? 7 : from <= 20 ? 20 : 24;
+        EXPECT_EQ(find_set(bit_span(bytes, 24), from), expected) << from;
+    }
+
+    EXPECT_EQ(find_set(bit_span(shorts, 48), 1), 15);
+    EXPECT_EQ(find_set(bit_span(shorts, 48), 16), 36);
+    EXPECT_EQ(find_set(bit_span(shorts, 48), 37), 48);
+}
+
+TEST(BitColumn, for_each_set) {
+    using namespace iterators;
+    auto mask = make_bits(300, 11);
+    std::vector<int> values(300);
+    std::iota(values.begin(), values.end(), 0);
+    std::vector<double> other(250, 1.0);
+    std::vector<int> selected;
+    for_each_set(mask, zip(values, other), [&selected](auto row) {
+        auto [value, weight] = row;
+        weight = 2.0;
+        selected.emplace_back(value);
+    });
+
+    std::vector<int> expected;
+    for (int i = 0; i < 250; i += 11) {
+        expected.emplace_back(i);
+    }
+
+    EXPECT_EQ(selected, expected);
+    EXPECT_EQ(std::count(other.begin(), other.end(), 2.0), static_cast<long>(expected.size()));
+    std::list<int> listValues(values.begin(), values.begin() + 40);
+    std::deque<bool> dequeMask(mask.begin(), mask.end());
+    std::vector<int> listSelected;
+    for_each_set(dequeMask, listValues, [&listSelected](int value) { listSelected.emplace_back(value); });
+    EXPECT_EQ(listSelected, (std::vector{0, 11, 22, 33}));
+    listSelected.clear();
+    for_each_set(mask, listValues, [&listSelected](int value) { listSelected.emplace_back(value); });
+    EXPECT_EQ(listSelected, (std::vector{0, 11, 22, 33}));
+    std::size_t count = 0;
+    for_each_set(mask, enumerate(values), [&count](auto) { ++count; });
+    EXPECT_EQ(count, count_set(mask));
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+#include "Columnar.hpp"
+
+TEST(Columnar, round_trip) {
+    using namespace iterators;
+    auto path = testing::TempDir() + "columnar_round_trip.bin";
+    std::vector<int> ids{1, 2, 3, 4, 5};
+    std::vector<double> values{0.1, 0.2, 0.3, 0.4, 0.5};
+    std::array<char, 5> tags{'a', 'b', 'c', 'd', 'e'};
+    write_columns(path, zip(ids, values, tags));
+    auto columns = read_columns<const int, const double, const char>(path, Advice::Sequential);
+    ASSERT_EQ(columns.size(), 5);
+    std::size_t row = 0;
+    for (auto [id, value, tag] : columns) {
+        EXPECT_EQ(id, ids[row]);
+        EXPECT_EQ(value, values[row]);
+        EXPECT_EQ(tag, tags[row]);
+        ++row;
+    }
+
+    EXPECT_EQ(row, 5);
+}
+
+TEST(Columnar, aligned_blocks) {
+    using namespace iterators;
+    auto path = testing::TempDir() + "columnar_aligned.bin";
+    std::vector<char> small{1, 2, 3};
+    std::vector<std::uint64_t> large{4, 5, 6};
+    write_columns(path, zip(small, large));
+    auto columns = read_columns<const char, const std::uint64_t>(path);
+    auto [first, second] = *columns.begin();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&first) % impl::ColumnAlignment, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&second) % impl::ColumnAlignment, 0);
+    EXPECT_EQ(second, 4);
+}
+
+TEST(Columnar, non_contiguous_columns) {
+    using namespace iterators;
+    auto path = testing::TempDir() + "columnar_non_contiguous.bin";
+    std::list<float> floats{1.f, 2.f, 3.f};
+    std::vector<bool> flags{true, false, true, true};
+    write_columns(path, zip_enumerate(floats, flags, 10));
+    auto columns = read_columns<const int, const float, const bool>(path);
+    std::vector<std::tuple<int, float, bool>> result(columns.begin(), columns.end());
+    EXPECT_EQ(result, (std::vector<std::tuple<int, float, bool>>{{10, 1.f, true}, {11, 2.f, false},
+                                                                 {12, 3.f, true}}));
+}
+
+TEST(Columnar, writable) {
+    using namespace iterators;
+    auto path = testing::TempDir() + "columnar_writable.bin";
+    write_columns(path, zip(std::vector{1, 2, 3}, std::vector{4l, 5l, 6l}));
+    for (auto [a, b] : read_columns<int, const long>(path)) {
+        a += static_cast<int>(b);
+    }
+
+    auto columns = read_columns<const int, const long>(path);
+    EXPECT_EQ(std::get<0>(columns[0]), 5);
+    EXPECT_EQ(std::get<0>(columns[2]), 9);
+}
+
+TEST(Columnar, empty) {
+    using namespace iterators;
+    auto path = testing::TempDir() + "columnar_empty.bin";
+    std::vector<int> empty;
+    write_columns(path, zip(empty, empty));
+    auto columns = read_columns<const int, const int>(path);
+    EXPECT_EQ(columns.size(), 0);
+    EXPECT_EQ(columns.begin(), columns.end());
+}
+
+TEST(Columnar, type_mismatch) {
+    using namespace iterators;
+    auto path = testing::TempDir() + "columnar_mismatch.bin";
+    write_columns(path, zip(std::vector{1, 2}, std::vector{1.0, 2.0}));
+    EXPECT_THROW((read_columns<const int, const float>(path)), std::runtime_error);
+    EXPECT_THROW((read_columns<const int>(path)), std::runtime_error);
+    EXPECT_NO_THROW((read_columns<const float, const std::int64_t>(path)));
+    std::ofstream(path, std::ios::trunc) << "not a columnar file";
+    EXPECT_THROW((read_columns<const int, const double>(path)), std::runtime_error);
+}
+
+TEST(Columnar, truncated) {
+    using namespace iterators;
+    auto path = testing::TempDir() + "columnar_truncated.bin";
+    std::vector<std::int64_t> ids(100, 3);
+    write_columns(path, zip(ids, ids));
+    std::string contents;
+    {
+        std::ifstream in(path, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    auto writeFile = [&path](const std::string &data) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(data.data(),
+                                                                     static_cast<std::streamsize>(data.size()));
+    };
+
+    writeFile(contents.substr(0, contents.size() - 1));
+    EXPECT_THROW((read_columns<const std::int64_t, const std::int64_t>(path)), std::runtime_error);
+    writeFile(contents.substr(0, impl::ColumnAlignment));
+    EXPECT_THROW((read_columns<const std::int64_t, const std::int64_t>(path)), std::runtime_error);
+    auto corrupt = contents;
+    const std::uint64_t offset = 0xFFFFFFFFFFFFFFC0u;
+    corrupt.replace(sizeof(impl::ColumnarFileHeader) + offsetof(impl::ColumnHeader, offset), sizeof(offset),
+                    reinterpret_cast<const char *>(&offset), sizeof(offset));
+    writeFile(corrupt);
+    EXPECT_THROW((read_columns<const std::int64_t, const std::int64_t>(path)), std::runtime_error);
+    writeFile(contents);
+    EXPECT_EQ((read_columns<const std::int64_t, const std::int64_t>(path)).size(), 100);
+}
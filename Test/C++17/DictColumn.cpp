@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "DictColumn.hpp"
+#include "Algorithms.hpp"
+
+namespace {
+    std::vector<std::string> cities(std::size_t size) {
+        const std::vector<std::string> names{"Berlin", "Paris", "Rome", "Madrid", "Vienna", "Lisbon", "Oslo"};
+        std::vector<std::string> result;
+        for (std::size_t i = 0; i < size; ++i) {
+            result.push_back(names[(i * 5 + i / 3) % names.size()]);
+        }
+
+        return result;
+    }
+}
+
+TEST(DictColumn, encode_decode) {
+    using namespace iterators;
+    auto strings = cities(100);
+    auto column = dict_column(strings);
+    ASSERT_EQ(column.size(), strings.size());
+    EXPECT_EQ(column.dictionary().size(), 7);
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        EXPECT_EQ(std::string_view(column[i]), strings[i]);
+        EXPECT_EQ(column[i], strings[i].c_str());
+        EXPECT_EQ(column.dictionary()[column.codes()[i]], strings[i]);
+    }
+
+    std::size_t row = 0;
+    for (std::string_view value : column) {
+        EXPECT_EQ(value, strings[row++]);
+    }
+
+    EXPECT_EQ(row, strings.size());
+    EXPECT_EQ(column.codeOf("Berlin"), std::optional<std::uint32_t>(0));
+    EXPECT_EQ(column.codeOf("Tokyo"), std::nullopt);
+    EXPECT_LT(column[0], column[1]);
+    EXPECT_NE(column[0], column[1]);
+    column[1] = column[0];
+    EXPECT_EQ(column[1], "Berlin");
+    EXPECT_EQ(column[1], column[0]);
+}
+
+TEST(DictColumn, dictionary_growth_and_copy) {
+    using namespace iterators;
+    impl::DictColumn<std::uint16_t> column;
+    for (std::size_t i = 0; i < 2000; ++i) {
+        column.push_back(std::to_string(i % 1000) + std::string(i % 13, 'x'));
+    }
+
+    auto copy = column.dictionary();
+    for (std::size_t i = 0; i < 2000; ++i) {
+        auto expected = std::to_string(i % 1000) + std::string(i % 13, 'x');
+        EXPECT_EQ(column[i], expected);
+        ASSERT_TRUE(copy.find(expected).has_value());
+        EXPECT_EQ(copy[*copy.find(expected)], expected);
+    }
+
+    impl::DictColumn<std::uint16_t> other(column.sharedDictionary());
+    other.push_back("12");
+    other.push_back("unknown");
+    EXPECT_EQ(other.codes()[0], *column.codeOf("12"));
+    EXPECT_EQ(column.codeOf("unknown"), other.codes()[1]);
+}
+
+TEST(DictColumn, code_overflow) {
+    using namespace iterators;
+    impl::DictColumn<std::uint8_t> column;
+    for (std::size_t i = 0; i < 256; ++i) {
+        column.push_back(std::to_string(i));
+    }
+
+    column.push_back("0");
+    EXPECT_THROW(column.push_back("256"), std::length_error);
+    EXPECT_EQ(column.size(), 257);
+    EXPECT_EQ(column.dictionary().size(), 256);
+    EXPECT_EQ(column.codeOf("256"), std::nullopt);
+
+    // a wider column sharing the dictionary is not affected by the failed insertion
+    impl::DictColumn<std::uint16_t> wide(column.sharedDictionary());
+    wide.push_back("256");
+    EXPECT_EQ(wide.codes()[0], 256);
+    EXPECT_EQ(wide[0], "256");
+}
+
+TEST(DictColumn, zip_sort) {
+    using namespace iterators;
+    auto strings = cities(200);
+    std::vector<int> ids(strings.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = static_cast<int>(i);
+    }
+
+    auto column = dict_column(strings);
+    auto table = zip(ids, column);
+    std::sort(table.begin(), table.end(), [](const auto &lhs, const auto &rhs) {
+        return std::tie(std::get<1>(lhs), std::get<0>(lhs)) < std::tie(std::get<1>(rhs), std::get<0>(rhs));
+    });
+
+    std::vector<std::pair<std::string, int>> expected;
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        expected.emplace_back(strings[i], static_cast<int>(i));
+    }
+
+    std::sort(expected.begin(), expected.end());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(column[i], expected[i].first);
+        EXPECT_EQ(ids[i], expected[i].second);
+    }
+}
+
+TEST(DictColumn, filter_and_group_by_codes) {
+    using namespace iterators;
+    auto strings = cities(300);
+    auto column = dict_column<std::uint8_t>(strings);
+    std::vector<double> values(strings.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<double>(i);
+    }
+
+    const auto rome = *column.codeOf("Rome");
+    double romeSum = 0;
+    for (auto [code, value] : zip(column.codes(), values)) {
+        if (code == rome) {
+            romeSum += value;
+        }
+    }
+
+    double expectedSum = 0;
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        if (strings[i] == "Rome") {
+            expectedSum += values[i];
+        }
+    }
+
+    EXPECT_EQ(romeSum, expectedSum);
+    const auto groups = column.dictionary().size();
+    std::vector<std::uint8_t> outCodes(strings.size());
+    std::vector<double> outValues(strings.size());
+    auto offsets = bucketize(zip(column.codes(), values), groups, zip(outCodes, outValues));
+    ASSERT_EQ(offsets.size(), groups + 1);
+    for (std::size_t group = 0; group < groups; ++group) {
+        double sum = 0;
+        for (auto i = offsets[group]; i < offsets[group + 1]; ++i) {
+            EXPECT_EQ(outCodes[i], group);
+            sum += outValues[i];
+        }
+
+        double expected = 0;
+        for (std::size_t i = 0; i < strings.size(); ++i) {
+            if (strings[i] == column.dictionary()[group]) {
+                expected += values[i];
+            }
+        }
+
+        EXPECT_EQ(sum, expected);
+    }
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "Indexed.hpp"
+
+TEST(Indexed, permuted_zip_column) {
+    using namespace iterators;
+    std::vector<std::string> names{"a", "b", "c", "d"};
+    std::vector<int> values{10, 20, 30, 40};
+    std::vector<std::size_t> permutation{2, 0, 3, 1};
+    std::vector<std::pair<std::string, int>> result;
+    for (auto [name, value] : zip(indexed(names, permutation), indexed(values, permutation))) {
+        result.emplace_back(name, value);
+        value += 1;
+    }
+
+    EXPECT_EQ(result, (std::vector<std::pair<std::string, int>>{{"c", 30}, {"a", 10}, {"d", 40}, {"b", 20}}));
+    EXPECT_EQ(values, (std::vector{11, 21, 31, 41}));
+    EXPECT_EQ(indexed(values, permutation).size(), 4);
+}
+
+TEST(Indexed, iterator_categories) {
+    using namespace iterators;
+    std::vector<int> values{1, 2, 3, 4, 5};
+    std::vector<int> indices{4, 3, 2};
+    auto view = indexed(values, indices);
+    using It = decltype(view.begin());
+    static_assert(std::is_same_v<std::iterator_traits<It>::iterator_category, std::random_access_iterator_tag>);
+    EXPECT_EQ(view.end() - view.begin(), 3);
+    EXPECT_EQ(view.begin()[1], 4);
+    EXPECT_EQ(*(view.end() - 1), 3);
+    std::list<int> listIndices{0, 2, 4};
+    auto listView = indexed(values, listIndices);
+    using ListIt = decltype(listView.begin());
+    static_assert(std::is_same_v<std::iterator_traits<ListIt>::iterator_category,
+                  std::bidirectional_iterator_tag>);
+    std::vector<int> reversed(std::make_reverse_iterator(listView.end()),
+                              std::make_reverse_iterator(listView.begin()));
+    EXPECT_EQ(reversed, (std::vector{5, 3, 1}));
+    const auto &constView = view;
+    static_assert(std::is_same_v<decltype(*constView.begin()), const int &>);
+}
+
+TEST(Indexed, temporaries) {
+    using namespace iterators;
+    std::vector<int> result;
+    for (auto value : indexed(std::vector{5, 6, 7}, std::vector{2, 2, 0})) {
+        result.emplace_back(value);
+    }
+
+    EXPECT_EQ(result, (std::vector{7, 7, 5}));
+}
+
+template<typename T, typename Index>
+void check_gather(std::size_t tableSize, std::size_t count) {
+    using namespace iterators;
+    std::vector<T> table(tableSize);
+    std::iota(table.begin(), table.end(), T(1));
+    std::vector<Index> indices(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        indices[i] = static_cast<Index>((i * 7919) % tableSize);
+    }
+
+    std::vector<T> out(count);
+    auto end = gather(indexed(table, indices), out.begin());
+    EXPECT_EQ(end, out.end());
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(out[i], table[indices[i]]);
+    }
+}
+
+TEST(Indexed, gather_kernels) {
+    for (std::size_t count : {0, 1, 3, 4, 8, 17, 100}) {
+        check_gather<int, std::uint32_t>(50, count);
+        check_gather<float, std::int32_t>(50, count);
+        check_gather<double, std::uint32_t>(50, count);
+        check_gather<std::int64_t, std::size_t>(50, count);
+        check_gather<float, std::int64_t>(50, count);
+        check_gather<char, std::uint16_t>(50, count);
+    }
+}
+
+TEST(Indexed, gather_generic) {
+    using namespace iterators;
+    std::vector<std::string> table{"x", "y", "z"};
+    std::list<int> indices{2, 1, 2};
+    std::vector<std::string> out;
+    gather(indexed(table, indices), std::back_inserter(out));
+    EXPECT_EQ(out, (std::vector<std::string>{"z", "y", "z"}));
+    std::vector<int> numbers{1, 2, 3};
+    std::list<int> numberOut(2);
+    auto end = gather(indexed(numbers, std::vector{2, 0}), numberOut.begin());
+    EXPECT_EQ(end, numberOut.end());
+    EXPECT_EQ(numberOut, (std::list{3, 1}));
+}
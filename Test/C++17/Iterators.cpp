@@ -5,6 +5,8 @@
 #include <type_traits>
 #include <deque>
 #include <unordered_map>
+#include <algorithm>
+#include <memory>
 #include "Iterators.hpp"
 #include "utils.hpp"
 
@@ -651,6 +653,33 @@ TEST(Iterators, stl_algos_sort) {
     EXPECT_EQ(priorities, (std::array{0, 1, 2, 7}));
 }
 
+TEST(Iterators, ref_tuple_swap) {
+    using namespace iterators;
+    std::vector<int> numbers{1, 2};
+    std::vector<std::unique_ptr<int>> pointers;
+    pointers.emplace_back(std::make_unique<int>(3));
+    pointers.emplace_back(std::make_unique<int>(4));
+    auto zView = zip(numbers, pointers);
+    using std::swap;
+    swap(*zView.begin(), *(zView.begin() + 1));
+    EXPECT_EQ(numbers, (std::vector{2, 1}));
+    EXPECT_EQ(*pointers[0], 4);
+    EXPECT_EQ(*pointers[1], 3);
+    std::vector<int> keys(100);
+    std::vector<std::string> strings(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<int>((i * 37) % keys.size());
+        strings[i] = std::to_string(keys[i]);
+    }
+
+    auto table = zip(keys, strings);
+    std::sort(table.begin(), table.end(), [](const auto &a, const auto &b) { return std::get<0>(a) < std::get<0>(b); });
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(keys[i], static_cast<int>(i));
+        EXPECT_EQ(strings[i], std::to_string(i));
+    }
+}
+
 TEST(Iterators, noexcept_stl_containers) {
     using namespace iterators;
     std::array numbers {1, 2, 3};
@@ -803,4 +832,31 @@ TEST(Iterators, non_const_bounds) {
 
     EXPECT_FALSE(has_const_begin_v<decltype(zip(numbers))>);
     EXPECT_FALSE(has_const_end_v<decltype(zip(numbers))>);
+}
+
+TEST(Iterators, distance) {
+    using namespace iterators;
+    std::vector<int> numbers{1, 2, 3, 4};
+    std::list<int> list{1, 2, 3};
+    auto enumView = enumerate(numbers);
+    EXPECT_EQ(impl::distance(enumView.begin(), enumView.end()), 4);
+    auto zipView = zip_enumerate(numbers, std::array{1, 2}, 3);
+    EXPECT_EQ(impl::distance(zipView.begin(), zipView.end()), 2);
+    auto listView = zip(numbers, list);
+    EXPECT_EQ(impl::distance(listView.begin(), listView.end()), 3);
+    EXPECT_EQ(impl::distance(numbers.begin(), numbers.end()), 4);
+    EXPECT_EQ(impl::distance(list.begin(), list.end()), 3);
+}
+
+TEST(Iterators, contiguous_traits) {
+    using namespace iterators::impl::traits;
+    EXPECT_TRUE(is_contiguous_v<int *>);
+    EXPECT_TRUE(is_contiguous_v<const double *>);
+    EXPECT_TRUE(is_contiguous_v<std::vector<int>::iterator>);
+    EXPECT_TRUE(is_contiguous_v<std::vector<std::string>::const_iterator>);
+    EXPECT_TRUE((is_contiguous_v<std::array<int, 3>::iterator>));
+    EXPECT_FALSE(is_contiguous_v<std::vector<bool>::iterator>);
+    EXPECT_FALSE(is_contiguous_v<std::list<int>::iterator>);
+    EXPECT_FALSE(is_contiguous_v<iterators::impl::CounterIterator<>>);
+    EXPECT_FALSE(is_contiguous_v<int>);
 }
\ No newline at end of file
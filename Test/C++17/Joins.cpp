@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <list>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "Joins.hpp"
+
+namespace {
+    using Pairs = std::vector<std::pair<std::size_t, std::size_t>>;
+
+    template<typename L, typename R>
+    Pairs nested_loop_join(const std::vector<L> &left, const std::vector<R> &right) {
+        Pairs result;
+        for (std::size_t i = 0; i < left.size(); ++i) {
+            for (std::size_t j = 0; j < right.size(); ++j) {
+                if (left[i] == right[j]) {
+                    result.emplace_back(i, j);
+                }
+            }
+        }
+
+        return result;
+    }
+}
+
+TEST(Joins, merge_join_duplicates) {
+    using namespace iterators;
+    std::vector<int> leftKeys{1, 2, 2, 2, 4, 5, 7, 7, 9};
+    std::vector<long> rightKeys{0, 2, 2, 3, 5, 7, 7, 7, 8, 9, 10};
+    std::vector<std::size_t> leftIds(leftKeys.size());
+    std::vector<std::size_t> rightIds(rightKeys.size());
+    std::iota(leftIds.begin(), leftIds.end(), 0);
+    std::iota(rightIds.begin(), rightIds.end(), 0);
+    Pairs pairs;
+    for (auto [left, right] : merge_join(zip(leftKeys, leftIds), zip(rightKeys, rightIds), element<0>{},
+                                         element<0>{})) {
+        EXPECT_EQ(std::get<0>(left), std::get<0>(right));
+        pairs.emplace_back(std::get<1>(left), std::get<1>(right));
+    }
+
+    EXPECT_EQ(pairs, nested_loop_join(leftKeys, rightKeys));
+    std::list<int> leftList(leftKeys.begin(), leftKeys.end());
+    std::size_t count = 0;
+    for (auto [l, r] : merge_join(leftList, rightKeys)) {
+        EXPECT_EQ(l, r);
+        ++count;
+    }
+
+    EXPECT_EQ(count, pairs.size());
+}
+
+TEST(Joins, merge_join_skewed) {
+    using namespace iterators;
+    std::vector<int> large(100000);
+    for (std::size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<int>(i / 3);
+    }
+
+    std::vector<int> small{-5, 17, 17, 5000, 33332, 33333, 40000};
+    auto expected = nested_loop_join(small, large);
+    Pairs pairs;
+    auto join = merge_join(enumerate(small), enumerate(large), element<1>{}, element<1>{});
+    for (auto [left, right] : join) {
+        pairs.emplace_back(std::get<0>(left), std::get<0>(right));
+    }
+
+    EXPECT_EQ(pairs, expected);
+    pairs.clear();
+    for (auto [left, right] : merge_join(enumerate(large), enumerate(small), element<1>{}, element<1>{})) {
+        pairs.emplace_back(std::get<0>(right), std::get<0>(left));
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+    EXPECT_EQ(pairs, expected);
+}
+
+TEST(Joins, merge_join_descending_and_empty) {
+    using namespace iterators;
+    std::vector<std::string> names{"d", "c", "b", "a"};
+    std::vector<int> values{4, 3, 2, 1};
+    std::vector<std::string> other{"e", "c", "a"};
+    std::vector<int> joined;
+    for (auto [left, right] : merge_join(zip(names, values), other, element<0>{}, impl::Identity{},
+                                                         std::greater<>{})) {
+        auto [name, value] = left;
+        EXPECT_EQ(name, right);
+        value *= 10;
+    }
+
+    EXPECT_EQ(values, (std::vector{4, 30, 2, 10}));
+    std::vector<int> empty;
+    auto join = merge_join(empty, values);
+    EXPECT_EQ(join.begin(), join.end());
+    auto join2 = merge_join(values, empty);
+    EXPECT_EQ(join2.begin(), join2.end());
+}
+
+TEST(Joins, hash_join) {
+    using namespace iterators;
+    std::vector<int> buildKeys;
+    std::vector<std::string> buildNames;
+    for (int i = 0; i < 3000; ++i) {
+        buildKeys.emplace_back((i * 7) % 2000);
+        buildNames.emplace_back(std::to_string(i));
+    }
+
+    std::vector<int> probeKeys;
+    for (int i = 0; i < 5000; ++i) {
+        probeKeys.emplace_back((i * 13) % 4000 - 100);
+    }
+
+    auto expected = nested_loop_join(buildKeys, probeKeys);
+    auto result = hash_join(zip(buildKeys, buildNames), enumerate(probeKeys), element<0>{}, element<1>{});
+    Pairs pairs;
+    for (auto [buildRow, probeRow] : result) {
+        EXPECT_EQ(buildKeys[buildRow], probeKeys[probeRow]);
+        pairs.emplace_back(buildRow, probeRow);
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+    EXPECT_EQ(pairs, expected);
+    EXPECT_EQ(result.size(), expected.size());
+}
+
+TEST(Joins, hash_join_strings_and_empty) {
+    using namespace iterators;
+    std::vector<std::string> left{"a", "b", "c", "b"};
+    std::vector<std::string> right{"b", "x", "a"};
+    auto result = hash_join(left, right);
+    Pairs pairs;
+    for (auto [buildRow, probeRow] : result) {
+        pairs.emplace_back(buildRow, probeRow);
+    }
+
+    EXPECT_EQ(pairs, (Pairs{{1, 0}, {3, 0}, {0, 2}}));
+    std::vector<std::string> empty;
+    EXPECT_EQ(hash_join(empty, right).size(), 0);
+    EXPECT_EQ(hash_join(left, empty).size(), 0);
+}
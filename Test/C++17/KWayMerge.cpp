@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "KWayMerge.hpp"
+
+TEST(KWayMerge, against_stable_sort) {
+    using namespace iterators;
+    std::mt19937 gen(42);
+    for (std::size_t k : {0, 1, 2, 3, 5, 8, 13, 64}) {
+        std::vector<std::vector<int>> runs(k);
+        std::vector<std::pair<int, std::size_t>> expected;
+        for (std::size_t source = 0; source < k; ++source) {
+            runs[source].resize(gen() % 50);
+            for (auto &value : runs[source]) {
+                value = static_cast<int>(gen() % 40);
+            }
+
+            std::sort(runs[source].begin(), runs[source].end());
+            for (auto value : runs[source]) {
+                expected.emplace_back(value, source);
+            }
+        }
+
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+        std::vector<std::pair<int, std::size_t>> actual;
+        for (auto [source, value] : kway_merge(runs)) {
+            actual.emplace_back(value, source);
+        }
+
+        EXPECT_EQ(actual, expected);
+    }
+}
+
+TEST(KWayMerge, empty_sources_and_lists) {
+    using namespace iterators;
+    std::vector<std::list<std::string>> runs{{}, {"b", "d"}, {}, {"a", "c", "e"}, {}};
+    std::vector<std::string> merged;
+    std::vector<std::size_t> sources;
+    for (auto [source, value] : kway_merge(runs)) {
+        merged.emplace_back(value);
+        sources.emplace_back(source);
+        value += "!";
+    }
+
+    EXPECT_EQ(merged, (std::vector<std::string>{"a", "b", "c", "d", "e"}));
+    EXPECT_EQ(sources, (std::vector<std::size_t>{3, 1, 3, 1, 3}));
+    EXPECT_EQ(runs[1].front(), "b!");
+    std::vector<std::vector<int>> allEmpty(4);
+    auto view = kway_merge(allEmpty);
+    EXPECT_EQ(view.begin(), view.end());
+    auto descending = kway_merge(std::vector<std::vector<int>>{{9, 4, 1}, {8, 4, 3}}, std::greater<>{});
+    std::vector<int> values;
+    for (auto [source, value] : descending) {
+        values.emplace_back(value);
+    }
+
+    EXPECT_EQ(values, (std::vector<int>{9, 8, 4, 4, 3, 1}));
+    EXPECT_EQ(std::distance(descending.begin(), descending.end()), 6);
+}
+
+TEST(KWayMerge, zipped_runs) {
+    using namespace iterators;
+    std::vector<int> keys1{1, 4, 7};
+    std::vector<std::string> names1{"a", "d", "g"};
+    std::vector<int> keys2{2, 4, 5};
+    std::vector<std::string> names2{"b", "e", "f"};
+    std::vector<decltype(zip(keys1, names1))> runs{zip(keys1, names1), zip(keys2, names2)};
+    std::vector<std::string> names;
+    for (auto [source, row] : kway_merge(runs, [](const auto &lhs, const auto &rhs) {
+        return std::get<0>(lhs) < std::get<0>(rhs);
+    })) {
+        names.emplace_back(std::get<1>(row) + std::to_string(source));
+    }
+
+    EXPECT_EQ(names, (std::vector<std::string>{"a0", "b1", "d0", "e1", "f1", "g0"}));
+}
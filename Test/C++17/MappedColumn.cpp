@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <string>
+#include "MappedColumn.hpp"
+
+template<typename T>
+static std::string writeFile(const std::string &name, const std::vector<T> &values) {
+    auto path = testing::TempDir() + name;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    return path;
+}
+
+TEST(MappedColumn, read) {
+    using namespace iterators;
+    std::vector<int> values{4, 8, 15, 16, 23, 42};
+    auto column = mapped_column<const int>(writeFile("mapped_read.bin", values));
+    ASSERT_EQ(column.size(), values.size());
+    EXPECT_TRUE(std::equal(column.begin(), column.end(), values.begin()));
+    EXPECT_EQ(column[3], 16);
+    EXPECT_TRUE((std::is_same_v<decltype(column.begin()), const int *>));
+}
+
+TEST(MappedColumn, zip_enumerate) {
+    using namespace iterators;
+    std::vector<double> values{0.5, 1.5, 2.5};
+    std::vector<std::string> names{"a", "b", "c"};
+    std::size_t count = 0;
+    for (auto [index, value, name] : zip_enumerate(mapped_column<const double>(
+            writeFile("mapped_zip.bin", values), Advice::Sequential | Advice::WillNeed), names)) {
+        EXPECT_EQ(value, values[index]);
+        EXPECT_EQ(name, names[index]);
+        ++count;
+    }
+
+    EXPECT_EQ(count, 3);
+    auto column = mapped_column<const double>(writeFile("mapped_zip.bin", values));
+    auto zipView = zip(column, names);
+    EXPECT_EQ(zipView.size(), 3);
+    EXPECT_EQ(std::get<0>(zipView[1]), 1.5);
+}
+
+TEST(MappedColumn, write_through) {
+    using namespace iterators;
+    auto path = writeFile("mapped_write.bin", std::vector<int>{1, 2, 3});
+    {
+        auto column = mapped_column<int>(path);
+        for (auto [index, value] : enumerate(column)) {
+            value *= static_cast<int>(index) + 10;
+        }
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    std::vector<int> result(3);
+    in.read(reinterpret_cast<char *>(result.data()), 3 * sizeof(int));
+    EXPECT_EQ(result, (std::vector{10, 22, 36}));
+}
+
+TEST(MappedColumn, const_zip) {
+    using namespace iterators;
+    auto column = mapped_column<int>(writeFile("mapped_const.bin", std::vector<int>{1, 2}));
+    EXPECT_TRUE(std::is_const_v<std::remove_reference_t<decltype(std::get<0>(*const_zip(column).begin()))>>);
+    EXPECT_FALSE(std::is_const_v<std::remove_reference_t<decltype(std::get<0>(*zip(column).begin()))>>);
+}
+
+TEST(MappedColumn, empty_file) {
+    using namespace iterators;
+    auto column = mapped_column<const int>(writeFile("mapped_empty.bin", std::vector<int>{}));
+    EXPECT_EQ(column.size(), 0);
+    EXPECT_EQ(column.begin(), column.end());
+    EXPECT_TRUE(column.advise(Advice::Sequential));
+}
+
+TEST(MappedColumn, errors) {
+    using namespace iterators;
+    EXPECT_THROW(mapped_column<const int>(testing::TempDir() + "does_not_exist.bin"), std::system_error);
+    auto path = writeFile("mapped_odd.bin", std::vector<char>{1, 2, 3, 4, 5});
+    EXPECT_THROW(mapped_column<const int>(path), std::runtime_error);
+    EXPECT_EQ(mapped_column<const char>(path).size(), 5);
+    auto mapping = std::make_shared<const impl::FileMapping>(path, false);
+    EXPECT_THROW(impl::MappedColumn<const int>(mapping, 1, 1), std::invalid_argument);
+    EXPECT_THROW(impl::MappedColumn<const int>(mapping, 2, 0), std::invalid_argument);
+    EXPECT_THROW(impl::MappedColumn<const int>(mapping, 4, 2), std::out_of_range);
+    EXPECT_EQ(impl::MappedColumn<const int>(mapping, 0, 1).size(), 1);
+    EXPECT_EQ(impl::MappedColumn<const char>(mapping, 1, 4).size(), 4);
+}
+
+TEST(MappedColumn, advise) {
+    using namespace iterators;
+    auto column = mapped_column<const long>(writeFile("mapped_advise.bin", std::vector<long>(1024, 7)));
+    EXPECT_TRUE(column.advise(Advice::Sequential | Advice::WillNeed));
+    EXPECT_TRUE(column.advise(Advice::Random));
+    EXPECT_TRUE(column.advise(Advice::Normal));
+}
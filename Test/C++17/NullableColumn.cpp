@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "NullableColumn.hpp"
+
+TEST(NullableColumn, push_back_and_access) {
+    using namespace iterators;
+    auto column = nullable_column<int>();
+    column.push_back(1);
+    column.push_back(std::nullopt);
+    column.push_back(std::optional<int>(3));
+    column.push_back(std::optional<int>());
+    ASSERT_EQ(column.size(), 4);
+    EXPECT_EQ(column.nullCount(), 2);
+    EXPECT_TRUE(column[0].has_value());
+    EXPECT_EQ(*column[0], 1);
+    EXPECT_FALSE(column[1]);
+    EXPECT_EQ(column[1], std::nullopt);
+    EXPECT_EQ(column[1].value_or(-1), -1);
+    EXPECT_THROW(column[1].value(), std::bad_optional_access);
+    EXPECT_EQ(column[2].value(), 3);
+    EXPECT_EQ(column.values(), (std::vector<int>{1, 0, 3, 0}));
+    column[1] = 5;
+    column[2] = std::nullopt;
+    EXPECT_EQ(static_cast<std::optional<int>>(column[1]), std::optional<int>(5));
+    EXPECT_EQ(static_cast<std::optional<int>>(column[2]), std::nullopt);
+    column[3] = column[0];
+    EXPECT_EQ(*column[3], 1);
+    const auto &constColumn = column;
+    EXPECT_EQ(constColumn[3].value(), 1);
+    column.resize(70);
+    EXPECT_EQ(column.nullCount(), 67);
+    column.push_back(8);
+    EXPECT_EQ(*column[70], 8);
+    EXPECT_EQ(count_set(column.validityBits()), 4);
+}
+
+TEST(NullableColumn, zip) {
+    using namespace iterators;
+    std::vector<std::string> names{"a", "b", "c", "d"};
+    impl::NullableColumn<double> prices(std::vector<double>{1.5, 2.5, 3.5, 4.5});
+    prices[2] = std::nullopt;
+    double total = 0;
+    std::string nullNames;
+    for (auto [name, price] : zip(names, prices)) {
+        if (price) {
+            total += *price;
+        } else {
+            nullNames += name;
+        }
+    }
+
+    EXPECT_DOUBLE_EQ(total, 8.5);
+    EXPECT_EQ(nullNames, "c");
+    for (auto [i, price] : enumerate(prices)) {
+        if (i % 2 == 0) {
+            price = std::nullopt;
+        }
+    }
+
+    EXPECT_EQ(prices.nullCount(), 2);
+    std::vector<std::optional<double>> copy(prices.begin(), prices.end());
+    EXPECT_EQ(copy, (std::vector<std::optional<double>>{std::nullopt, 2.5, std::nullopt, 4.5}));
+}
+
+TEST(NullableColumn, skip_nulls) {
+    using namespace iterators;
+    for (std::size_t size : {0, 1, 63, 64, 65, 200, 1000}) {
+        auto column = nullable_column<long>(size);
+        std::vector<std::size_t> expectedRows;
+        for (std::size_t row = 0; row < size; ++row) {
+            if (row % 7 == 3 || row == size - 1) {
+                column[row] = static_cast<long>(row) * 10;
+                expectedRows.emplace_back(row);
+            }
+        }
+
+        std::vector<std::size_t> rows;
+        for (auto [row, value] : skip_nulls(column)) {
+            EXPECT_EQ(value, static_cast<long>(row) * 10);
+            rows.emplace_back(row);
+            value += 1;
+        }
+
+        EXPECT_EQ(rows, expectedRows);
+        const auto &constColumn = column;
+        long sum = 0;
+        for (auto [row, value] : skip_nulls(constColumn)) {
+            sum += value - static_cast<long>(row) * 10;
+        }
+
+        EXPECT_EQ(sum, static_cast<long>(expectedRows.size()));
+    }
+}
+
+TEST(NullableColumn, zip_sort) {
+    using namespace iterators;
+    auto column = nullable_column<int>();
+    std::vector<int> ids;
+    for (int i = 0; i < 50; ++i) {
+        if (i % 3 == 0) {
+            column.push_back(std::nullopt);
+        } else {
+            column.push_back((i * 7) % 50);
+        }
+
+        ids.push_back(i);
+    }
+
+    auto table = zip(column, ids);
+    std::sort(table.begin(), table.end(), [](const auto &lhs, const auto &rhs) {
+        return std::get<1>(lhs) > std::get<1>(rhs);
+    });
+
+    for (int i = 0; i < 50; ++i) {
+        const int id = 49 - i;
+        EXPECT_EQ(ids[i], id);
+        if (id % 3 == 0) {
+            EXPECT_FALSE(column[i].has_value());
+        } else {
+            EXPECT_EQ(column[i].value(), (id * 7) % 50);
+        }
+    }
+}
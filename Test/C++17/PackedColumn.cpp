@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+#include "PackedColumn.hpp"
+#include "Algorithms.hpp"
+
+namespace {
+    template<typename T>
+    void expectRoundtrip(const std::vector<T> &values) {
+        auto column = iterators::packed_column(values);
+        ASSERT_EQ(column.size(), values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            ASSERT_EQ(column[i], values[i]) << "index " << i;
+        }
+
+        EXPECT_TRUE(std::equal(column.begin(), column.end(), values.begin(), values.end()));
+    }
+
+    template<typename T>
+    std::vector<T> randomValues(std::size_t size, unsigned width, std::mt19937_64 &rng) {
+        using U = std::make_unsigned_t<T>;
+        std::vector<T> values(size);
+        const auto offset = static_cast<U>(rng());
+        for (auto &value : values) {
+            auto delta = width == 0 ? 0 : rng() >> (64 - width);
+            value = static_cast<T>(static_cast<U>(offset + static_cast<U>(delta)));
+        }
+
+        return values;
+    }
+}
+
+TEST(PackedColumn, roundtrip_widths) {
+    std::mt19937_64 rng(42);
+    for (unsigned width = 0; width <= 64; ++width) {
+        expectRoundtrip(randomValues<std::uint64_t>(300, width, rng));
+        expectRoundtrip(randomValues<std::int64_t>(300, width, rng));
+        if (width <= 32) {
+            expectRoundtrip(randomValues<std::uint32_t>(300, width, rng));
+            expectRoundtrip(randomValues<std::int32_t>(300, width, rng));
+        }
+
+        if (width <= 16) {
+            expectRoundtrip(randomValues<std::int16_t>(300, width, rng));
+        }
+
+        if (width <= 8) {
+            expectRoundtrip(randomValues<std::uint8_t>(300, width, rng));
+        }
+    }
+}
+
+TEST(PackedColumn, edge_cases) {
+    expectRoundtrip(std::vector<int>{});
+    expectRoundtrip(std::vector<int>{7});
+    expectRoundtrip(std::vector<int>(128, -3));
+    expectRoundtrip(std::vector<std::int64_t>{std::numeric_limits<std::int64_t>::min(), 0,
+                                              std::numeric_limits<std::int64_t>::max()});
+    expectRoundtrip(std::vector<std::int32_t>{std::numeric_limits<std::int32_t>::max(),
+                                              std::numeric_limits<std::int32_t>::min(), -1, 1});
+    std::vector<int> values(1000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i % 129) - 64;
+    }
+
+    expectRoundtrip(values);
+}
+
+TEST(PackedColumn, block_width_and_memory) {
+    using namespace iterators;
+    std::vector<std::uint64_t> timestamps(10000);
+    for (std::size_t i = 0; i < timestamps.size(); ++i) {
+        timestamps[i] = 1700000000000ull + i * 10 + i % 7;
+    }
+
+    auto column = packed_column(timestamps);
+    EXPECT_EQ(column.blockCount(), (timestamps.size() + 127) / 128);
+    for (std::size_t block = 0; block < column.blockCount(); ++block) {
+        EXPECT_LE(column.bitWidth(block), 11);
+    }
+
+    EXPECT_LT(column.memoryUsage() * 5, timestamps.size() * sizeof(std::uint64_t));
+    auto narrow = packed_column<std::uint16_t>(std::vector<int>{1, 2, 3});
+    EXPECT_TRUE((std::is_same_v<decltype(narrow)::value_type, std::uint16_t>));
+    EXPECT_EQ(narrow[2], 3);
+}
+
+TEST(PackedColumn, zip_and_random_access) {
+    using namespace iterators;
+    std::vector<int> ids(1000);
+    std::vector<double> prices(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = static_cast<int>(i * 3);
+        prices[i] = static_cast<double>(i) / 2;
+    }
+
+    const auto column = packed_column(ids);
+    std::size_t row = 0;
+    for (auto [id, price] : zip(column, prices)) {
+        EXPECT_EQ(id, ids[row]);
+        EXPECT_EQ(price, prices[row]);
+        ++row;
+    }
+
+    EXPECT_EQ(row, ids.size());
+    auto found = std::lower_bound(column.begin(), column.end(), 1500);
+    EXPECT_EQ(found - column.begin(), 500);
+    EXPECT_EQ(*found, 1500);
+    auto it = column.end();
+    it -= 1;
+    EXPECT_EQ(*it, ids.back());
+    EXPECT_EQ(it[-999], 0);
+    auto copy = it;
+    --copy;
+    EXPECT_EQ(*copy, ids[998]);
+    EXPECT_EQ(*it, ids[999]);
+}
+
+TEST(PackedColumn, reduce_and_subscripts) {
+    using namespace iterators;
+    std::vector<std::int64_t> values(1000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<std::int64_t>((i * 7919) % 1000) - 500;
+    }
+
+    const auto column = packed_column(values);
+    std::int64_t expected = 0;
+    for (auto value : values) {
+        expected += value;
+    }
+
+    EXPECT_EQ(reduce(column, std::int64_t(0)), expected);
+    EXPECT_EQ(transform_reduce<3>(zip(column, values), std::int64_t(0), std::plus<>{}, [](auto row) {
+        return std::get<0>(row) - std::get<1>(row);
+    }), 0);
+    auto it = column.begin();
+    for (std::size_t i = 0; i < values.size(); i += 37) {
+        EXPECT_EQ(it[static_cast<std::ptrdiff_t>(i)], values[i]);
+    }
+
+    EXPECT_EQ(*it, values[0]);
+    it += 300;
+    EXPECT_EQ(*it, values[300]);
+    EXPECT_EQ(*++it, values[301]);
+    EXPECT_EQ(*--it, values[300]);
+    it -= 200;
+    EXPECT_EQ(*it, values[100]);
+    static_assert(sizeof(it) <= 64, "iterators must not carry the block buffer inline");
+}
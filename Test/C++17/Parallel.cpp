@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Parallel.hpp"
+
+TEST(Parallel, reduce) {
+    using namespace iterators;
+    for (std::size_t size : {0, 1, 100, 100000}) {
+        std::vector<std::int64_t> values(size);
+        std::iota(values.begin(), values.end(), 1);
+        auto expected = std::accumulate(values.begin(), values.end(), std::int64_t(7));
+        EXPECT_EQ(parallel_reduce(values, std::int64_t(7)), expected);
+        EXPECT_EQ(parallel_reduce<2>(values, std::int64_t(7), std::plus<>{}, Combine::Deterministic), expected);
+        std::vector<std::size_t> reversed(size);
+        std::iota(reversed.rbegin(), reversed.rend(), std::size_t(0));
+        EXPECT_EQ(parallel_reduce(indexed(values, reversed), std::int64_t(7)), expected);
+    }
+}
+
+TEST(Parallel, transform_reduce_zip) {
+    using namespace iterators;
+    std::vector<double> prices(200000);
+    std::vector<int> quantities(200000);
+    for (std::size_t i = 0; i < prices.size(); ++i) {
+        prices[i] = 0.5 * static_cast<double>(i % 10);
+        quantities[i] = static_cast<int>(i % 3);
+    }
+
+    auto expected = std::inner_product(prices.begin(), prices.end(), quantities.begin(), 0.0);
+    auto revenue = parallel_transform_reduce(zip(prices, quantities), 0.0, std::plus<>{}, product{});
+    EXPECT_DOUBLE_EQ(revenue, expected);
+    std::vector<double> weights(prices.size(), 2.0);
+    EXPECT_DOUBLE_EQ(parallel_transform_reduce(zip(prices, weights), 0.0, std::plus<>{}, product{}),
+                     2 * std::accumulate(prices.begin(), prices.end(), 0.0));
+}
+
+TEST(Parallel, enumerated_and_counter_ranges) {
+    using namespace iterators;
+    std::vector<std::int64_t> values(100000, 2);
+    auto weighted = parallel_transform_reduce(enumerate(values), std::int64_t(0), std::plus<>{}, [](auto row) {
+        auto [index, value] = row;
+        return static_cast<std::int64_t>(index) * value;
+    });
+
+    EXPECT_EQ(weighted, 100000ll * 99999);
+    EXPECT_EQ(parallel_reduce(counter_range(0ll, 1000000ll), 0ll), 1000000ll * 999999 / 2);
+    EXPECT_EQ(parallel_reduce(counter_range(10, 0, -3), 0), 10 + 7 + 4 + 1);
+    EXPECT_EQ(counter_range(0u, 10u, 3u).size(), 4);
+    EXPECT_EQ(counter_range(5, 5).size(), 0);
+    EXPECT_EQ(counter_range(5, 1).size(), 0);
+}
+
+TEST(Parallel, deterministic_combine) {
+    using namespace iterators;
+    std::vector<float> values(3 * impl::DeterministicChunkSize + 123);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = 1.f / static_cast<float>(i + 1);
+    }
+
+    float expected = 0.f;
+    for (std::size_t begin = 0; begin < values.size(); begin += impl::DeterministicChunkSize) {
+        auto end = std::min(values.size(), begin + impl::DeterministicChunkSize);
+        std::vector<float> chunk(values.begin() + static_cast<long>(begin) + 1, values.begin() + static_cast<long>(end));
+        expected += reduce(chunk, values[begin]);
+    }
+
+    auto result = parallel_reduce(values, 0.f, std::plus<>{}, Combine::Deterministic);
+    EXPECT_EQ(result, expected);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(parallel_reduce(values, 0.f, std::plus<>{}, Combine::Deterministic), result);
+    }
+}
+
+TEST(Parallel, zip_sort) {
+    using namespace iterators;
+    for (std::size_t size : {0, 1, 1000, 100000}) {
+        std::vector<int> keys(size);
+        std::vector<std::string> names(size);
+        std::vector<bool> flags(size);
+        std::vector<std::tuple<int, std::string, bool>> expected;
+        for (std::size_t i = 0; i < size; ++i) {
+            keys[i] = static_cast<int>((i * 7919) % 1013);
+            names[i] = std::to_string(i);
+            flags[i] = i % 3 == 0;
+            expected.emplace_back(keys[i], names[i], flags[i]);
+        }
+
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const auto &lhs, const auto &rhs) { return std::get<0>(lhs) > std::get<0>(rhs); });
+        parallel_zip_sort(zip(keys, names, flags), std::greater<>{});
+        ASSERT_EQ(keys.size(), expected.size());
+        for (std::size_t i = 0; i < size; ++i) {
+            EXPECT_EQ(keys[i], std::get<0>(expected[i]));
+            EXPECT_EQ(names[i], std::get<1>(expected[i]));
+            EXPECT_EQ(flags[i], std::get<2>(expected[i]));
+        }
+    }
+}
+
+TEST(Parallel, zip_sort_key_index) {
+    using namespace iterators;
+    std::vector<int> ids{0, 1, 2, 3, 4};
+    std::vector<double> scores{3.5, -1.0, 2.0, -1.0, 0.5};
+    parallel_zip_sort<1>(zip(ids, scores));
+    EXPECT_EQ(ids, (std::vector{1, 3, 4, 2, 0}));
+    EXPECT_EQ(scores, (std::vector{-1.0, -1.0, 0.5, 2.0, 3.5}));
+}
+
+TEST(Parallel, find_if) {
+    using namespace iterators;
+    std::vector<int> values(100000);
+    std::vector<int> other(100000, 1);
+    std::iota(values.begin(), values.end(), 0);
+    for (int target : {0, 5000, 70000, 99999, 100000}) {
+        auto pred = [target](auto row) { auto [value, flag] = row; return value >= target && flag == 1; };
+        auto zipped = zip(values, other);
+        auto res = parallel_find_if(zipped, pred);
+        EXPECT_EQ(res - zipped.begin(), std::find_if(zipped.begin(), zipped.end(), pred) - zipped.begin());
+        EXPECT_EQ(parallel_any_of(zipped, pred), target < 100000);
+    }
+
+    other[20] = 0;
+    other[80000] = 0;
+    auto res = parallel_find_if(zip(values, other), [](auto row) { return std::get<1>(row) == 0; });
+    EXPECT_EQ(std::get<0>(*res), 20);
+    std::vector<int> empty;
+    EXPECT_EQ(parallel_find_if(empty, [](int) { return true; }), empty.begin());
+    EXPECT_FALSE(parallel_any_of(empty, [](int) { return true; }));
+    auto found = parallel_find_if(enumerate(values), [](auto row) { return std::get<1>(row) == 4242; });
+    EXPECT_EQ(std::get<0>(*found), 4242);
+}
+
+TEST(Parallel, scans) {
+    using namespace iterators;
+    for (std::size_t size : {0, 1, 1000, 100001}) {
+        std::vector<std::int64_t> values(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            values[i] = static_cast<std::int64_t>(i % 7) - 2;
+        }
+
+        std::vector<std::int64_t> expected(size);
+        std::vector<std::int64_t> result(size);
+        std::inclusive_scan(values.begin(), values.end(), expected.begin());
+        EXPECT_EQ(parallel_inclusive_scan(values, result.begin()), result.end());
+        EXPECT_EQ(result, expected);
+        std::exclusive_scan(values.begin(), values.end(), expected.begin(), std::int64_t(5));
+        parallel_exclusive_scan(values, result.begin(), std::int64_t(5), std::plus<>{}, Combine::Deterministic);
+        EXPECT_EQ(result, expected);
+        parallel_exclusive_scan(values, values.begin(), std::int64_t(5));
+        EXPECT_EQ(values, expected);
+    }
+}
+
+TEST(Parallel, scan_zipped) {
+    using namespace iterators;
+    std::vector<int> counts(70000, 2);
+    std::vector<int> weights(70000, 3);
+    std::vector<long> offsets(counts.size());
+    parallel_transform_exclusive_scan(zip(counts, weights), offsets.begin(), 0l, std::plus<long>{}, product{});
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+        ASSERT_EQ(offsets[i], 6 * static_cast<long>(i));
+    }
+}
+
+TEST(Parallel, compact) {
+    using namespace iterators;
+    for (std::size_t size : {0, 1, 100, 100003}) {
+        std::vector<std::int64_t> keys(size);
+        std::vector<float> values(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            keys[i] = static_cast<std::int64_t>(i);
+            values[i] = static_cast<float>((i * 7919) % 100);
+        }
+
+        auto pred = [](auto row) { return std::get<1>(row) < 50.f; };
+        std::vector<std::int64_t> outKeys(size);
+        std::vector<float> outValues(size);
+        std::vector<std::int64_t> expectedKeys(size);
+        std::vector<float> expectedValues(size);
+        auto expected = compact(zip(keys, values), pred, zip(expectedKeys, expectedValues)) -
+                        zip(expectedKeys, expectedValues).begin();
+        auto written = parallel_compact(zip(keys, values), pred, zip(outKeys, outValues)) -
+                       zip(outKeys, outValues).begin();
+        EXPECT_EQ(written, expected);
+        EXPECT_EQ(outKeys, expectedKeys);
+        EXPECT_EQ(outValues, expectedValues);
+    }
+}
+
+TEST(Parallel, bucketize) {
+    using namespace iterators;
+    for (std::size_t numBuckets : {3, 1024}) {
+        constexpr std::size_t Size = 100003;
+        std::vector<std::uint32_t> keys(Size);
+        std::vector<double> values(Size);
+        for (std::size_t i = 0; i < Size; ++i) {
+            keys[i] = static_cast<std::uint32_t>(i * 2654435761u);
+            values[i] = static_cast<double>(i);
+        }
+
+        auto radix = [numBuckets](std::uint32_t key) { return key % numBuckets; };
+        std::vector<std::uint32_t> expectedKeys(Size);
+        std::vector<double> expectedValues(Size);
+        auto expected = bucketize(zip(keys, values), numBuckets, zip(expectedKeys, expectedValues), radix);
+        std::vector<std::uint32_t> outKeys(Size);
+        std::vector<double> outValues(Size);
+        EXPECT_EQ(parallel_bucketize(zip(keys, values), numBuckets, zip(outKeys, outValues), radix), expected);
+        EXPECT_EQ(outKeys, expectedKeys);
+        EXPECT_EQ(outValues, expectedValues);
+    }
+}
+
+TEST(Parallel, top_k) {
+    using namespace iterators;
+    constexpr std::size_t Size = 20011;
+    std::vector<std::uint32_t> keys(Size);
+    std::vector<std::size_t> ids(Size);
+    for (std::size_t i = 0; i < Size; ++i) {
+        keys[i] = static_cast<std::uint32_t>(i * 2654435761u) % 5000;
+        ids[i] = i;
+    }
+
+    auto byKey = [](const auto &lhs, const auto &rhs) { return std::get<0>(lhs) < std::get<0>(rhs); };
+    for (std::size_t k : {std::size_t(0), std::size_t(1), std::size_t(100), std::size_t(1000), Size + 1}) {
+        auto expected = top_k(zip(keys, ids), k, byKey);
+        auto actual = parallel_top_k(zip(keys, ids), k, byKey);
+        ASSERT_EQ(std::distance(actual.begin(), actual.end()), std::distance(expected.begin(), expected.end()));
+        EXPECT_TRUE(std::equal(actual.begin(), actual.end(), expected.begin()));
+    }
+
+    std::vector<std::uint32_t> empty;
+    auto none = parallel_top_k(empty, 3);
+    EXPECT_EQ(none.begin(), none.end());
+}
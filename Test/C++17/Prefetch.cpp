@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <vector>
+#include "Prefetch.hpp"
+
+TEST(Prefetch, zip_column) {
+    using namespace iterators;
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 0);
+    std::vector<int> other(100, 1);
+    int index = 0;
+    for (auto [value, one] : zip(prefetch<8>(values), other)) {
+        EXPECT_EQ(value, index++);
+        value += one;
+    }
+
+    EXPECT_EQ(index, 100);
+    EXPECT_EQ(values.front(), 1);
+    EXPECT_EQ(values.back(), 100);
+    EXPECT_EQ(prefetch(values).size(), 100);
+}
+
+TEST(Prefetch, random_access) {
+    using namespace iterators;
+    std::vector<int> values{1, 2, 3, 4, 5, 6, 7};
+    auto view = prefetch<3>(values);
+    using It = decltype(view.begin());
+    static_assert(std::is_same_v<std::iterator_traits<It>::iterator_category, std::random_access_iterator_tag>);
+    // no lead iterator is stored, the element ahead is computed from the position
+    static_assert(sizeof(It) <= 3 * sizeof(std::vector<int>::iterator));
+    auto begin = view.begin();
+    auto end = view.end();
+    EXPECT_EQ(end - begin, 7);
+    EXPECT_EQ(begin[4], 5);
+    EXPECT_EQ(*(begin + 6), 7);
+    EXPECT_EQ(*(end - 1), 7);
+    EXPECT_TRUE(begin < end);
+    EXPECT_TRUE(end >= begin);
+    begin += 5;
+    EXPECT_EQ(*begin, 6);
+    begin -= 2;
+    EXPECT_EQ(*begin--, 4);
+    EXPECT_EQ(*begin, 3);
+    std::vector<int> reversed(std::make_reverse_iterator(view.end()), std::make_reverse_iterator(view.begin()));
+    EXPECT_EQ(reversed, (std::vector{7, 6, 5, 4, 3, 2, 1}));
+}
+
+TEST(Prefetch, bidirectional) {
+    using namespace iterators;
+    std::list<int> values{1, 2, 3, 4, 5, 6};
+    auto view = prefetch<2>(values);
+    using It = decltype(view.begin());
+    static_assert(std::is_same_v<std::iterator_traits<It>::iterator_category, std::bidirectional_iterator_tag>);
+    static_assert(!impl::traits::is_random_accessible_v<It>);
+    auto it = view.begin();
+    for (int i = 1; i <= 5; ++i, ++it) {
+        EXPECT_EQ(*it, i);
+    }
+
+    for (int i = 6; i > 1; --i, --it) {
+        EXPECT_EQ(*it, i);
+    }
+
+    std::vector<int> collected(view.begin(), view.end());
+    EXPECT_EQ(collected, (std::vector{1, 2, 3, 4, 5, 6}));
+    std::vector<int> reversed(std::make_reverse_iterator(view.end()), std::make_reverse_iterator(view.begin()));
+    EXPECT_EQ(reversed, (std::vector{6, 5, 4, 3, 2, 1}));
+}
+
+TEST(Prefetch, short_and_empty) {
+    using namespace iterators;
+    std::vector<int> empty;
+    auto emptyView = prefetch<16>(empty);
+    EXPECT_EQ(emptyView.begin(), emptyView.end());
+    std::list<int> emptyList;
+    auto emptyListView = prefetch<16>(emptyList);
+    EXPECT_EQ(emptyListView.begin(), emptyListView.end());
+    std::list<int> shortList{1, 2};
+    std::vector<int> collected;
+    for (auto value : prefetch<16>(shortList)) {
+        collected.emplace_back(value);
+    }
+
+    EXPECT_EQ(collected, (std::vector{1, 2}));
+    std::vector<bool> flags{true, false, true};
+    std::vector<bool> collectedFlags(prefetch<1>(flags).begin(), prefetch<1>(flags).end());
+    EXPECT_EQ(collectedFlags, flags);
+}
+
+TEST(Prefetch, pointee) {
+    using namespace iterators;
+    std::vector<std::unique_ptr<int>> owners;
+    std::vector<int *> pointers;
+    for (int i = 0; i < 50; ++i) {
+        owners.emplace_back(i % 7 == 0 ? nullptr : std::make_unique<int>(i));
+        pointers.emplace_back(owners.back().get());
+    }
+
+    int sum = 0;
+    for (auto [owner, pointer] : zip(prefetch_pointee<4>(owners), prefetch_pointee<4>(pointers))) {
+        EXPECT_EQ(owner.get(), pointer);
+        if (pointer != nullptr) {
+            sum += *pointer;
+        }
+    }
+
+    int expected = 0;
+    for (int i = 0; i < 50; ++i) {
+        expected += i % 7 == 0 ? 0 : i;
+    }
+
+    EXPECT_EQ(sum, expected);
+}
+
+TEST(Prefetch, gather) {
+    using namespace iterators;
+    std::vector<double> table{0.5, 1.5, 2.5, 3.5};
+    std::vector<std::size_t> indices{3, 0, 2, 2, 1};
+    double sum = 0;
+    for (auto [i, index] : enumerate(prefetch_gather<2>(indices, table))) {
+        EXPECT_EQ(index, indices[i]);
+        sum += table[index];
+    }
+
+    EXPECT_DOUBLE_EQ(sum, 10.5);
+    const std::vector<int> constTable{1, 2, 3};
+    std::vector<int> result;
+    for (auto index : prefetch_gather<1>(std::vector{2, 1, 0}, constTable)) {
+        result.emplace_back(constTable[index]);
+    }
+
+    EXPECT_EQ(result, (std::vector{3, 2, 1}));
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ReadAhead.hpp"
+
+TEST(ReadAhead, stream) {
+    using namespace iterators;
+    std::stringstream stream;
+    for (int i = 0; i < 100; ++i) {
+        stream << i * 2 << " ";
+    }
+
+    std::size_t count = 0;
+    for (auto [index, value] : enumerate(prefetched<int>(stream, 7))) {
+        EXPECT_EQ(value, static_cast<int>(index) * 2);
+        ++count;
+    }
+
+    EXPECT_EQ(count, 100);
+}
+
+TEST(ReadAhead, range) {
+    using namespace iterators;
+    std::vector<std::string> source{"a", "b", "c", "d", "e"};
+    std::vector<std::string> result;
+    for (auto [s, n] : zip(prefetched(source, 2), std::vector{1, 2, 3, 4, 5, 6})) {
+        result.emplace_back(s + std::to_string(n));
+    }
+
+    EXPECT_EQ(result, (std::vector<std::string>{"a1", "b2", "c3", "d4", "e5"}));
+    auto moved = prefetched(std::vector{1, 2, 3});
+    std::vector<int> values(moved.begin(), moved.end());
+    EXPECT_EQ(values, (std::vector{1, 2, 3}));
+}
+
+TEST(ReadAhead, file_descriptor) {
+    using namespace iterators;
+    auto path = testing::TempDir() + "read_ahead_records.bin";
+    std::vector<long> records(23);
+    for (auto [index, record] : enumerate(records)) {
+        record = static_cast<long>(index * index);
+    }
+
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(records.data()),
+                                                static_cast<std::streamsize>(records.size() * sizeof(long)));
+    int fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    {
+        std::vector<long> result;
+        for (auto [index, record] : zip_enumerate(prefetched<long>(fd, 5))) {
+            EXPECT_EQ(record, records[index]);
+            result.emplace_back(record);
+        }
+
+        EXPECT_EQ(result, records);
+    }
+
+    ::close(fd);
+}
+
+TEST(ReadAhead, incomplete_record) {
+    using namespace iterators;
+    auto path = testing::TempDir() + "read_ahead_incomplete.bin";
+    std::ofstream(path, std::ios::binary) << "abcdefghijk";
+    int fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    {
+        // the complete records are read before the incomplete one is reported
+        std::string result;
+        auto range = prefetched<std::array<char, 4>>(fd, 4);
+        auto it = range.begin();
+        result.append((*it).data(), 4);
+        ++it;
+        result.append((*it).data(), 4);
+        EXPECT_THROW(++it, std::runtime_error);
+        EXPECT_EQ(result, "abcdefgh");
+    }
+
+    ::close(fd);
+    std::ofstream(path, std::ios::binary) << "ab";
+    fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    {
+        auto range = prefetched<int>(fd);
+        EXPECT_THROW(range.begin(), std::runtime_error);
+    }
+
+    ::close(fd);
+}
+
+TEST(ReadAhead, producer_exception) {
+    using namespace iterators;
+    int calls = 0;
+    impl::ReadAheadRange<int> range([&calls](std::vector<int> &buffer, std::size_t capacity) {
+        if (++calls > 2) {
+            throw std::logic_error("failure");
+        }
+
+        buffer.assign(capacity, calls);
+    }, 3);
+    auto it = range.begin();
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(*it++, i < 3 ? 1 : 2);
+    }
+
+    EXPECT_THROW(++it, std::logic_error);
+    EXPECT_EQ(it, range.end());
+}
+
+TEST(ReadAhead, empty_and_early_exit) {
+    using namespace iterators;
+    auto empty = prefetched(std::vector<int>{});
+    EXPECT_EQ(empty.begin(), empty.end());
+    std::vector<int> large(100000, 1);
+    auto range = prefetched(large, 16);
+    auto it = range.begin();
+    EXPECT_EQ(*it, 1);
+    EXPECT_NE(it, range.end());
+    // range is destroyed while the background thread waits for a free buffer
+}
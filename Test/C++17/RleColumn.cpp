@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "RleColumn.hpp"
+
+namespace {
+    std::vector<int> sortedDimension(std::size_t size) {
+        std::vector<int> values(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            values[i] = static_cast<int>(i / 37) * 3 - 20;
+        }
+
+        return values;
+    }
+}
+
+TEST(RleColumn, encode_decode) {
+    using namespace iterators;
+    auto values = sortedDimension(1000);
+    auto column = rle_column(values);
+    ASSERT_EQ(column.size(), values.size());
+    EXPECT_EQ(column.runCount(), (values.size() + 36) / 37);
+    EXPECT_TRUE(std::equal(column.begin(), column.end(), values.begin(), values.end()));
+    for (std::size_t i = 0; i < values.size(); i += 7) {
+        EXPECT_EQ(column[i], values[i]);
+    }
+
+    auto it = column.begin();
+    it += 500;
+    EXPECT_EQ(*it, values[500]);
+    EXPECT_EQ(it.runRemaining(), 37 - 500 % 37);
+    it -= 480;
+    EXPECT_EQ(*it, values[20]);
+    EXPECT_EQ(it[979], values[999]);
+    auto last = column.end();
+    --last;
+    EXPECT_EQ(*last, values.back());
+    EXPECT_EQ(column.end() - column.begin(), 1000);
+    std::vector<int> reversed(column.size());
+    std::reverse_copy(column.begin(), column.end(), reversed.begin());
+    EXPECT_TRUE(std::equal(reversed.rbegin(), reversed.rend(), values.begin()));
+}
+
+TEST(RleColumn, push_back_runs) {
+    using namespace iterators;
+    impl::RleColumn<std::string> column;
+    EXPECT_TRUE(column.empty());
+    column.push_back("a", 3);
+    column.push_back("a");
+    column.push_back("b", 0);
+    column.push_back("b", 2);
+    column.push_back("a");
+    EXPECT_EQ(column.size(), 7);
+    EXPECT_EQ(column.runCount(), 3);
+    EXPECT_EQ(column.runEnds(), (std::vector<std::size_t>{4, 6, 7}));
+    EXPECT_EQ(column[3], "a");
+    EXPECT_EQ(column[4], "b");
+    EXPECT_EQ(column[6], "a");
+    EXPECT_EQ(std::count(column.begin(), column.end(), "a"), 5);
+}
+
+TEST(RleColumn, reduce_by_runs) {
+    using namespace iterators;
+    auto values = sortedDimension(10007);
+    auto column = rle_column<std::int64_t>(values);
+    std::int64_t expected = 0;
+    for (auto value : values) {
+        expected += value;
+    }
+
+    EXPECT_EQ(reduce(column, std::int64_t(0)), expected);
+    std::vector<std::int64_t> dense(values.size());
+    for (std::size_t i = 0; i < dense.size(); ++i) {
+        dense[i] = static_cast<std::int64_t>(i % 11) - 5;
+    }
+
+    std::int64_t expectedDot = 0;
+    for (std::size_t i = 0; i < dense.size(); ++i) {
+        expectedDot += values[i] * dense[i];
+    }
+
+    EXPECT_EQ(transform_reduce(zip(column, dense), std::int64_t(0), std::plus<>{}, product{}), expectedDot);
+    EXPECT_EQ(transform_reduce(zip(dense, column), std::int64_t(0), std::plus<>{}, product{}), expectedDot);
+    std::vector<double> prices(values.size(), 0.5);
+    auto doubles = rle_column<double>(values);
+    EXPECT_DOUBLE_EQ(transform_reduce(zip(doubles, prices), 0.0, std::plus<>{}, product{}),
+                     static_cast<double>(expected) * 0.5);
+    EXPECT_EQ(reduce(impl::RleColumn<int>(), 3), 3);
+}
+
+TEST(RleColumn, reduce_mixed_types) {
+    using namespace iterators;
+    std::vector<double> halves{0.5, 0.5};
+    std::vector<int> dense{2, 2};
+    EXPECT_EQ(transform_reduce(zip(rle_column(std::vector<int>{2, 2}), halves), 0, std::plus<>{}, product{}),
+              transform_reduce(zip(dense, halves), 0, std::plus<>{}, product{}));
+    EXPECT_EQ(transform_reduce(zip(halves, rle_column(std::vector<int>{2, 2})), 0, std::plus<>{}, product{}), 2);
+    EXPECT_EQ(reduce(rle_column(std::vector<double>{2.5, 2.5, 2.5}), 0), reduce(std::vector<double>{2.5, 2.5, 2.5}, 0));
+    EXPECT_DOUBLE_EQ(reduce(rle_column(std::vector<int>{1, 1, 3}), 0.5), 5.5);
+}
+
+TEST(RleColumn, for_each_run) {
+    using namespace iterators;
+    auto values = sortedDimension(500);
+    auto column = rle_column(values);
+    std::vector<int> dense(values.size(), 2);
+    std::size_t calls = 0;
+    for_each_run(zip(column, dense), [&calls](int value, auto first, auto last) {
+        ++calls;
+        for (; first != last; ++first) {
+            std::get<1>(*first) *= value;
+        }
+    });
+
+    EXPECT_EQ(calls, column.runCount());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(dense[i], 2 * values[i]);
+    }
+
+    std::vector<std::size_t> lengths;
+    for_each_run(column, [&lengths](int, auto first, auto last) {
+        lengths.push_back(static_cast<std::size_t>(last - first));
+    });
+
+    EXPECT_EQ(lengths.size(), column.runCount());
+    EXPECT_EQ(lengths.front(), 37);
+    EXPECT_EQ(lengths.back(), 500 % 37);
+    std::size_t row = 0;
+    for (auto [value, d] : zip(column, dense)) {
+        EXPECT_EQ(value, values[row]);
+        EXPECT_EQ(d, 2 * values[row]);
+        ++row;
+    }
+}
+
+TEST(RleColumn, bool_flags) {
+    using namespace iterators;
+    std::vector<bool> flags(300);
+    for (std::size_t i = 0; i < flags.size(); ++i) {
+        flags[i] = (i / 50) % 2 == 1;
+    }
+
+    auto column = rle_column(flags);
+    EXPECT_TRUE((std::is_same_v<decltype(*column.begin()), bool>));
+    EXPECT_EQ(column.runCount(), 6);
+    EXPECT_TRUE(std::equal(column.begin(), column.end(), flags.begin(), flags.end()));
+    EXPECT_FALSE(column[49]);
+    EXPECT_TRUE(column[50]);
+    std::vector<int> dense(flags.size(), 1);
+    EXPECT_EQ(transform_reduce(zip(column, dense), 0, std::plus<>{}, product{}), 150);
+    std::size_t setRows = 0;
+    for_each_run(zip(column, dense), [&setRows](bool flag, auto first, auto last) {
+        if (flag) {
+            setRows += static_cast<std::size_t>(last - first);
+        }
+    });
+
+    EXPECT_EQ(setRows, 150);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "Rolling.hpp"
+
+namespace {
+    template<typename T, typename Aggregate>
+    auto naive_rolling(const std::vector<T> &values, std::size_t window, Aggregate aggregate) {
+        std::vector<decltype(aggregate(values.begin(), values.end()))> result;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            auto first = values.begin() + static_cast<std::ptrdiff_t>(i + 1 - std::min(i + 1, window));
+            result.emplace_back(aggregate(first, values.begin() + static_cast<std::ptrdiff_t>(i + 1)));
+        }
+
+        return result;
+    }
+
+    template<typename View>
+    auto collect(const View &view) {
+        std::vector<std::decay_t<decltype(*view.begin())>> result;
+        for (auto value : view) {
+            result.emplace_back(value);
+        }
+
+        return result;
+    }
+}
+
+TEST(Rolling, against_naive) {
+    using namespace iterators;
+    std::mt19937 gen(3);
+    std::vector<int> values(500);
+    for (auto &value : values) {
+        value = static_cast<int>(gen() % 200) - 100;
+    }
+
+    for (std::size_t window : {1, 2, 7, 64, 499, 500, 1000}) {
+        auto sum = [](auto first, auto last) { return std::accumulate(first, last, 0ll); };
+        auto mean = [](auto first, auto last) {
+            return static_cast<double>(std::accumulate(first, last, 0)) / static_cast<double>(last - first);
+        };
+        auto min = [](auto first, auto last) { return *std::min_element(first, last); };
+        auto max = [](auto first, auto last) { return *std::max_element(first, last); };
+        EXPECT_EQ(collect(rolling_sum(values, window)), naive_rolling(values, window, sum));
+        EXPECT_EQ(collect(rolling_mean(values, window)), naive_rolling(values, window, mean));
+        EXPECT_EQ(collect(rolling_min(values, window)), naive_rolling(values, window, min));
+        EXPECT_EQ(collect(rolling_max(values, window)), naive_rolling(values, window, max));
+    }
+}
+
+TEST(Rolling, zip_and_enumerate) {
+    using namespace iterators;
+    std::vector<long> timestamps{10, 20, 30, 40, 50};
+    std::vector<double> values{1.0, 3.0, 2.0, 5.0, 4.0};
+    std::vector<double> means{1.0, 2.0, 2.5, 3.5, 4.5};
+    std::vector<double> maxima{1.0, 3.0, 3.0, 5.0, 5.0};
+    std::size_t count = 0;
+    for (auto [i, row] : enumerate(zip(timestamps, values, rolling_mean(values, 2), rolling_max(values, 2)))) {
+        auto [time, value, mean, max] = row;
+        EXPECT_EQ(time, timestamps[i]);
+        EXPECT_EQ(value, values[i]);
+        EXPECT_DOUBLE_EQ(mean, means[i]);
+        EXPECT_EQ(max, maxima[i]);
+        ++count;
+    }
+
+    EXPECT_EQ(count, values.size());
+    EXPECT_EQ(rolling_sum(values, 3).size(), values.size());
+}
+
+TEST(Rolling, forward_ranges_and_errors) {
+    using namespace iterators;
+    std::list<int> list{4, 1, 3, 1, 5, 9, 2, 6};
+    EXPECT_EQ(collect(rolling_min(list, 3)), (std::vector<int>{4, 1, 1, 1, 1, 1, 2, 2}));
+    EXPECT_EQ(collect(rolling_sum(std::vector<int>{1, 2, 3, 4}, 2)), (std::vector<long long>{1, 3, 5, 7}));
+    std::vector<int> empty;
+    auto view = rolling_max(empty, 3);
+    EXPECT_EQ(view.begin(), view.end());
+    EXPECT_THROW(rolling_sum(empty, 0), std::invalid_argument);
+}
+
+TEST(Rolling, narrow_integers) {
+    using namespace iterators;
+    std::vector<std::uint8_t> bytes(4, 200);
+    EXPECT_EQ(collect(rolling_sum(bytes, 2)), (std::vector<unsigned long long>{200, 400, 400, 400}));
+    EXPECT_EQ(collect(rolling_mean(bytes, 2)), (std::vector<double>{200, 200, 200, 200}));
+    std::vector<std::int16_t> shorts{30000, 30000, -30000, -30000, -30000};
+    EXPECT_EQ(collect(rolling_sum(shorts, 3)), (std::vector<long long>{30000, 60000, 30000, -30000, -90000}));
+    EXPECT_EQ(collect(rolling_mean(shorts, 2)), (std::vector<double>{30000, 30000, 0, -30000, -30000}));
+}
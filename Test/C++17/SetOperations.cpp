@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "SetOperations.hpp"
+
+namespace {
+    template<typename T>
+    std::vector<T> sorted_random(std::size_t size, T max, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<T> dist(0, max);
+        std::vector<T> result(size);
+        std::generate(result.begin(), result.end(), [&] { return dist(gen); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    template<typename View>
+    auto collect(const View &view) {
+        std::vector<std::remove_cv_t<std::remove_reference_t<decltype(*view.begin())>>> result;
+        for (auto &&elem : view) {
+            result.emplace_back(elem);
+        }
+
+        return result;
+    }
+
+    template<typename T>
+    void check_against_std(const std::vector<T> &a, const std::vector<T> &b) {
+        using namespace iterators;
+        std::vector<T> expected;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        std::vector<T> actual;
+        for (auto [l, r] : set_intersection_view(a, b)) {
+            EXPECT_EQ(l, r);
+            actual.emplace_back(l);
+        }
+
+        EXPECT_EQ(actual, expected);
+        expected.clear();
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        EXPECT_EQ(collect(set_union_view(a, b)), expected);
+        expected.clear();
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        EXPECT_EQ(collect(set_difference_view(a, b)), expected);
+    }
+}
+
+TEST(SetOperations, against_std) {
+    check_against_std(std::vector<int>{1, 2, 2, 2, 4, 5, 7, 7, 9}, std::vector<int>{0, 2, 2, 3, 5, 7, 8, 9, 10});
+    check_against_std(std::vector<int>{}, std::vector<int>{1, 2, 3});
+    check_against_std(std::vector<int>{1, 2, 3}, std::vector<int>{});
+    check_against_std(std::vector<int>{-5, -3, -1}, std::vector<int>{-4, -3, 0});
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        check_against_std(sorted_random<int>(2000, 3000, seed), sorted_random<int>(300, 3000, seed + 10));
+        check_against_std(sorted_random<std::uint32_t>(500, 400, seed), sorted_random<std::uint32_t>(700, 400, seed));
+        check_against_std(sorted_random<std::uint32_t>(1000, 0xFFFFFFFFu, seed),
+                          sorted_random<std::uint32_t>(1000, 0xFFFFFFFFu, seed + 1));
+        check_against_std(sorted_random<long>(1000, 100, seed), sorted_random<long>(50, 100, seed + 3));
+    }
+}
+
+TEST(SetOperations, skewed) {
+    using namespace iterators;
+    std::vector<std::uint32_t> large(100000);
+    std::iota(large.begin(), large.end(), 0x7FFFFFF0u);
+    std::vector<std::uint32_t> small{0x7FFFFFF0u, 0x80000000u, 0x80000005u, 0x80001000u, 0x90000000u};
+    std::vector<std::uint32_t> expected{0x7FFFFFF0u, 0x80000000u, 0x80000005u, 0x80001000u};
+    std::vector<std::uint32_t> actual;
+    for (auto [l, r] : set_intersection_view(small, large)) {
+        EXPECT_EQ(l, r);
+        actual.emplace_back(l);
+    }
+
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(collect(set_difference_view(small, large)), std::vector<std::uint32_t>{0x90000000u});
+    EXPECT_EQ(collect(set_difference_view(large, small)).size(), large.size() - expected.size());
+}
+
+TEST(SetOperations, zipped_keys) {
+    using namespace iterators;
+    std::vector<int> leftKeys{1, 3, 3, 5, 8};
+    std::vector<std::string> leftNames{"a", "b", "c", "d", "e"};
+    std::vector<long> rightKeys{3, 4, 5, 5, 9};
+    std::vector<double> rightValues{0.5, 1.5, 2.5, 3.5, 4.5};
+    std::vector<std::string> names;
+    std::vector<double> values;
+    for (auto [left, right] : set_intersection_view(zip(leftKeys, leftNames), zip(rightKeys, rightValues),
+                                                    element<0>{}, element<0>{})) {
+        EXPECT_EQ(std::get<0>(left), std::get<0>(right));
+        names.emplace_back(std::get<1>(left));
+        values.emplace_back(std::get<1>(right));
+    }
+
+    EXPECT_EQ(names, (std::vector<std::string>{"b", "d"}));
+    EXPECT_EQ(values, (std::vector<double>{0.5, 2.5}));
+    names.clear();
+    for (auto [key, name] : set_difference_view(zip(leftKeys, leftNames), rightKeys, element<0>{})) {
+        names.emplace_back(name);
+        name += "!";
+    }
+
+    EXPECT_EQ(names, (std::vector<std::string>{"a", "c", "e"}));
+    EXPECT_EQ(leftNames, (std::vector<std::string>{"a!", "b", "c!", "d", "e!"}));
+}
+
+TEST(SetOperations, union_references_and_lists) {
+    using namespace iterators;
+    std::vector<int> a{1, 4, 6};
+    std::vector<int> b{2, 4, 7};
+    for (auto &elem : set_union_view(a, b)) {
+        elem *= 10;
+    }
+
+    EXPECT_EQ(a, (std::vector<int>{10, 40, 60}));
+    EXPECT_EQ(b, (std::vector<int>{20, 4, 70}));
+    std::list<long> c{9, 7, 5, 3};
+    std::vector<long> d{8, 7, 3, 1};
+    EXPECT_EQ(collect(set_union_view(c, d, impl::Identity{}, impl::Identity{}, std::greater<>{})),
+              (std::vector<long>{9, 8, 7, 5, 3, 1}));
+    EXPECT_EQ(collect(set_difference_view(c, d, impl::Identity{}, impl::Identity{}, std::greater<>{})),
+              (std::vector<long>{9, 5}));
+    std::vector<long> mixed{2, 3};
+    EXPECT_EQ(collect(set_union_view(a, mixed)), (std::vector<long>{2, 3, 10, 40, 60}));
+}
+
+TEST(SetOperations, temporaries_and_empty) {
+    using namespace iterators;
+    auto view = set_intersection_view(std::vector<int>{1, 2, 3}, std::vector<int>{2, 3, 4});
+    auto copy = view;
+    EXPECT_EQ(std::distance(copy.begin(), copy.end()), 2);
+    std::vector<int> empty;
+    auto unionView = set_union_view(empty, empty);
+    EXPECT_EQ(unionView.begin(), unionView.end());
+    auto intersection = set_intersection_view(std::vector<int>{1, 2}, empty);
+    EXPECT_EQ(intersection.begin(), intersection.end());
+    auto difference = set_difference_view(empty, std::vector<int>{1});
+    EXPECT_EQ(difference.begin(), difference.end());
+}
+
+TEST(SetOperations, mixed_key_types) {
+    using namespace iterators;
+    std::vector<std::int32_t> ints{1, 2, 3, 4, 5, 6, 7, 8};
+    auto fractional = set_intersection_view(ints, std::vector<double>{2.5});
+    EXPECT_EQ(fractional.begin(), fractional.end());
+    EXPECT_EQ(collect(set_difference_view(ints, std::vector<double>{2.5, 4.0})),
+              (std::vector<std::int32_t>{1, 2, 3, 5, 6, 7, 8}));
+    std::vector<std::int64_t> large{4294967297};
+    auto intersection = set_intersection_view(ints, large);
+    EXPECT_EQ(intersection.begin(), intersection.end());
+    EXPECT_EQ(collect(set_difference_view(ints, large)), ints);
+    std::vector<std::int64_t> matching{3, 8, 4294967297};
+    std::vector<std::int32_t> actual;
+    for (auto [l, r] : set_intersection_view(ints, matching)) {
+        EXPECT_EQ(l, r);
+        actual.emplace_back(l);
+    }
+
+    EXPECT_EQ(actual, (std::vector<std::int32_t>{3, 8}));
+}
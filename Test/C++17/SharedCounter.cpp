@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <numeric>
+#include <vector>
+#include "SharedCounter.hpp"
+
+TEST(SharedCounter, single_thread) {
+    using namespace iterators;
+    for (int grain : {1, 3, 10, 100}) {
+        auto shared = shared_counter_range(5, 32, grain);
+        std::vector<int> values;
+        for (auto i : shared) {
+            values.emplace_back(i);
+        }
+
+        std::vector<int> expected(27);
+        std::iota(expected.begin(), expected.end(), 5);
+        EXPECT_EQ(values, expected);
+        EXPECT_EQ(shared.begin(), shared.end());
+    }
+
+    auto empty = shared_counter_range(4u, 4u);
+    EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST(SharedCounter, shared_between_threads) {
+    using namespace iterators;
+    constexpr std::size_t Size = 100000;
+    std::vector<std::atomic<int>> visits(Size);
+    std::vector<double> column(Size, 1.0);
+    auto shared = shared_counter_range(std::size_t(0), Size, std::size_t(64));
+    auto work = [&] {
+        for (auto i : shared) {
+            visits[i].fetch_add(1, std::memory_order_relaxed);
+            column[i] *= 2.0;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back(work);
+    }
+
+    work();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](auto &count) { return count.load() == 1; }));
+    EXPECT_TRUE(std::all_of(column.begin(), column.end(), [](double value) { return value == 2.0; }));
+}
+
+TEST(SharedCounter, iterator) {
+    using namespace iterators;
+    auto shared = shared_counter_range(0l, 10l, 4l);
+    auto it = shared.begin();
+    auto other = shared.begin();
+    EXPECT_EQ(*it, 0);
+    EXPECT_EQ(*other, 4);
+    EXPECT_EQ(*it++, 0);
+    EXPECT_EQ(*it, 1);
+    it++;
+    ++it;
+    ++it;
+    EXPECT_EQ(*it, 8);
+    ++other;
+    EXPECT_NE(it, other);
+    ++it;
+    ++it;
+    EXPECT_EQ(it, shared.end());
+    static_assert(std::is_same_v<std::iterator_traits<decltype(it)>::iterator_category, std::input_iterator_tag>);
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "ThreadPool.hpp"
+
+TEST(ThreadPool, runs_all_tasks) {
+    using namespace iterators;
+    impl::ThreadPool pool(3);
+    EXPECT_EQ(pool.concurrency(), 4);
+    for (std::size_t numTasks : {0, 1, 2, 7, 1000}) {
+        std::vector<std::atomic<int>> calls(numTasks);
+        pool.run(numTasks, [&calls](std::size_t task) { calls[task].fetch_add(1); });
+        for (auto &count : calls) {
+            EXPECT_EQ(count.load(), 1);
+        }
+    }
+}
+
+TEST(ThreadPool, nested_and_exceptions) {
+    using namespace iterators;
+    impl::ThreadPool pool(2);
+    std::atomic<int> inner{0};
+    pool.run(4, [&](std::size_t) {
+        pool.run(5, [&](std::size_t) { inner.fetch_add(1); });
+    });
+
+    EXPECT_EQ(inner.load(), 20);
+    EXPECT_THROW(pool.run(100, [](std::size_t task) {
+        if (task == 42) {
+            throw std::runtime_error("task failed");
+        }
+    }), std::runtime_error);
+    std::atomic<int> calls{0};
+    pool.run(10, [&calls](std::size_t) { calls.fetch_add(1); });
+    EXPECT_EQ(calls.load(), 10);
+}
@@ -1,9 +1,27 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
 #include <ranges>
 #include <vector>
 #include <string>
 #include <list>
 #include "Iterators.hpp"
+#include "MappedColumn.hpp"
+#include "ReadAhead.hpp"
+#include "Prefetch.hpp"
+#include "Indexed.hpp"
+#include "BitColumn.hpp"
+#include "SharedCounter.hpp"
+#include "Algorithms.hpp"
+#include "Joins.hpp"
+#include "SetOperations.hpp"
+#include "KWayMerge.hpp"
+#include "Rolling.hpp"
+#include "NullableColumn.hpp"
+#include "Arrow.hpp"
+#include "DictColumn.hpp"
+#include "PackedColumn.hpp"
+#include "RleColumn.hpp"
 
 TEST(cpp20_compat, view_concat) {
     using namespace iterators;
@@ -118,4 +136,175 @@ TEST(cpp20_compat, filter) {
     }
 
     EXPECT_EQ(size, 3);
-}
\ No newline at end of file
+}
+
+TEST(cpp20_compat, mapped_column) {
+    using namespace iterators;
+    EXPECT_TRUE(std::ranges::contiguous_range<impl::MappedColumn<const int>>);
+    EXPECT_TRUE(std::ranges::sized_range<impl::MappedColumn<int>>);
+    EXPECT_TRUE(std::ranges::view<impl::MappedColumn<double>>);
+}
+
+TEST(cpp20_compat, read_ahead) {
+    using namespace iterators;
+    EXPECT_TRUE(std::ranges::input_range<impl::ReadAheadRange<int>>);
+    auto evens = enumerate(prefetched(std::vector{1, 2, 3, 4})) |
+            std::views::filter([](auto tuple) { return std::get<1>(tuple) % 2 == 0; }) | std::views::elements<0>;
+    std::vector<std::size_t> indices;
+    std::ranges::copy(evens, std::back_inserter(indices));
+    EXPECT_EQ(indices, (std::vector<std::size_t>{1, 3}));
+}
+
+TEST(cpp20_compat, prefetch) {
+    using namespace iterators;
+    std::vector<int> values{1, 2, 3, 4, 5, 6};
+    std::list<int> list{1, 2, 3};
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(prefetch(values))>);
+    EXPECT_TRUE(std::ranges::bidirectional_range<decltype(prefetch(list))>);
+    auto zipped = zip(prefetch<2>(values), values);
+    auto even = zipped | std::views::filter([](auto t) { return std::get<0>(t) % 2 == 0; });
+    EXPECT_EQ(std::ranges::distance(even), 3);
+}
+
+TEST(cpp20_compat, indexed) {
+    using namespace iterators;
+    std::vector<int> values{1, 2, 3, 4};
+    std::vector<int> indices{3, 1};
+    auto view = indexed(values, indices);
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(view)>);
+    EXPECT_EQ(std::ranges::size(view), 2);
+    EXPECT_EQ(std::ranges::max(view), 4);
+}
+
+TEST(cpp20_compat, bit_span) {
+    using namespace iterators;
+    std::vector<bool> bits{true, false, true, true};
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(bit_span(bits))>);
+    EXPECT_TRUE(std::ranges::view<decltype(bit_span(bits))>);
+    EXPECT_EQ(std::ranges::count(bit_span(bits) | std::views::drop(1), true), 2);
+}
+
+TEST(cpp20_compat, shared_counter) {
+    using namespace iterators;
+    auto shared = shared_counter_range(0, 10, 3);
+    EXPECT_TRUE(std::ranges::input_range<decltype(shared) &>);
+    auto odd = shared | std::views::filter([](int i) { return i % 2 == 1; });
+    EXPECT_EQ(std::ranges::distance(odd), 5);
+}
+
+TEST(cpp20_compat, scan_views) {
+    using namespace iterators;
+    std::vector<int> counts{1, 2, 3, 4};
+    auto offsets = exclusive_scan(counts, 0);
+    EXPECT_TRUE(std::ranges::forward_range<decltype(offsets)>);
+    EXPECT_TRUE(std::ranges::view<decltype(offsets)>);
+    EXPECT_EQ(std::ranges::size(offsets), 4);
+    auto large = inclusive_scan(counts) | std::views::filter([](int sum) { return sum > 3; });
+    EXPECT_EQ(std::ranges::distance(large), 2);
+}
+
+TEST(cpp20_compat, merge_join) {
+    using namespace iterators;
+    std::vector<int> left{1, 2, 2, 3};
+    std::vector<int> right{2, 3, 3};
+    auto join = merge_join(left, right);
+    EXPECT_TRUE(std::ranges::forward_range<decltype(join)>);
+    EXPECT_TRUE(std::ranges::view<decltype(join)>);
+    EXPECT_EQ(std::ranges::distance(join), 4);
+    auto threes = join | std::views::filter([](auto pair) { return std::get<0>(pair) == 3; });
+    EXPECT_EQ(std::ranges::distance(threes), 2);
+}
+
+TEST(cpp20_compat, set_operations) {
+    using namespace iterators;
+    std::vector<int> left{1, 2, 2, 3};
+    std::vector<int> right{2, 3, 4};
+    auto intersection = set_intersection_view(left, right);
+    EXPECT_TRUE(std::ranges::forward_range<decltype(intersection)>);
+    EXPECT_TRUE(std::ranges::view<decltype(intersection)>);
+    EXPECT_EQ(std::ranges::distance(intersection), 2);
+    auto united = set_union_view(left, right);
+    EXPECT_TRUE(std::ranges::equal(united, std::vector{1, 2, 2, 3, 4}));
+    EXPECT_EQ(std::ranges::distance(set_difference_view(left, right) | std::views::take(5)), 2);
+}
+
+TEST(cpp20_compat, kway_merge) {
+    using namespace iterators;
+    std::vector<std::vector<int>> runs{{1, 4}, {2, 3, 5}};
+    auto merged = kway_merge(runs);
+    EXPECT_TRUE(std::ranges::forward_range<decltype(merged)>);
+    EXPECT_TRUE(std::ranges::view<decltype(merged)>);
+    auto values = merged | std::views::transform([](auto pair) { return std::get<1>(pair); });
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{1, 2, 3, 4, 5}));
+}
+
+TEST(cpp20_compat, rolling) {
+    using namespace iterators;
+    std::vector<int> values{3, 1, 4, 1, 5};
+    auto minima = rolling_min(values, 2);
+    EXPECT_TRUE(std::ranges::forward_range<decltype(minima)>);
+    EXPECT_TRUE(std::ranges::view<decltype(minima)>);
+    EXPECT_TRUE(std::ranges::equal(minima, std::vector{3, 1, 1, 1, 1}));
+    EXPECT_TRUE(std::ranges::equal(rolling_sum(values, 3) | std::views::drop(2), std::vector{8, 6, 10}));
+}
+
+TEST(cpp20_compat, nullable_column) {
+    using namespace iterators;
+    auto column = nullable_column<int>(3);
+    column[1] = 4;
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(column)>);
+    EXPECT_EQ(std::ranges::count_if(column, [](auto value) { return value.has_value(); }), 1);
+    auto valid = skip_nulls(column);
+    EXPECT_TRUE(std::ranges::forward_range<decltype(valid)>);
+    EXPECT_EQ(std::ranges::distance(valid), 1);
+}
+
+TEST(cpp20_compat, dict_column) {
+    using namespace iterators;
+    std::vector<std::string> strings{"b", "a", "c", "a"};
+    auto column = dict_column(strings);
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(column)>);
+    EXPECT_EQ(std::ranges::count(column, std::string_view("a")), 2);
+    std::vector ids{0, 1, 2, 3};
+    auto table = zip(column, ids);
+    std::sort(table.begin(), table.end());
+    EXPECT_TRUE(std::ranges::equal(column, std::vector<std::string_view>{"a", "a", "b", "c"}));
+    EXPECT_EQ(ids, (std::vector{1, 3, 0, 2}));
+}
+
+TEST(cpp20_compat, packed_column) {
+    using namespace iterators;
+    std::vector<int> values(300);
+    std::iota(values.begin(), values.end(), -100);
+    auto column = packed_column(values);
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(column)>);
+    EXPECT_TRUE(std::ranges::equal(column, values));
+    EXPECT_TRUE(std::ranges::equal(zip(column, values) | std::views::transform([](auto row) {
+        return std::get<0>(row) - std::get<1>(row);
+    }), std::vector<int>(values.size(), 0)));
+}
+
+TEST(cpp20_compat, rle_column) {
+    using namespace iterators;
+    std::vector values{1, 1, 1, 2, 2, 3};
+    auto column = rle_column(values);
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(column)>);
+    EXPECT_TRUE(std::ranges::equal(column, values));
+    EXPECT_EQ(std::ranges::count(column, 1), 3);
+    std::vector dense{1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(transform_reduce(zip(column, dense), 0, std::plus<>{}, product{}), 6 + 18 + 18);
+}
+
+TEST(cpp20_compat, arrow) {
+    using namespace iterators;
+    std::vector<std::int64_t> ids{1, 2, 3};
+    ArrowArray array{};
+    ArrowSchema schema{};
+    arrow_export(zip(ids), {"id"}, &array, &schema);
+    auto column = arrow_column<std::int64_t>(*array.children[0], *schema.children[0]);
+    EXPECT_TRUE(std::ranges::contiguous_range<decltype(column)>);
+    EXPECT_TRUE(std::ranges::view<decltype(column)>);
+    EXPECT_TRUE(std::ranges::equal(column, ids));
+    array.release(&array);
+    schema.release(&schema);
+}
@@ -0,0 +1,213 @@
+/**
+ * @file ThreadPool.hpp
+ * @author tim Luchterhand
+ * @date 18.10.26
+ * @brief This file contains a minimal fork-join thread pool used by the parallel algorithms. The calling thread
+ * participates in the work, so a pool with N worker threads runs N + 1 tasks concurrently.
+ */
+
+#ifndef ITERATORTOOLS_THREADPOOL_HPP
+#define ITERATORTOOLS_THREADPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iterators {
+    namespace impl {
+
+        /**
+         * Size of a cache line in bytes. Used to pad per-thread data
+         */
+        constexpr inline std::size_t CacheLineSize = 64;
+
+        /**
+         * @brief Fork-join thread pool. run distributes a number of indexed tasks among the worker threads and the
+         * calling thread and returns once all tasks are done.
+         * @details @copybrief
+         * Calls to run from within a task are executed serially on the calling thread. Concurrent calls from
+         * different threads are serialized.
+         */
+        class ThreadPool {
+        public:
+            /**
+             * CTor. Starts the worker threads
+             * @param numWorkers number of worker threads in addition to the calling thread
+             */
+            explicit ThreadPool(std::size_t numWorkers) {
+                workers.reserve(numWorkers);
+                for (std::size_t i = 0; i < numWorkers; ++i) {
+                    workers.emplace_back([this] { work(); });
+                }
+            }
+
+            ThreadPool(const ThreadPool &) = delete;
+            ThreadPool &operator=(const ThreadPool &) = delete;
+
+            ~ThreadPool() {
+                {
+                    std::lock_guard lock(mutex);
+                    stop = true;
+                }
+
+                wakeup.notify_all();
+                for (auto &worker : workers) {
+                    worker.join();
+                }
+            }
+
+            /**
+             * @return number of tasks that can run concurrently (worker threads plus calling thread)
+             */
+            [[nodiscard]] std::size_t concurrency() const noexcept {
+                return workers.size() + 1;
+            }
+
+            /**
+             * Invokes function(i) for every i in [0, numTasks) and waits for all invocations to complete. The order
+             * of invocations and their assignment to threads is unspecified
+             * @tparam Function function type
+             * @param numTasks number of tasks
+             * @param function function to invoke with the task index
+             * @throws the first exception thrown by any task. Tasks that have not started yet are skipped
+             */
+            template<typename Function>
+            void run(std::size_t numTasks, Function &&function) {
+                if (numTasks == 0) {
+                    return;
+                }
+
+                if (workers.empty() || numTasks == 1 || insideTask()) {
+                    for (std::size_t i = 0; i < numTasks; ++i) {
+                        function(i);
+                    }
+
+                    return;
+                }
+
+                std::lock_guard runLock(runMutex);
+                auto invoke = [](void *context, std::size_t index) {
+                    (*static_cast<std::remove_reference_t<Function> *>(context))(index);
+                };
+
+                {
+                    // workers that woke up late for the previous job must be done before it is replaced
+                    std::unique_lock lock(mutex);
+                    finished.wait(lock, [this] { return active == 0; });
+                    job = Job{invoke, std::addressof(function), numTasks};
+                    next.store(0, std::memory_order_relaxed);
+                    pending = numTasks;
+                    cancelled.store(false, std::memory_order_relaxed);
+                    error = nullptr;
+                    ++generation;
+                }
+
+                wakeup.notify_all();
+                execute(job);
+                std::unique_lock lock(mutex);
+                finished.wait(lock, [this] { return pending == 0 && active == 0; });
+                if (error != nullptr) {
+                    std::rethrow_exception(std::exchange(error, nullptr));
+                }
+            }
+
+            /**
+             * @return the global thread pool. It uses one worker thread less than the hardware concurrency
+             */
+            static ThreadPool &instance() {
+                static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+                return pool;
+            }
+
+        private:
+            struct Job {
+                void (*invoke)(void *, std::size_t) = nullptr;
+                void *context = nullptr;
+                std::size_t numTasks = 0;
+            };
+
+            static bool &insideTask() noexcept {
+                static thread_local bool inside = false;
+                return inside;
+            }
+
+            void execute(const Job &current) {
+                insideTask() = true;
+                std::size_t done = 0;
+                for (auto index = next.fetch_add(1); index < current.numTasks; index = next.fetch_add(1)) {
+                    if (not cancelled.load(std::memory_order_relaxed)) {
+                        try {
+                            current.invoke(current.context, index);
+                        } catch (...) {
+                            cancelled.store(true, std::memory_order_relaxed);
+                            std::lock_guard lock(mutex);
+                            if (error == nullptr) {
+                                error = std::current_exception();
+                            }
+                        }
+                    }
+
+                    ++done;
+                }
+
+                insideTask() = false;
+                if (done != 0) {
+                    std::lock_guard lock(mutex);
+                    pending -= done;
+                    if (pending == 0) {
+                        finished.notify_all();
+                    }
+                }
+            }
+
+            void work() {
+                std::uint64_t seen = 0;
+                while (true) {
+                    Job current;
+                    {
+                        std::unique_lock lock(mutex);
+                        wakeup.wait(lock, [this, seen] { return stop || generation != seen; });
+                        if (stop) {
+                            return;
+                        }
+
+                        seen = generation;
+                        current = job;
+                        ++active;
+                    }
+
+                    execute(current);
+                    std::lock_guard lock(mutex);
+                    if (--active == 0) {
+                        finished.notify_all();
+                    }
+                }
+            }
+
+            std::vector<std::thread> workers;
+            std::mutex runMutex;
+            std::mutex mutex;
+            std::condition_variable wakeup;
+            std::condition_variable finished;
+            Job job;
+            std::atomic<std::size_t> next{0};
+            std::atomic<bool> cancelled{false};
+            std::size_t pending = 0;
+            std::size_t active = 0;
+            std::uint64_t generation = 0;
+            std::exception_ptr error;
+            bool stop = false;
+        };
+    }
+}
+
+#endif //ITERATORTOOLS_THREADPOOL_HPP